@@ -0,0 +1,261 @@
+//
+//  ActivityRegistry.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+import Combine
+
+// MARK: - Activity Snapshot
+// Plain value for one activity so views never touch Core Data while rendering
+struct ActivitySnapshot: Identifiable, Equatable {
+    let id: UUID
+    let name: String
+    let metValue: Double
+    let imageName: String?
+    let isCustom: Bool
+    var isFavorite: Bool = false
+    var lastUsed: Date? = nil
+
+    init(_ builtIn: BuiltInActivity) {
+        self.id = builtIn.id
+        self.name = builtIn.name
+        self.metValue = builtIn.metValue
+        self.imageName = builtIn.imageName
+        self.isCustom = false
+    }
+
+    init(custom activity: ActivityModel) {
+        self.id = activity.id ?? UUID()
+        self.name = activity.name ?? ""
+        self.metValue = activity.metValue
+        self.imageName = activity.imageName
+        self.isCustom = true
+        self.isFavorite = activity.isFavorite
+        self.lastUsed = activity.lastUsed
+    }
+}
+
+// MARK: - Activity Registry
+// Built-in catalog merged with the stored rows (custom activities and built-in overlays).
+// Loaded once, then kept in sync through the view context's change notifications.
+final class ActivityRegistry: ObservableObject {
+    static let shared = ActivityRegistry(context: PersistenceController.shared.context, loadsStoredActivities: false)
+
+    typealias StoredActivity = (objectID: NSManagedObjectID, snapshot: ActivitySnapshot)
+
+    @Published private(set) var activitiesByID: [UUID: ActivitySnapshot] = [:]
+    private var idsByName: [String: UUID] = [:]
+    private var storedObjectIDs: [UUID: NSManagedObjectID] = [:]
+    private var activityIDsByObjectID: [NSManagedObjectID: UUID] = [:]
+
+    private let context: NSManagedObjectContext
+    private var changeObserver: AnyCancellable?
+
+    // Without `loadsStoredActivities` only the built-in catalog is there until load(from:) runs;
+    // the shared registry is filled that way during startup instead of fetching on the main thread
+    init(context: NSManagedObjectContext, loadsStoredActivities: Bool = true) {
+        self.context = context
+        if loadsStoredActivities {
+            reload()
+        } else {
+            apply([])
+        }
+        // ObjectsDidChange covers edits and merges; DidSave re-reads inserts once they have permanent IDs
+        changeObserver = NotificationCenter.default
+            .publisher(for: .NSManagedObjectContextObjectsDidChange, object: context)
+            .merge(with: NotificationCenter.default.publisher(for: .NSManagedObjectContextDidSave, object: context))
+            .sink { [weak self] notification in
+                self?.applyChanges(notification)
+            }
+    }
+
+    // MARK: Lookup (O(1), no I/O)
+    func activity(id: UUID) -> ActivitySnapshot? {
+        activitiesByID[id]
+    }
+
+    func activity(named name: String) -> ActivitySnapshot? {
+        idsByName[name].flatMap { activitiesByID[$0] }
+    }
+
+    func metValue(for name: String) -> Double {
+        activity(named: name)?.metValue ?? 1.0
+    }
+
+    var allActivities: [ActivitySnapshot] {
+        activitiesByID.values.sorted { $0.name < $1.name }
+    }
+
+    // MARK: Mutations
+    func setFavorite(_ isFavorite: Bool, forActivityNamed name: String) {
+        guard let activity = storedObject(forActivityNamed: name, createIfNeeded: true) else { return }
+        activity.isFavorite = isFavorite
+        save("Favorite status updated for \(name): \(isFavorite)")
+    }
+
+    func markUsed(_ name: String, at date: Date) {
+        guard let activity = storedObject(forActivityNamed: name, createIfNeeded: true) else { return }
+        activity.lastUsed = date
+        save("Marked \(name) as used")
+    }
+
+    func deleteCustomActivity(named name: String) -> Bool {
+        guard let snapshot = activity(named: name), snapshot.isCustom,
+              let activity = storedObject(forActivityNamed: name, createIfNeeded: false) else { return false }
+        context.delete(activity)
+        return save("Deleted custom activity: \(name)")
+    }
+
+    // Custom rows exist already; built-ins get an overlay row the first time the user changes them
+    private func storedObject(forActivityNamed name: String, createIfNeeded: Bool) -> ActivityModel? {
+        guard let snapshot = activity(named: name) else {
+            AppLog.warning("Activity not found in registry: \(name)", category: .persistence)
+            return nil
+        }
+        if let objectID = storedObjectIDs[snapshot.id] {
+            return context.object(with: objectID) as? ActivityModel
+        }
+        guard createIfNeeded, !snapshot.isCustom else { return nil }
+        let overlay = ActivityModel(context: context)
+        overlay.id = snapshot.id
+        overlay.name = snapshot.name
+        overlay.metValue = snapshot.metValue
+        overlay.imageName = snapshot.imageName
+        overlay.isCustom = false
+        return overlay
+    }
+
+    @discardableResult
+    private func save(_ message: String) -> Bool {
+        do {
+            try context.save()
+            AppLog.info(message, category: .persistence)
+            return true
+        } catch {
+            AppLog.error("Failed to save activity change: \(error.localizedDescription)", category: .persistence)
+            return false
+        }
+    }
+
+    // MARK: Sync
+    func reload() {
+        let catalog = Self.catalogSnapshots
+        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
+        do {
+            apply(try context.loggedFetch(fetchRequest).compactMap { activity in
+                Self.snapshot(for: activity, base: catalog).map { (objectID: activity.objectID, snapshot: $0) }
+            })
+        } catch {
+            AppLog.error("Failed to load activity overlays: \(error.localizedDescription)", category: .persistence)
+            apply([])
+        }
+    }
+
+    // The stored rows are read on the repository's background context; only the merge runs on main
+    @MainActor
+    func load(from repository: DataRepository) async {
+        do {
+            apply(try await repository.storedActivities())
+        } catch {
+            AppLog.error("Failed to load activity overlays: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    private func apply(_ stored: [StoredActivity]) {
+        var byID = Self.catalogSnapshots
+        storedObjectIDs = [:]
+        activityIDsByObjectID = [:]
+        for (objectID, snapshot) in stored {
+            byID[snapshot.id] = snapshot
+            storedObjectIDs[snapshot.id] = objectID
+            activityIDsByObjectID[objectID] = snapshot.id
+        }
+        activitiesByID = byID
+        idsByName = Dictionary(byID.values.map { ($0.name, $0.id) }, uniquingKeysWith: { first, _ in first })
+    }
+
+    static var catalogSnapshots: [UUID: ActivitySnapshot] {
+        Dictionary(uniqueKeysWithValues: BuiltInActivityCatalog.all.map { ($0.id, ActivitySnapshot($0)) })
+    }
+
+    // Overlay rows only contribute favorite/last used; custom rows are full activities
+    static func snapshot(for activity: ActivityModel, base: [UUID: ActivitySnapshot]) -> ActivitySnapshot? {
+        guard let id = activity.id else { return nil }
+        if BuiltInActivityCatalog.isBuiltIn(id) {
+            guard var snapshot = base[id] ?? BuiltInActivityCatalog.byID[id].map(ActivitySnapshot.init) else { return nil }
+            snapshot.isFavorite = activity.isFavorite
+            snapshot.lastUsed = activity.lastUsed
+            return snapshot
+        }
+        return activity.isCustom ? ActivitySnapshot(custom: activity) : nil
+    }
+
+    private func applyChanges(_ notification: Notification) {
+        guard let userInfo = notification.userInfo else { return }
+        if userInfo[NSInvalidatedAllObjectsKey] != nil {
+            reload()
+            return
+        }
+
+        var byID = activitiesByID
+        var changed = false
+
+        for key in [NSInsertedObjectsKey, NSUpdatedObjectsKey, NSRefreshedObjectsKey] {
+            for case let activity as ActivityModel in (userInfo[key] as? Set<NSManagedObject>) ?? [] where !activity.isDeleted {
+                guard let snapshot = Self.snapshot(for: activity, base: byID) else { continue }
+                if let previous = byID[snapshot.id], previous.name != snapshot.name, idsByName[previous.name] == snapshot.id {
+                    idsByName[previous.name] = nil
+                }
+                byID[snapshot.id] = snapshot
+                idsByName[snapshot.name] = snapshot.id
+                storedObjectIDs[snapshot.id] = activity.objectID
+                activityIDsByObjectID[activity.objectID] = snapshot.id
+                changed = true
+            }
+        }
+
+        let removed = ((userInfo[NSDeletedObjectsKey] as? Set<NSManagedObject>) ?? [])
+            .union((userInfo[NSInvalidatedObjectsKey] as? Set<NSManagedObject>) ?? [])
+        for case let activity as ActivityModel in removed {
+            guard let id = activityIDsByObjectID.removeValue(forKey: activity.objectID) else { continue }
+            storedObjectIDs[id] = nil
+            if let builtIn = BuiltInActivityCatalog.byID[id] {
+                // Removing an overlay falls back to the catalog defaults
+                byID[id] = ActivitySnapshot(builtIn)
+            } else if let snapshot = byID.removeValue(forKey: id), idsByName[snapshot.name] == id {
+                idsByName[snapshot.name] = nil
+            }
+            changed = true
+        }
+
+        if changed {
+            activitiesByID = byID
+        }
+    }
+
+    // MARK: - Calorie Burn
+    // kcal = MET × kg × hours × intensity multiplier
+    static func caloriesBurned(metValue: Double, weightKg: Double, durationMinutes: Double, intensityMultiplier: Double) -> Double {
+        max(0, metValue * weightKg * (durationMinutes / 60.0) * intensityMultiplier)
+    }
+
+    // Batch form over parallel arrays; the shortest array bounds the result
+    static func caloriesBurned(metValues: [Double], weightsKg: [Double], durationsMinutes: [Double], intensityMultipliers: [Double]) -> [Double] {
+        let count = min(metValues.count, weightsKg.count, durationsMinutes.count, intensityMultipliers.count)
+        var results = [Double](repeating: 0, count: count)
+        metValues.withUnsafeBufferPointer { met in
+            weightsKg.withUnsafeBufferPointer { weight in
+                durationsMinutes.withUnsafeBufferPointer { duration in
+                    intensityMultipliers.withUnsafeBufferPointer { intensity in
+                        for index in 0..<count {
+                            results[index] = max(0, met[index] * weight[index] * (duration[index] / 60.0) * intensity[index])
+                        }
+                    }
+                }
+            }
+        }
+        return results
+    }
+}
@@ -0,0 +1,127 @@
+//
+//  AppAsset.swift
+//  Calorie counter
+//
+
+import SwiftUI
+import UIKit
+
+// MARK: - Lookup
+// The cases and names come from AssetRegistry.swift; this adds name lookup for values read back from the store
+extension AppAsset {
+    // Image set names written by earlier versions, before the misspelled sets were renamed
+    static let legacyNames: [String: AppAsset] = [
+        "Bikeing": .biking,
+        "Spining": .spinning,
+        "Swiming": .swimming
+    ]
+
+    private static let byName: [String: AppAsset] = Dictionary(uniqueKeysWithValues: allCases.map { ($0.name, $0) })
+        .merging(legacyNames) { current, _ in current }
+
+    init?(named name: String) {
+        guard let asset = Self.byName[name] else { return nil }
+        self = asset
+    }
+
+    // For stored names; an unknown name is logged once and drawn as `fallback`
+    static func resolving(_ name: String?, fallback: AppAsset) -> AppAsset {
+        guard let name = name, !name.isEmpty else { return fallback }
+        if let asset = AppAsset(named: name) {
+            return asset
+        }
+        AssetIconCache.shared.reportMissing(name, fallback: fallback)
+        return fallback
+    }
+
+    var image: Image { Image(name) }
+    var uiImage: UIImage? { UIImage(named: name) }
+}
+
+// MARK: - Asset Icon Cache
+// Most catalog images are 500-1000 px PNGs shown at 50 pt. Drawn through Image(name) each is decoded at
+// full size and stays alive in UIKit's named-image cache. Icons here are downsampled off the main thread
+// the first time a size is asked for, into a purgeable cache, so only icons actually on screen cost memory.
+final class AssetIconCache {
+    static let shared = AssetIconCache()
+
+    private let cache = NSCache<NSString, UIImage>()
+    private let lock = NSLock()
+    private var reportedNames: Set<String> = []
+
+    init() {
+        cache.countLimit = 150 // The activity grid plus the icons around the app
+    }
+
+    func cachedIcon(_ asset: AppAsset, side: CGFloat, scale: CGFloat) -> UIImage? {
+        cache.object(forKey: Self.key(asset, side: side, scale: scale))
+    }
+
+    func icon(_ asset: AppAsset, side: CGFloat, scale: CGFloat) async -> UIImage? {
+        let key = Self.key(asset, side: side, scale: scale)
+        if let cached = cache.object(forKey: key) {
+            return cached
+        }
+        guard let original = asset.uiImage else {
+            AppLog.warning("Image set '\(asset.name)' is missing from the asset catalog", category: .images)
+            return nil
+        }
+        let pixels = side * scale
+        let fit = min(pixels / max(original.size.width * original.scale, 1), pixels / max(original.size.height * original.scale, 1), 1)
+        let target = CGSize(width: (original.size.width * original.scale * fit).rounded(), height: (original.size.height * original.scale * fit).rounded())
+        guard let thumbnail = await original.byPreparingThumbnail(ofSize: target), let cgImage = thumbnail.cgImage else {
+            return original
+        }
+        let icon = UIImage(cgImage: cgImage, scale: scale, orientation: .up).withRenderingMode(original.renderingMode)
+        cache.setObject(icon, forKey: key)
+        return icon
+    }
+
+    func reportMissing(_ name: String, fallback: AppAsset) {
+        lock.lock()
+        let isNew = reportedNames.insert(name).inserted
+        lock.unlock()
+        if isNew {
+            AppLog.warning("Unknown image name '\(name)', drawing \(fallback.name) instead", category: .images)
+        }
+    }
+
+    private static func key(_ asset: AppAsset, side: CGFloat, scale: CGFloat) -> NSString {
+        "\(asset.rawValue)@\(Int(side * scale))" as NSString
+    }
+}
+
+// MARK: - Asset Icon
+// Square, aspect-fit catalog image for grids and rows; draws nothing until its icon is ready
+struct AssetIcon: View {
+    let asset: AppAsset
+    let side: CGFloat
+
+    @Environment(\.displayScale) private var displayScale
+    @State private var loaded: (asset: AppAsset, image: UIImage)?
+
+    private var icon: UIImage? {
+        if let loaded = loaded, loaded.asset == asset {
+            return loaded.image
+        }
+        return AssetIconCache.shared.cachedIcon(asset, side: side, scale: displayScale)
+    }
+
+    var body: some View {
+        Group {
+            if let icon = icon {
+                Image(uiImage: icon)
+                    .resizable()
+                    .scaledToFit()
+            } else {
+                Color.clear
+            }
+        }
+        .frame(width: side, height: side)
+        .task(id: asset) {
+            if let image = await AssetIconCache.shared.icon(asset, side: side, scale: displayScale) {
+                loaded = (asset, image)
+            }
+        }
+    }
+}
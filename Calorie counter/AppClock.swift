@@ -0,0 +1,89 @@
+//
+//  AppClock.swift
+//  Calorie counter
+//
+
+import Foundation
+import Combine
+
+// MARK: - App Clock
+// The one source of "now" and of the calendar used for day arithmetic. Debug time travel pins the
+// current day; entries logged on it keep the wall-clock time of day. Tests and the time-travel engine
+// create their own clock with a fixed calendar and start day.
+final class AppClock: ObservableObject {
+    static let shared = AppClock(defaults: .standard)
+
+    private static let simulatedDayKey = "simulatedCurrentDate"
+
+    let calendar: Calendar
+    private let wallClock: () -> Date
+    private let defaults: UserDefaults?
+    private let lock = NSLock()
+    private var storedSimulatedDay: Date?
+
+    // `defaults` persists the simulated day across launches; pass nil for a throwaway clock
+    init(calendar: Calendar = .current, wallClock: @escaping () -> Date = Date.init, simulatedDay: Date? = nil, defaults: UserDefaults? = nil) {
+        self.calendar = calendar
+        self.wallClock = wallClock
+        self.defaults = defaults
+        let savedDay = simulatedDay ?? (defaults?.object(forKey: Self.simulatedDayKey) as? Date)
+        storedSimulatedDay = savedDay.map { calendar.startOfDay(for: $0) }
+    }
+
+    // MARK: Reading
+    // Safe from any queue. nil when following the wall clock
+    var simulatedDay: Date? {
+        lock.lock()
+        defer { lock.unlock() }
+        return storedSimulatedDay
+    }
+
+    var now: Date {
+        let wallNow = wallClock()
+        guard let day = simulatedDay else { return wallNow }
+        let timeOfDay = wallNow.timeIntervalSince(calendar.startOfDay(for: wallNow))
+        return day.addingTimeInterval(timeOfDay)
+    }
+
+    var today: Date {
+        calendar.startOfDay(for: now)
+    }
+
+    func startOfDay(for date: Date) -> Date {
+        calendar.startOfDay(for: date)
+    }
+
+    func isToday(_ date: Date) -> Bool {
+        calendar.isDate(date, inSameDayAs: today)
+    }
+
+    func day(_ offset: Int, from date: Date) -> Date {
+        calendar.date(byAdding: .day, value: offset, to: calendar.startOfDay(for: date))!
+    }
+
+    // MARK: Time Travel
+    // Observers are views, so change the shared clock on the main thread
+    func advance(days: Int = 1) {
+        setSimulatedDay(day(days, from: today))
+    }
+
+    func travel(to date: Date) {
+        setSimulatedDay(calendar.startOfDay(for: date))
+    }
+
+    func returnToWallClock() {
+        setSimulatedDay(nil)
+    }
+
+    private func setSimulatedDay(_ day: Date?) {
+        objectWillChange.send()
+        lock.lock()
+        storedSimulatedDay = day
+        lock.unlock()
+        if let day = day {
+            defaults?.set(day, forKey: Self.simulatedDayKey)
+        } else {
+            defaults?.removeObject(forKey: Self.simulatedDayKey)
+        }
+    }
+}
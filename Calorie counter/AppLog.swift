@@ -0,0 +1,194 @@
+//
+//  AppLog.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+import SwiftUI
+import os
+
+// MARK: - Log Categories
+enum LogCategory: String, CaseIterable {
+    case startup = "Startup"
+    case persistence = "Persistence"
+    case diary = "Diary"
+    case profile = "Profile"
+    case network = "Network"
+    case images = "Images"
+}
+
+// MARK: - App Log
+// Categorised logging on top of os.Logger. debug() and info() compile to nothing outside DEBUG builds;
+// warnings and errors always reach the unified log. Signpost intervals show up in Instruments' os_signpost track.
+enum AppLog {
+    private static let subsystem = Bundle.main.bundleIdentifier ?? "Calorie-counter"
+    private static let loggers = Dictionary(uniqueKeysWithValues: LogCategory.allCases.map {
+        ($0, Logger(subsystem: subsystem, category: $0.rawValue))
+    })
+    private static let signposters = Dictionary(uniqueKeysWithValues: LogCategory.allCases.map {
+        ($0, OSSignposter(subsystem: subsystem, category: $0.rawValue))
+    })
+
+    // MARK: Levels
+    @inline(__always)
+    static func debug(_ message: @autoclosure () -> String, category: LogCategory) {
+        #if DEBUG
+        let text = message()
+        loggers[category]?.debug("\(text, privacy: .public)")
+        #endif
+    }
+
+    @inline(__always)
+    static func info(_ message: @autoclosure () -> String, category: LogCategory) {
+        #if DEBUG
+        let text = message()
+        loggers[category]?.info("✅ \(text, privacy: .public)")
+        #endif
+    }
+
+    static func warning(_ message: @autoclosure () -> String, category: LogCategory) {
+        let text = message()
+        loggers[category]?.warning("⚠️ \(text, privacy: .public)")
+    }
+
+    static func error(_ message: @autoclosure () -> String, category: LogCategory) {
+        let text = message()
+        loggers[category]?.error("❌ \(text, privacy: .public)")
+    }
+
+    // MARK: Signposts
+    struct Interval {
+        fileprivate let name: StaticString
+        fileprivate let state: OSSignpostIntervalState
+        fileprivate let signposter: OSSignposter
+
+        func end() {
+            signposter.endInterval(name, state)
+        }
+    }
+
+    // For work that finishes in a callback; pair with Interval.end()
+    static func beginInterval(_ name: StaticString, category: LogCategory, counter: PerfCounter? = nil, detail: @autoclosure () -> String = "") -> Interval {
+        let signposter = signposters[category]!
+        if let counter = counter {
+            PerfCounters.shared.add(counter)
+        }
+        let state: OSSignpostIntervalState
+        if signposter.isEnabled {
+            let text = detail()
+            state = signposter.beginInterval(name, id: signposter.makeSignpostID(), "\(text, privacy: .public)")
+        } else {
+            state = signposter.beginInterval(name)
+        }
+        return Interval(name: name, state: state, signposter: signposter)
+    }
+
+    static func interval<T>(_ name: StaticString, category: LogCategory, counter: PerfCounter? = nil, detail: @autoclosure () -> String = "", _ work: () throws -> T) rethrows -> T {
+        let interval = beginInterval(name, category: category, counter: counter, detail: detail())
+        defer { interval.end() }
+        return try work()
+    }
+
+    static func interval<T>(_ name: StaticString, category: LogCategory, counter: PerfCounter? = nil, detail: @autoclosure () -> String = "", _ work: () async throws -> T) async rethrows -> T {
+        let interval = beginInterval(name, category: category, counter: counter, detail: detail())
+        defer { interval.end() }
+        return try await work()
+    }
+}
+
+// MARK: - Perf Counters
+enum PerfCounter: String, CaseIterable {
+    case fetches = "Fetches"
+    case saves = "Saves"
+    case networkRequests = "Network requests"
+    case bytesDecoded = "Bytes decoded"
+}
+
+// Per-screen tallies for profiling sessions. Saves are counted from DidSave on every context;
+// fetches, requests and decodes are counted by the AppLog intervals that wrap them. No-ops outside DEBUG.
+final class PerfCounters {
+    static let shared = PerfCounters()
+
+    private let lock = NSLock()
+    private var counts: [String: [PerfCounter: Int]] = [:]
+    private var currentScreen = "App"
+    private var saveObserver: NSObjectProtocol?
+
+    private init() {
+        #if DEBUG
+        saveObserver = NotificationCenter.default.addObserver(forName: .NSManagedObjectContextDidSave, object: nil, queue: nil) { [weak self] _ in
+            self?.add(.saves)
+        }
+        #endif
+    }
+
+    func add(_ counter: PerfCounter, _ amount: Int = 1) {
+        #if DEBUG
+        lock.lock()
+        counts[currentScreen, default: [:]][counter, default: 0] += amount
+        lock.unlock()
+        #endif
+    }
+
+    func enterScreen(_ name: String) {
+        #if DEBUG
+        lock.lock()
+        currentScreen = name
+        lock.unlock()
+        #endif
+    }
+
+    func snapshot() -> [String: [PerfCounter: Int]] {
+        lock.lock()
+        defer { lock.unlock() }
+        return counts
+    }
+
+    func reset() {
+        lock.lock()
+        counts = [:]
+        lock.unlock()
+    }
+
+    func dump() {
+        let counts = snapshot()
+        guard !counts.isEmpty else {
+            AppLog.info("Perf counters: nothing recorded", category: .startup)
+            return
+        }
+        for screen in counts.keys.sorted() {
+            let line = PerfCounter.allCases
+                .map { "\($0.rawValue): \(counts[screen]?[$0] ?? 0)" }
+                .joined(separator: ", ")
+            AppLog.info("Perf counters [\(screen)] \(line)", category: .startup)
+        }
+    }
+}
+
+// MARK: - Instrumented Helpers
+extension NSManagedObjectContext {
+    // fetch(_:) inside a signpost interval, counted towards the current screen
+    func loggedFetch<T>(_ request: NSFetchRequest<T>) throws -> [T] {
+        try AppLog.interval("Fetch", category: .persistence, counter: .fetches, detail: request.entityName ?? "") {
+            try fetch(request)
+        }
+    }
+}
+
+extension UIImage {
+    // UIImage(data:) inside a signpost interval; the byte count is charged to the current screen
+    static func decoded(from data: Data) -> UIImage? {
+        AppLog.interval("Image decode", category: .images, detail: "\(data.count) bytes") {
+            PerfCounters.shared.add(.bytesDecoded, data.count)
+            return UIImage(data: data)
+        }
+    }
+}
+
+extension View {
+    // Attributes perf counters to this screen while it is on top
+    func profilingScreen(_ name: String) -> some View {
+        onAppear { PerfCounters.shared.enterScreen(name) }
+    }
+}
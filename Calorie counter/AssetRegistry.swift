@@ -0,0 +1,238 @@
+//
+//  AssetRegistry.swift
+//  Calorie counter
+//
+//  Generated by Scripts/generate-asset-registry.sh from GeneratedAssetSymbols.h. Do not edit;
+//  change the image sets in Assets.xcassets and rerun the script.
+//
+
+import Foundation
+
+// MARK: - App Asset
+// One case per image set in Assets.xcassets. The raw value indexes `names`, so resolving a case
+// is an array read, and a misspelled case is a compile error instead of a missing image.
+enum AppAsset: Int, CaseIterable {
+    case abs
+    case al0
+    case al1
+    case al2
+    case al3
+    case al4
+    case al5
+    case al6
+    case addCustom
+    case addFood
+    case addWater
+    case addWeight
+    case bmChest
+    case bmDefault
+    case bmHips
+    case bmlArm
+    case bmlThigh
+    case bmr
+    case bmrArm
+    case bmrThigh
+    case bmWaist
+    case barCode
+    case baseball
+    case basketball
+    case biking
+    case boxing
+    case calW
+    case carpentery
+    case child
+    case cleaningwindows
+    case const
+    case customActivity
+    case defaultFood
+    case defaultWorkout
+    case eliptical
+    case emptyManPP
+    case emptyWomanPP
+    case fish
+    case garden
+    case golf
+    case hiking
+    case hockey
+    case horse
+    case iceSkateing
+    case kayak
+    case leftFoot
+    case martialArts
+    case mountainBike
+    case moving
+    case paddle
+    case paint
+    case pickle
+    case pilates
+    case pingPong
+    case rightFoot
+    case rockclimbing
+    case rowing
+    case rucking
+    case running
+    case shop
+    case shuttleCock
+    case skateing
+    case skiing
+    case sliderIcon
+    case sliderIconDark
+    case snowboarding
+    case soccer
+    case spinning
+    case sprinting
+    case stretch
+    case swimming
+    case teach
+    case walking
+    case waterInput
+    case weights
+    case xSkiing
+    case yoga
+    case zumba
+    case age
+    case bike
+    case bolt
+    case calender
+    case calisthenics
+    case cleaning
+    case drop
+    case flame
+    case food
+    case grayscaleIndicator
+    case hungry
+    case jumpRope
+    case logo
+    case manorwoman
+    case mowing
+    case nurse
+    case racquetball
+    case scale
+    case scaleIndicator
+    case scuba
+    case snow
+    case stats
+    case tape
+    case target
+    case tennis
+    case trophy
+    case vgame
+    case volley
+    case water
+    case workout
+}
+
+extension AppAsset {
+    static let names: [String] = [
+        "ABS",
+        "AL-0",
+        "AL-1",
+        "AL-2",
+        "AL-3",
+        "AL-4",
+        "AL-5",
+        "AL-6",
+        "AddCustom",
+        "AddFood",
+        "AddWater",
+        "AddWeight",
+        "BMChest",
+        "BMDefault",
+        "BMHips",
+        "BMLArm",
+        "BMLThigh",
+        "BMR",
+        "BMRArm",
+        "BMRThigh",
+        "BMWaist",
+        "BarCode",
+        "Baseball",
+        "Basketball",
+        "Biking",
+        "Boxing",
+        "CalW",
+        "Carpentery",
+        "Child",
+        "Cleaningwindows",
+        "Const",
+        "CustomActivity",
+        "DefaultFood",
+        "DefaultWorkout",
+        "Eliptical",
+        "Empty man PP",
+        "Empty woman PP",
+        "Fish",
+        "Garden",
+        "Golf",
+        "Hiking",
+        "Hockey",
+        "Horse",
+        "IceSkateing",
+        "Kayak",
+        "LeftFoot",
+        "MartialArts",
+        "MountainBike",
+        "Moving",
+        "Paddle",
+        "Paint",
+        "Pickle",
+        "Pilates",
+        "PingPong",
+        "RightFoot",
+        "Rockclimbing",
+        "Rowing",
+        "Rucking",
+        "Running",
+        "Shop",
+        "ShuttleCock",
+        "Skateing",
+        "Skiing",
+        "SliderIcon",
+        "SliderIconDark",
+        "Snowboarding",
+        "Soccer",
+        "Spinning",
+        "Sprinting",
+        "Stretch",
+        "Swimming",
+        "Teach",
+        "Walking",
+        "WaterInput",
+        "Weights",
+        "XSkiing",
+        "Yoga",
+        "Zumba",
+        "age",
+        "bike",
+        "bolt",
+        "calender",
+        "calisthenics",
+        "cleaning",
+        "drop",
+        "flame",
+        "food",
+        "grayscaleIndicator",
+        "hungry",
+        "jumpRope",
+        "logo",
+        "manorwoman",
+        "mowing",
+        "nurse",
+        "racquetball",
+        "scale",
+        "scaleIndicator",
+        "scuba",
+        "snow",
+        "stats",
+        "tape",
+        "target",
+        "tennis",
+        "trophy",
+        "vgame",
+        "volley",
+        "water",
+        "workout"
+    ]
+
+    var name: String { Self.names[rawValue] }
+}
@@ -0,0 +1,494 @@
+//
+//  BackupRepository.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Backup Snapshot
+// One backup: every file of the source directory as a list of content-addressed chunks. A file's digest is
+// the SHA-256 of its chunk digests in order, so a restored file is checked without hashing it twice.
+struct BackupSnapshot: Codable, Equatable {
+    struct File: Codable, Equatable {
+        let path: String // Relative to the backed-up directory
+        let size: Int
+        let digest: String
+        let chunks: [String]
+    }
+
+    let id: String
+    let createdAt: Date
+    let files: [File]
+
+    var size: Int {
+        files.reduce(0) { $0 + $1.size }
+    }
+}
+
+// What one backup cost: everything is read and hashed, only chunks the repository lacks are written
+struct BackupStats: Equatable {
+    var files = 0
+    var chunks = 0
+    var newChunks = 0
+    var bytesRead = 0
+    var bytesWritten = 0
+}
+
+enum BackupError: LocalizedError, Equatable {
+    case missingObject(String)
+    case corruptObject(String)
+    case fileMismatch(String)
+    case noSnapshot
+
+    var errorDescription: String? {
+        switch self {
+        case .missingObject(let digest): return "Backup chunk \(digest.prefix(12)) is missing"
+        case .corruptObject(let digest): return "Backup chunk \(digest.prefix(12)) failed verification"
+        case .fileMismatch(let path): return "Restored \(path) doesn't match its backup"
+        case .noSnapshot: return "There is no backup to restore"
+        }
+    }
+}
+
+// MARK: - Backup Repository
+// Incremental, deduplicating backups of a directory into another directory (local, or a mounted remote).
+// Files are cut into 64 KB chunks, which is 16 SQLite pages, so a store where a few pages changed since
+// yesterday shares every other chunk with the previous backup, and an unchanged photo is stored once
+// however many backups reference it. Each chunk is compressed, checked to decode back to its digest before
+// it is written, and stored under that digest:
+//
+//   objects/ab/abcdef…   codec (UInt8), uncompressed length (UInt32), payload
+//   snapshots/<id>.json  BackupSnapshot, written last, so an interrupted backup leaves only unreferenced chunks
+//
+// Restores verify every chunk and file against the snapshot.
+final class BackupRepository {
+    static let chunkSize = 64 * 1024
+
+    private enum Codec: UInt8 {
+        case stored = 0
+        case lz = 1
+    }
+
+    let directory: URL
+    private let objectsDirectory: URL
+    private let snapshotsDirectory: URL
+    private let fileManager = FileManager.default
+
+    init(directory: URL) throws {
+        self.directory = directory
+        objectsDirectory = directory.appendingPathComponent("objects", isDirectory: true)
+        snapshotsDirectory = directory.appendingPathComponent("snapshots", isDirectory: true)
+        try fileManager.createDirectory(at: objectsDirectory, withIntermediateDirectories: true)
+        try fileManager.createDirectory(at: snapshotsDirectory, withIntermediateDirectories: true)
+    }
+
+    // MARK: Backing Up
+    // The source must not change while it is read; back up a copy of a live store
+    func backUp(_ source: URL, at date: Date = Date()) throws -> (snapshot: BackupSnapshot, stats: BackupStats) {
+        var stats = BackupStats()
+        var files: [BackupSnapshot.File] = []
+        for (path, url) in try regularFiles(in: source) {
+            let handle = try FileHandle(forReadingFrom: url)
+            defer { try? handle.close() }
+            var chunks: [String] = []
+            var size = 0
+            while let chunk = try handle.read(upToCount: Self.chunkSize), !chunk.isEmpty {
+                let digest = SHA256.hex(SHA256.digest(chunk))
+                if try store(chunk, digest: digest, stats: &stats) {
+                    stats.newChunks += 1
+                }
+                chunks.append(digest)
+                size += chunk.count
+            }
+            files.append(BackupSnapshot.File(path: path, size: size, digest: Self.fileDigest(chunks), chunks: chunks))
+            stats.files += 1
+            stats.chunks += chunks.count
+            stats.bytesRead += size
+        }
+
+        let snapshot = BackupSnapshot(id: try newSnapshotID(for: date), createdAt: date, files: files)
+        let encoder = JSONEncoder()
+        encoder.dateEncodingStrategy = .iso8601
+        encoder.outputFormatting = [.sortedKeys]
+        let manifest = try encoder.encode(snapshot)
+        try manifest.write(to: snapshotURL(snapshot.id), options: .atomic)
+        stats.bytesWritten += manifest.count
+        return (snapshot, stats)
+    }
+
+    // Oldest first; a manifest that can't be read is skipped rather than hiding the others
+    func snapshots() throws -> [BackupSnapshot] {
+        let decoder = JSONDecoder()
+        decoder.dateDecodingStrategy = .iso8601
+        return try fileManager.contentsOfDirectory(at: snapshotsDirectory, includingPropertiesForKeys: nil)
+            .filter { $0.pathExtension == "json" }
+            .compactMap { try? decoder.decode(BackupSnapshot.self, from: Data(contentsOf: $0)) }
+            .sorted { ($0.createdAt, $0.id) < ($1.createdAt, $1.id) }
+    }
+
+    // MARK: Verifying and Restoring
+    // Every chunk is present and decodes to its digest, and every file's chunk list matches its digest
+    func verify(_ snapshot: BackupSnapshot) throws {
+        var lengths: [String: Int] = [:] // Chunks shared between files are checked once
+        for file in snapshot.files {
+            guard Self.fileDigest(file.chunks) == file.digest else { throw BackupError.fileMismatch(file.path) }
+            var size = 0
+            for digest in file.chunks {
+                let length = try lengths[digest] ?? load(digest).count
+                lengths[digest] = length
+                size += length
+            }
+            guard size == file.size else { throw BackupError.fileMismatch(file.path) }
+        }
+    }
+
+    // Writes the snapshot's files under `destination`, which should be empty
+    func restore(_ snapshot: BackupSnapshot, to destination: URL) throws {
+        for file in snapshot.files {
+            guard Self.fileDigest(file.chunks) == file.digest else { throw BackupError.fileMismatch(file.path) }
+            let url = destination.appendingPathComponent(file.path)
+            try fileManager.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+            guard fileManager.createFile(atPath: url.path, contents: nil) else {
+                throw CocoaError(.fileWriteUnknown, userInfo: [NSFilePathErrorKey: url.path])
+            }
+            let handle = try FileHandle(forWritingTo: url)
+            defer { try? handle.close() }
+            var size = 0
+            for digest in file.chunks {
+                let chunk = try load(digest)
+                try handle.write(contentsOf: chunk)
+                size += chunk.count
+            }
+            guard size == file.size else { throw BackupError.fileMismatch(file.path) }
+        }
+    }
+
+    // Keeps the newest `count` snapshots and deletes the chunks only older ones referenced.
+    // Returns the number of chunks deleted.
+    @discardableResult
+    func prune(keeping count: Int) throws -> Int {
+        let all = try snapshots()
+        let kept = all.suffix(max(count, 1))
+        for snapshot in all.dropLast(kept.count) {
+            try fileManager.removeItem(at: snapshotURL(snapshot.id))
+        }
+        let referenced = Set(kept.flatMap { $0.files.flatMap(\.chunks) })
+        var removed = 0
+        for fanOut in try fileManager.contentsOfDirectory(at: objectsDirectory, includingPropertiesForKeys: nil) {
+            for object in try fileManager.contentsOfDirectory(at: fanOut, includingPropertiesForKeys: nil)
+            where !referenced.contains(object.lastPathComponent) {
+                try fileManager.removeItem(at: object)
+                removed += 1
+            }
+        }
+        return removed
+    }
+
+    // MARK: Objects
+    // false when the repository already has the chunk
+    private func store(_ chunk: Data, digest: String, stats: inout BackupStats) throws -> Bool {
+        let url = objectURL(digest)
+        guard !fileManager.fileExists(atPath: url.path) else { return false }
+
+        let bytes = [UInt8](chunk)
+        let compressed = LZCodec.compress(bytes)
+        let codec: Codec = compressed.count < bytes.count ? .lz : .stored
+        var object = Data(capacity: 5 + min(compressed.count, bytes.count))
+        object.append(codec.rawValue)
+        object.appendLittleEndian(UInt32(bytes.count))
+        object.append(contentsOf: codec == .lz ? compressed : bytes)
+        guard try Self.decode(object, digest: digest) == chunk else { throw BackupError.corruptObject(digest) }
+
+        try fileManager.createDirectory(at: url.deletingLastPathComponent(), withIntermediateDirectories: true)
+        try object.write(to: url, options: .atomic)
+        stats.bytesWritten += object.count
+        return true
+    }
+
+    private func load(_ digest: String) throws -> Data {
+        let url = objectURL(digest)
+        guard fileManager.fileExists(atPath: url.path) else { throw BackupError.missingObject(digest) }
+        return try Self.decode(Data(contentsOf: url), digest: digest)
+    }
+
+    private static func decode(_ object: Data, digest: String) throws -> Data {
+        let bytes = [UInt8](object)
+        guard bytes.count >= 5, let codec = Codec(rawValue: bytes[0]) else { throw BackupError.corruptObject(digest) }
+        let length = bytes[1..<5].reversed().reduce(0) { $0 << 8 | Int($1) }
+        let chunk: Data
+        switch codec {
+        case .stored:
+            chunk = Data(bytes[5...])
+        case .lz:
+            guard let decompressed = LZCodec.decompress(bytes[5...], count: length) else { throw BackupError.corruptObject(digest) }
+            chunk = Data(decompressed)
+        }
+        guard chunk.count == length, SHA256.hex(SHA256.digest(chunk)) == digest else { throw BackupError.corruptObject(digest) }
+        return chunk
+    }
+
+    private static func fileDigest(_ chunks: [String]) -> String {
+        SHA256.hex(SHA256.digest(Data(chunks.joined(separator: "\n").utf8)))
+    }
+
+    // MARK: Paths
+    private func objectURL(_ digest: String) -> URL {
+        objectsDirectory.appendingPathComponent(String(digest.prefix(2)), isDirectory: true).appendingPathComponent(digest)
+    }
+
+    private func snapshotURL(_ id: String) -> URL {
+        snapshotsDirectory.appendingPathComponent("\(id).json")
+    }
+
+    private func newSnapshotID(for date: Date) throws -> String {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.timeZone = TimeZone(identifier: "UTC")
+        formatter.dateFormat = "yyyyMMdd-HHmmss"
+        let base = formatter.string(from: date)
+        var id = base
+        var suffix = 1
+        while fileManager.fileExists(atPath: snapshotURL(id).path) {
+            suffix += 1
+            id = "\(base)-\(suffix)"
+        }
+        return id
+    }
+
+    // Regular files under `root` by relative path, hidden ones included (Core Data keeps external
+    // binaries in a hidden support folder), sorted so snapshots list files in a stable order
+    private func regularFiles(in root: URL) throws -> [(path: String, url: URL)] {
+        let rootPath = root.resolvingSymlinksInPath().path
+        guard let enumerator = fileManager.enumerator(at: root, includingPropertiesForKeys: [.isRegularFileKey]) else { return [] }
+        var files: [(path: String, url: URL)] = []
+        for case let url as URL in enumerator {
+            guard try url.resourceValues(forKeys: [.isRegularFileKey]).isRegularFile == true else { continue }
+            let path = url.resolvingSymlinksInPath().path
+            guard path.hasPrefix(rootPath + "/") else { continue }
+            files.append((path: String(path.dropFirst(rootPath.count + 1)), url: url))
+        }
+        return files.sorted { $0.path < $1.path }
+    }
+}
+
+// MARK: - LZ Codec
+// Byte-oriented LZ77 in the LZ4 block layout: each sequence is a token (literal length, match length - 4),
+// the literals, then a 16-bit little-endian match offset; lengths of 15 or more continue in extra bytes.
+// The last sequence has literals only. Fast enough to run on every new chunk, and good on SQLite pages,
+// which are mostly zeros and repeated keys. JPEG data doesn't shrink and is stored as-is.
+enum LZCodec {
+    private static let minimumMatch = 4
+    private static let maximumOffset = 65_535
+    private static let hashBits = 14
+
+    static func compress(_ input: [UInt8]) -> [UInt8] {
+        var output: [UInt8] = []
+        output.reserveCapacity(input.count / 2 + 16)
+        var table = [Int32](repeating: -1, count: 1 << hashBits)
+        var anchor = 0
+        var index = 0
+        input.withUnsafeBufferPointer { source in
+            while index + minimumMatch <= source.count {
+                let sequence = UInt32(source[index]) | UInt32(source[index + 1]) << 8 | UInt32(source[index + 2]) << 16 | UInt32(source[index + 3]) << 24
+                let slot = Int((sequence &* 2_654_435_761) >> UInt32(32 - hashBits))
+                let candidate = Int(table[slot])
+                table[slot] = Int32(index)
+                guard candidate >= 0, index - candidate <= maximumOffset,
+                      source[candidate] == source[index], source[candidate + 1] == source[index + 1],
+                      source[candidate + 2] == source[index + 2], source[candidate + 3] == source[index + 3] else {
+                    index += 1
+                    continue
+                }
+                var length = minimumMatch
+                while index + length < source.count, source[candidate + length] == source[index + length] {
+                    length += 1
+                }
+                appendSequence(source[anchor..<index], offset: index - candidate, matchLength: length, to: &output)
+                index += length
+                anchor = index
+            }
+            appendSequence(source[anchor..<source.count], offset: 0, matchLength: 0, to: &output)
+        }
+        return output
+    }
+
+    // nil when the input is malformed or doesn't decode to `count` bytes
+    static func decompress(_ input: ArraySlice<UInt8>, count: Int) -> [UInt8]? {
+        var output: [UInt8] = []
+        output.reserveCapacity(count)
+        var index = input.startIndex
+        func length(from base: Int) -> Int? {
+            var total = base
+            guard base == 15 else { return total }
+            while index < input.endIndex {
+                let byte = input[index]
+                index += 1
+                total += Int(byte)
+                if byte != 255 { return total }
+            }
+            return nil
+        }
+
+        while index < input.endIndex {
+            let token = input[index]
+            index += 1
+            guard let literals = length(from: Int(token >> 4)), literals <= input.endIndex - index else { return nil }
+            output.append(contentsOf: input[index..<(index + literals)])
+            index += literals
+            if index == input.endIndex { break }
+
+            guard input.endIndex - index >= 2 else { return nil }
+            let offset = Int(input[index]) | Int(input[index + 1]) << 8
+            index += 2
+            guard offset > 0, offset <= output.count, let extra = length(from: Int(token & 0x0F)) else { return nil }
+            let matchLength = extra + minimumMatch
+            guard output.count + matchLength <= count else { return nil }
+            let start = output.count - offset
+            for position in start..<(start + matchLength) { // May overlap what it appends
+                output.append(output[position])
+            }
+        }
+        return output.count == count ? output : nil
+    }
+
+    private static func appendSequence(_ literals: Slice<UnsafeBufferPointer<UInt8>>, offset: Int, matchLength: Int, to output: inout [UInt8]) {
+        let matchCode = max(matchLength - minimumMatch, 0)
+        output.append(UInt8(min(literals.count, 15)) << 4 | UInt8(min(matchCode, 15)))
+        if literals.count >= 15 {
+            appendLength(literals.count - 15, to: &output)
+        }
+        output.append(contentsOf: literals)
+        guard matchLength > 0 else { return }
+        output.append(UInt8(truncatingIfNeeded: offset))
+        output.append(UInt8(truncatingIfNeeded: offset >> 8))
+        if matchCode >= 15 {
+            appendLength(matchCode - 15, to: &output)
+        }
+    }
+
+    private static func appendLength(_ length: Int, to output: inout [UInt8]) {
+        var remaining = length
+        while remaining >= 255 {
+            output.append(255)
+            remaining -= 255
+        }
+        output.append(UInt8(remaining))
+    }
+}
+
+// MARK: - SHA-256
+// FIPS 180-4, for content addresses; CryptoKit isn't available to the Linux build
+struct SHA256 {
+    private static let roundConstants: [UInt32] = [
+        0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+        0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+        0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+        0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+        0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+        0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+        0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+        0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+    ]
+    private static let hexDigits = Array("0123456789abcdef".utf8)
+
+    private var state: [UInt32] = [0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19]
+    private var schedule = [UInt32](repeating: 0, count: 64)
+    private var pending: [UInt8] = [] // Fewer than 64 bytes waiting for a full block
+    private var length: UInt64 = 0
+
+    static func digest(_ data: Data) -> [UInt8] {
+        var hasher = SHA256()
+        hasher.update(data)
+        return hasher.finalize()
+    }
+
+    static func hex(_ digest: [UInt8]) -> String {
+        var characters: [UInt8] = []
+        characters.reserveCapacity(digest.count * 2)
+        for byte in digest {
+            characters.append(hexDigits[Int(byte >> 4)])
+            characters.append(hexDigits[Int(byte & 0x0F)])
+        }
+        return String(decoding: characters, as: UTF8.self)
+    }
+
+    mutating func update(_ data: Data) {
+        length &+= UInt64(data.count)
+        data.withUnsafeBytes { buffer in
+            var index = 0
+            if !pending.isEmpty {
+                index = min(64 - pending.count, buffer.count)
+                pending.append(contentsOf: buffer[0..<index])
+                guard pending.count == 64 else { return }
+                let block = pending // Copied, as compress(_:) mutates self
+                block.withUnsafeBytes { compress($0.baseAddress!) }
+                pending.removeAll(keepingCapacity: true)
+            }
+            while index + 64 <= buffer.count {
+                compress(buffer.baseAddress! + index)
+                index += 64
+            }
+            pending.append(contentsOf: buffer[index...])
+        }
+    }
+
+    mutating func finalize() -> [UInt8] {
+        let bitLength = length &* 8
+        var tail = pending
+        tail.append(0x80)
+        while tail.count % 64 != 56 {
+            tail.append(0)
+        }
+        for shift in stride(from: 56, through: 0, by: -8) {
+            tail.append(UInt8(truncatingIfNeeded: bitLength >> UInt64(shift)))
+        }
+        tail.withUnsafeBytes { buffer in
+            for offset in stride(from: 0, to: buffer.count, by: 64) {
+                compress(buffer.baseAddress! + offset)
+            }
+        }
+        pending.removeAll()
+        return state.flatMap { word in [24, 16, 8, 0].map { UInt8(truncatingIfNeeded: word >> UInt32($0)) } }
+    }
+
+    private mutating func compress(_ block: UnsafeRawPointer) {
+        func rotate(_ value: UInt32, _ count: UInt32) -> UInt32 {
+            value >> count | value << (32 - count)
+        }
+        for t in 0..<16 {
+            schedule[t] = UInt32(bigEndian: block.loadUnaligned(fromByteOffset: t * 4, as: UInt32.self))
+        }
+        for t in 16..<64 {
+            let s0 = rotate(schedule[t - 15], 7) ^ rotate(schedule[t - 15], 18) ^ (schedule[t - 15] >> 3)
+            let s1 = rotate(schedule[t - 2], 17) ^ rotate(schedule[t - 2], 19) ^ (schedule[t - 2] >> 10)
+            schedule[t] = schedule[t - 16] &+ s0 &+ schedule[t - 7] &+ s1
+        }
+
+        var a = state[0], b = state[1], c = state[2], d = state[3]
+        var e = state[4], f = state[5], g = state[6], h = state[7]
+        for t in 0..<64 {
+            let s1 = rotate(e, 6) ^ rotate(e, 11) ^ rotate(e, 25)
+            let choice = (e & f) ^ (~e & g)
+            let temp1 = h &+ s1 &+ choice &+ Self.roundConstants[t] &+ schedule[t]
+            let s0 = rotate(a, 2) ^ rotate(a, 13) ^ rotate(a, 22)
+            let majority = (a & b) ^ (a & c) ^ (b & c)
+            let temp2 = s0 &+ majority
+            h = g
+            g = f
+            f = e
+            e = d &+ temp1
+            d = c
+            c = b
+            b = a
+            a = temp1 &+ temp2
+        }
+        state[0] &+= a
+        state[1] &+= b
+        state[2] &+= c
+        state[3] &+= d
+        state[4] &+= e
+        state[5] &+= f
+        state[6] &+= g
+        state[7] &+= h
+    }
+}
@@ -0,0 +1,116 @@
+//
+//  BuiltInActivityCatalog.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Built-in Activity
+struct BuiltInActivity {
+    let id: UUID
+    let name: String
+    let metValue: Double
+    let asset: AppAsset
+
+    // Asset catalog key, as stored on workout and diary rows
+    var imageName: String { asset.name }
+
+    // Numbers are permanent: never reuse or renumber, overlays in the store are keyed by the derived UUID
+    init(number: Int, name: String, metValue: Double, asset: AppAsset) {
+        self.id = BuiltInActivityCatalog.id(for: number)
+        self.name = name
+        self.metValue = metValue
+        self.asset = asset
+    }
+}
+
+// MARK: - Built-in Activity Catalog
+// Compiled into the app; the store only keeps custom activities and per-user overlays (favorite, last used).
+enum BuiltInActivityCatalog {
+    static let all: [BuiltInActivity] = [
+        BuiltInActivity(number: 1, name: "Abs", metValue: 2.8, asset: .abs),
+        BuiltInActivity(number: 2, name: "Badminton", metValue: 4.5, asset: .shuttleCock),
+        BuiltInActivity(number: 3, name: "Baseball", metValue: 5.0, asset: .baseball),
+        BuiltInActivity(number: 4, name: "Basketball", metValue: 6.5, asset: .basketball),
+        BuiltInActivity(number: 5, name: "Boxing", metValue: 12.0, asset: .boxing),
+        BuiltInActivity(number: 6, name: "Calisthenics", metValue: 8.0, asset: .calisthenics),
+        BuiltInActivity(number: 7, name: "Cross-Country Skiing", metValue: 9.0, asset: .xSkiing),
+        BuiltInActivity(number: 8, name: "Cycling", metValue: 8.0, asset: .biking),
+        BuiltInActivity(number: 9, name: "Elliptical", metValue: 5.0, asset: .eliptical),
+        BuiltInActivity(number: 10, name: "Golf", metValue: 4.3, asset: .golf),
+        BuiltInActivity(number: 11, name: "Hiking", metValue: 6.5, asset: .hiking),
+        BuiltInActivity(number: 12, name: "Hockey", metValue: 8.0, asset: .hockey),
+        BuiltInActivity(number: 13, name: "Jogging", metValue: 7.0, asset: .running),
+        BuiltInActivity(number: 14, name: "Mountain Biking", metValue: 8.5, asset: .mountainBike),
+        BuiltInActivity(number: 15, name: "Paddle Boarding", metValue: 4.0, asset: .paddle),
+        BuiltInActivity(number: 16, name: "Pickleball", metValue: 4.1, asset: .pickle),
+        BuiltInActivity(number: 17, name: "Pilates", metValue: 3.0, asset: .pilates),
+        BuiltInActivity(number: 18, name: "Racquetball", metValue: 7.0, asset: .racquetball),
+        BuiltInActivity(number: 19, name: "Rock Climbing", metValue: 9.0, asset: .rockclimbing),
+        BuiltInActivity(number: 20, name: "Rowing", metValue: 7.0, asset: .rowing),
+        BuiltInActivity(number: 21, name: "Running", metValue: 9.8, asset: .running),
+        BuiltInActivity(number: 22, name: "Scuba Diving", metValue: 7.0, asset: .scuba),
+        BuiltInActivity(number: 23, name: "Skiing", metValue: 7.0, asset: .skiing),
+        BuiltInActivity(number: 24, name: "Snowboarding", metValue: 5.0, asset: .snowboarding),
+        BuiltInActivity(number: 25, name: "Soccer", metValue: 7.0, asset: .soccer),
+        BuiltInActivity(number: 26, name: "Spinning", metValue: 8.5, asset: .spinning),
+        BuiltInActivity(number: 27, name: "Squash", metValue: 7.3, asset: .racquetball),
+        BuiltInActivity(number: 28, name: "Swimming", metValue: 8.3, asset: .swimming),
+        BuiltInActivity(number: 29, name: "Tennis", metValue: 7.3, asset: .tennis),
+        BuiltInActivity(number: 30, name: "Volleyball", metValue: 3.5, asset: .volley),
+        BuiltInActivity(number: 31, name: "Walking", metValue: 3.8, asset: .walking),
+        BuiltInActivity(number: 32, name: "Weight Training", metValue: 6.0, asset: .weights),
+        BuiltInActivity(number: 33, name: "Yoga", metValue: 2.5, asset: .yoga),
+        BuiltInActivity(number: 34, name: "Zumba", metValue: 5.5, asset: .zumba),
+        BuiltInActivity(number: 35, name: "Cleaning", metValue: 3.5, asset: .cleaning),
+        BuiltInActivity(number: 36, name: "Gardening", metValue: 3.8, asset: .garden),
+        BuiltInActivity(number: 37, name: "Mowing Lawn", metValue: 5.5, asset: .mowing),
+        BuiltInActivity(number: 38, name: "Shoveling Snow", metValue: 6.0, asset: .snow),
+        BuiltInActivity(number: 39, name: "Cleaning Windows", metValue: 3.2, asset: .cleaningwindows),
+        BuiltInActivity(number: 40, name: "Painting", metValue: 4.5, asset: .paint),
+        BuiltInActivity(number: 41, name: "Shopping", metValue: 2.3, asset: .shop),
+        BuiltInActivity(number: 42, name: "Childcare", metValue: 3.0, asset: .child),
+        BuiltInActivity(number: 43, name: "Standing", metValue: 2.5, asset: .bmDefault),
+        BuiltInActivity(number: 44, name: "Construction Work", metValue: 4.0, asset: .const),
+        BuiltInActivity(number: 45, name: "Carpentry", metValue: 6.0, asset: .carpentery),
+        BuiltInActivity(number: 46, name: "Nursing", metValue: 3.3, asset: .nurse),
+        BuiltInActivity(number: 47, name: "Teaching", metValue: 2.8, asset: .teach),
+        BuiltInActivity(number: 48, name: "Moving Furniture", metValue: 6.0, asset: .moving),
+        BuiltInActivity(number: 49, name: "Rucking", metValue: 7.0, asset: .rucking),
+        BuiltInActivity(number: 50, name: "Sprinting", metValue: 14.0, asset: .sprinting),
+        BuiltInActivity(number: 51, name: "Treading Water", metValue: 3.5, asset: .swimming),
+        BuiltInActivity(number: 52, name: "Table Tennis", metValue: 4.0, asset: .pingPong),
+        BuiltInActivity(number: 53, name: "Martial Arts", metValue: 10.0, asset: .martialArts),
+        BuiltInActivity(number: 54, name: "Stretching", metValue: 2.5, asset: .stretch),
+        BuiltInActivity(number: 55, name: "Aerobics", metValue: 5.0, asset: .zumba),
+        BuiltInActivity(number: 56, name: "Jump Rope", metValue: 8.8, asset: .jumpRope),
+        BuiltInActivity(number: 57, name: "Dancing", metValue: 3.0, asset: .zumba),
+        BuiltInActivity(number: 58, name: "Fishing", metValue: 3.5, asset: .fish),
+        BuiltInActivity(number: 59, name: "Horseback Riding", metValue: 5.8, asset: .horse),
+        BuiltInActivity(number: 60, name: "Skating", metValue: 7.0, asset: .skateing),
+        BuiltInActivity(number: 61, name: "Ice Skating", metValue: 7.0, asset: .iceSkateing),
+        BuiltInActivity(number: 62, name: "Kayaking", metValue: 5.0, asset: .kayak),
+        BuiltInActivity(number: 63, name: "Canoeing", metValue: 3.0, asset: .kayak),
+        BuiltInActivity(number: 64, name: "Playing Video Games", metValue: 3.8, asset: .vgame),
+    ]
+
+    static let byID: [UUID: BuiltInActivity] = Dictionary(uniqueKeysWithValues: all.map { ($0.id, $0) })
+    static let byName: [String: BuiltInActivity] = Dictionary(all.map { ($0.name, $0) }, uniquingKeysWith: { first, _ in first })
+
+    // Names written by older preload versions that no longer match the catalog
+    static let legacyNames: [String: String] = [
+        " VICross-Country Skiing": "Cross-Country Skiing"
+    ]
+
+    static func id(for number: Int) -> UUID {
+        UUID(uuidString: String(format: "A1C7B000-0000-4000-8000-%012d", number))!
+    }
+
+    static func isBuiltIn(_ id: UUID) -> Bool {
+        byID[id] != nil
+    }
+
+    static func activity(named name: String) -> BuiltInActivity? {
+        byName[legacyNames[name] ?? name]
+    }
+}
@@ -31,36 +31,76 @@ struct CalorieCounterApp: App {
 }
 
 struct SplashScreenView: View {
-    @State private var isActive = false
+    @StateObject private var startup = StartupPipeline.shared
+    @Environment(\.scenePhase) private var scenePhase
     @AppStorage("appState") private var appState: String = "setup" // Tracks the app's current state
 
     var body: some View {
         VStack {
-            if isActive {
+            if startup.isReady {
                 // Navigate dynamically based on appState
                 if appState == "dashboard" {
                     DashboardView() // ✅ Redirect to Dashboard
                 } else {
                     UserSetupView()
                 }
+            } else if let error = startup.loadError {
+                StoreLoadErrorView(error: error) {
+                    Task { await startup.retry() }
+                }
             } else {
-                // Display the splash screen
-                Image("logo")
+                // Display the splash screen until the startup pipeline finishes
+                AppAsset.logo.image
                     .resizable()
                     .scaledToFit()
                     .frame(width: 200, height: 200)
-                    .onAppear {
-                        // Simulate a delay for the splash screen
-                        withAnimation(.easeOut(duration: 2)) {
-                            DispatchQueue.main.asyncAfter(deadline: .now() + 2) {
-                                isActive = true
-                            }
-                        }
-                    }
+            }
+        }
+        .animation(.easeOut(duration: 0.3), value: startup.isReady)
+        .task {
+            await startup.start()
+        }
+        .onChange(of: scenePhase) { phase in
+            // Launch is covered by the startup pipeline; this catches days that pass while backgrounded
+            guard phase == .active, startup.isReady else { return }
+            Task {
+                await RolloverProcessor.shared.catchUp()
+                await MainActor.run { AppClock.shared.objectWillChange.send() }
+                await RolloverProcessor.shared.archiveClosedDays()
+                await StoreBackup.shared.backUpIfDue()
             }
         }
     }
 }
 
+// Shown in place of the splash when the store couldn't be loaded; the app can't go further without it
+struct StoreLoadErrorView: View {
+    let error: Error
+    let retry: () -> Void
 
-
+    var body: some View {
+        VStack(spacing: 16) {
+            AppAsset.logo.image
+                .resizable()
+                .scaledToFit()
+                .frame(width: 120, height: 120)
+            Text("Your data couldn't be opened")
+                .font(.headline)
+                .foregroundColor(Styles.primaryText)
+            Text(error.localizedDescription)
+                .font(.subheadline)
+                .foregroundColor(Styles.secondaryText)
+                .multilineTextAlignment(.center)
+            Button(action: retry) {
+                Text("Try Again")
+                    .fontWeight(.semibold)
+                    .foregroundColor(.white)
+                    .padding(.horizontal, 32)
+                    .padding(.vertical, 12)
+                    .background(Styles.primaryButton)
+                    .cornerRadius(10)
+            }
+        }
+        .padding(32)
+    }
+}
@@ -15,7 +15,7 @@ struct ChangeDateView: View {
         VStack(spacing: 20) {
             Spacer(minLength: 40)
             
-            Image("calender")
+            AppAsset.calender.image
                 .resizable()
                 .scaledToFit()
                 .frame(height: 150)
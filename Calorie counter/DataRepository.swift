@@ -0,0 +1,477 @@
+//
+//  DataRepository.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Snapshots
+// Plain values handed to views; nothing here holds on to a managed object or context
+
+struct DaySummary: Identifiable, Equatable {
+    var id: Date { date }
+    let date: Date
+    let calorieIntake: Double
+    let calorieGoal: Double
+    let passFail: Bool
+    let weighIn: Double
+    let waterIntake: Double
+    let waterGoal: Double
+    let waterUnit: String?
+}
+
+struct WeighInSample: Equatable {
+    let timestamp: Date
+    let weight: Double
+}
+
+struct DayRecordSnapshot: Equatable {
+    let recordID: NSManagedObjectID // For writers on the view context to look the record up without fetching
+    let summary: DaySummary
+    let entries: [DiaryEntry] // Sorted by timestamp
+    let weighIns: [WeighInSample] // Sorted by timestamp
+}
+
+// A gallery row; the image columns are loaded separately, per visible cell
+struct ProgressPhotoSummary: Identifiable, Equatable {
+    let id: NSManagedObjectID
+    let date: Date?
+    let weight: Double
+}
+
+enum PhotoSize {
+    case thumbnail // Grid cells
+    case display // Full screen and share cards
+}
+
+// Per-day values the Today header shows, computed off the main thread
+struct DayHeaderSnapshot: Equatable {
+    var dayNumber: Int? = nil // 1-based position among all records, nil when the day has no record
+    var passFail: Bool? = nil
+    var calorieGoal: Double? = nil
+    var weighIn: Double = 0
+    var passStreak: Int = 0 // Consecutive passed days before `today`
+}
+
+struct ProfileSnapshot: Equatable {
+    let name: String
+    let goalText: String
+    let startDate: Date?
+    let currentWeight: Double
+    let startWeight: Double
+    let goalWeight: Double
+    let weekGoal: Double
+    let dailyCalorieGoal: Int
+    let highStreak: Int32
+    let highestActivityStreak: Int32
+    let useMetric: Bool
+    let profilePicture: Data?
+
+    init(_ profile: UserProfile) {
+        self.name = profile.name ?? "User"
+        self.goalText = profile.goalText ?? "No Goal Set"
+        self.startDate = profile.startDate
+        self.currentWeight = profile.currentWeight
+        self.startWeight = profile.startWeight
+        self.goalWeight = profile.goalWeight
+        self.weekGoal = profile.weekGoal
+        self.dailyCalorieGoal = Int(profile.dailyCalorieGoal)
+        self.highStreak = profile.highStreak
+        self.highestActivityStreak = profile.highestActivityStreak
+        self.useMetric = profile.useMetric
+        self.profilePicture = profile.profilePicture
+    }
+
+    var weightUnit: String { useMetric ? "kg" : "lbs" }
+}
+
+// MARK: - Data Repository
+// Owns a private background context; every query runs there and returns value snapshots.
+// Views await these instead of fetching on viewContext while rendering.
+actor DataRepository {
+    static let shared = DataRepository(persistence: .shared, archiver: .shared)
+
+    private let persistence: PersistenceController
+    private let context: NSManagedObjectContext
+    private let clock: AppClock
+    private let calendar: Calendar
+    private let archiver: HistoryArchiver?
+    private var prewarmedDay: (day: Date, snapshot: DayRecordSnapshot?)?
+
+    // Pass PersistenceController(inMemory: true) for an isolated store. Without an archiver every
+    // query reads the store.
+    init(persistence: PersistenceController, clock: AppClock = .shared, archiver: HistoryArchiver? = nil) {
+        self.persistence = persistence
+        self.clock = clock
+        self.calendar = clock.calendar
+        self.archiver = archiver
+        self.context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.automaticallyMergesChangesFromParent = true
+        context.undoManager = nil
+    }
+
+    // MARK: Days
+    // Entries come back without their image bytes; rows that have one are marked imageDeferred
+    // and load it through entryImage(id:) when they are drawn
+    func dayRecord(for date: Date) async throws -> DayRecordSnapshot? {
+        let day = calendar.startOfDay(for: date)
+        return try await query { context in
+            let recordFetch = Self.projection("DailyRecord", DaySummary.properties, includingObjectID: true)
+            recordFetch.predicate = NSPredicate(format: "date == %@", day as NSDate)
+            let records = try context.loggedFetch(recordFetch)
+            // Duplicate records can exist for a day; prefer the one that actually has data
+            let record = try records.first { row in
+                guard let objectID = row["objectID"] as? NSManagedObjectID else { return false }
+                return try Self.hasChildren(objectID, in: context)
+            } ?? records.first
+            guard let record = record, let objectID = record["objectID"] as? NSManagedObjectID else {
+                return nil
+            }
+
+            let imageFetch = Self.projection("CoreDiaryEntry", ["id"])
+            imageFetch.predicate = NSPredicate(format: "dailyRecord == %@ AND imageData != nil", objectID)
+            let imagedIDs = Set(try context.loggedFetch(imageFetch).compactMap { $0["id"] as? UUID })
+
+            let entryFetch = Self.projection("CoreDiaryEntry", DiaryEntry.properties)
+            entryFetch.predicate = NSPredicate(format: "dailyRecord == %@", objectID)
+            entryFetch.sortDescriptors = [NSSortDescriptor(key: "timestamp", ascending: true)]
+            let entries = try context.loggedFetch(entryFetch).map { row -> DiaryEntry in
+                let id = row["id"] as? UUID
+                return DiaryEntry(row, on: day, imageDeferred: id.map(imagedIDs.contains) ?? false)
+            }
+
+            let weighInFetch = Self.projection("WeighInEntry", ["timestamp", "weight"])
+            weighInFetch.predicate = NSPredicate(format: "dailyRecord == %@", objectID)
+            weighInFetch.sortDescriptors = [NSSortDescriptor(key: "timestamp", ascending: true)]
+            let weighIns = try context.loggedFetch(weighInFetch).map { row in
+                WeighInSample(timestamp: row["timestamp"] as? Date ?? day, weight: row["weight"] as? Double ?? 0)
+            }
+            return DayRecordSnapshot(recordID: objectID, summary: DaySummary(record, day: day), entries: entries, weighIns: weighIns)
+        }
+    }
+
+    // The day before `date`, whose water goal and weigh-in a new day carries over
+    func previousDay(before date: Date) async throws -> DaySummary? {
+        guard let previous = calendar.date(byAdding: .day, value: -1, to: calendar.startOfDay(for: date)) else { return nil }
+        return try await query { context in
+            let fetchRequest = Self.projection("DailyRecord", DaySummary.properties)
+            fetchRequest.predicate = NSPredicate(format: "date == %@", previous as NSDate)
+            fetchRequest.fetchLimit = 1
+            return try context.loggedFetch(fetchRequest).first.map { DaySummary($0, day: previous) }
+        }
+    }
+
+    // Fetched while the splash is up, for the Today screen's first load to take instead of querying again
+    func prewarmDayRecord(for date: Date) async {
+        do {
+            let snapshot = try await dayRecord(for: date)
+            prewarmedDay = (calendar.startOfDay(for: date), snapshot)
+        } catch {
+            AppLog.warning("Failed to prewarm \(date): \(error.localizedDescription)", category: .startup)
+        }
+    }
+
+    // The prewarmed snapshot for `date`, handed out once; later loads query the store
+    func dayRecord(prewarmedFor date: Date) async throws -> DayRecordSnapshot? {
+        if let prewarmed = prewarmedDay {
+            prewarmedDay = nil
+            if prewarmed.day == calendar.startOfDay(for: date) {
+                return prewarmed.snapshot
+            }
+        }
+        return try await dayRecord(for: date)
+    }
+
+    // Records in [start, end), oldest first. Closed days are read from the history archive's columns; only
+    // days it doesn't cover yet are fetched, scalar columns only
+    func daySummaries(from start: Date = .distantPast, to end: Date = .distantFuture) async throws -> [DaySummary] {
+        let archive = archiver?.snapshot(before: clock.today)
+        var summaries = try archive.map { try DaySummary.archived($0, in: $0.indices(from: start, to: end)) } ?? []
+        let archivedThrough = archive?.lastDate ?? .distantPast
+        summaries += try await query { context in
+            let fetchRequest = Self.projection("DailyRecord", DaySummary.properties)
+            fetchRequest.predicate = NSPredicate(format: "date >= %@ AND date < %@ AND date > %@", start as NSDate, end as NSDate, archivedThrough as NSDate)
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+            return try context.loggedFetch(fetchRequest).compactMap { row in
+                (row["date"] as? Date).map { DaySummary(row, day: $0) }
+            }
+        }
+        return summaries
+    }
+
+    // One sample per recorded day, oldest first; days without a weigh-in carry a weight of 0
+    func dailyWeights() async throws -> [WeighInSample] {
+        let archive = archiver?.snapshot(before: clock.today)
+        var samples: [WeighInSample] = []
+        if let archive = archive {
+            samples.reserveCapacity(archive.dayCount)
+            archive.withValues(.date) { dates in
+                archive.withValues(.weighIn) { weights in
+                    for index in dates.indices {
+                        samples.append(WeighInSample(timestamp: Date(timeIntervalSinceReferenceDate: dates[index]), weight: weights[index]))
+                    }
+                }
+            }
+        }
+        let archivedThrough = archive?.lastDate ?? .distantPast
+        samples += try await query { context in
+            let fetchRequest = Self.projection("DailyRecord", ["date", "weighIn"])
+            fetchRequest.predicate = NSPredicate(format: "date > %@", archivedThrough as NSDate)
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+            return try context.loggedFetch(fetchRequest).compactMap { row in
+                guard let date = row["date"] as? Date else { return nil }
+                return WeighInSample(timestamp: date, weight: row["weighIn"] as? Double ?? 0)
+            }
+        }
+        return samples
+    }
+
+    // The image column for a single diary entry, fetched on its own when a deferred row is drawn
+    func entryImage(id: UUID) async throws -> Data? {
+        try await query { context in
+            let fetchRequest = Self.projection("CoreDiaryEntry", ["imageData"])
+            fetchRequest.predicate = NSPredicate(format: "id == %@", id as CVarArg)
+            fetchRequest.fetchLimit = 1
+            return try context.loggedFetch(fetchRequest).first?["imageData"] as? Data
+        }
+    }
+
+    func dayHeader(for date: Date, today: Date) async throws -> DayHeaderSnapshot {
+        let calendar = self.calendar
+        let day = calendar.startOfDay(for: date)
+        let today = calendar.startOfDay(for: today)
+        return try await query { context in
+            var header = DayHeaderSnapshot()
+
+            let recordFetch: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+            recordFetch.predicate = NSPredicate(format: "date == %@", day as NSDate)
+            recordFetch.fetchLimit = 1
+            if let record = try context.loggedFetch(recordFetch).first {
+                let earlierFetch: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+                earlierFetch.predicate = NSPredicate(format: "date < %@", day as NSDate)
+                header.dayNumber = try context.count(for: earlierFetch) + 1
+                header.passFail = record.passFail
+                header.calorieGoal = record.calorieGoal
+                header.weighIn = record.weighIn
+            }
+
+            // Walk back from yesterday until a failed or missing day; lazy so batches past the break are never faulted
+            let streakFetch: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+            streakFetch.predicate = NSPredicate(format: "date < %@", today as NSDate)
+            streakFetch.sortDescriptors = [NSSortDescriptor(key: "date", ascending: false)]
+            streakFetch.fetchBatchSize = 32
+            let days = try context.loggedFetch(streakFetch).lazy.compactMap { record in
+                record.date.map { (day: $0, passed: record.passFail) }
+            }
+            header.passStreak = StreakCalculator.passStreak(days, before: today, calendar: calendar)
+            return header
+        }
+    }
+
+    // MARK: Progress Photos
+    // Oldest first, without any image columns
+    func progressPhotos(for profileID: NSManagedObjectID) async throws -> [ProgressPhotoSummary] {
+        try await query { context in
+            let fetchRequest = Self.projection("ProgressPicture", ["date", "weight"], includingObjectID: true)
+            fetchRequest.predicate = NSPredicate(format: "userProfile == %@", profileID)
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+            return try context.loggedFetch(fetchRequest).compactMap { row in
+                guard let objectID = row["objectID"] as? NSManagedObjectID else { return nil }
+                return ProgressPhotoSummary(id: objectID, date: row["date"] as? Date, weight: row["weight"] as? Double ?? 0)
+            }
+        }
+    }
+
+    // A stored rendition of a progress picture, or of a profile's start picture.
+    // Rows the backfill has not reached yet fall back to the original.
+    func photoData(_ objectID: NSManagedObjectID, size: PhotoSize) async throws -> Data? {
+        try await query { context in
+            guard let entityName = objectID.entity.name else { return nil }
+            let columns: [String]
+            switch (entityName == "UserProfile", size) {
+            case (true, .thumbnail): columns = ["startPictureThumbnail", "startPicture"]
+            case (true, .display): columns = ["startPictureDisplay", "startPicture"]
+            case (false, .thumbnail): columns = ["thumbnailData", "imageData"]
+            case (false, .display): columns = ["displayData", "imageData"]
+            }
+            for column in columns {
+                let fetchRequest = Self.projection(entityName, [column])
+                fetchRequest.predicate = NSPredicate(format: "self == %@", objectID)
+                if let data = try context.loggedFetch(fetchRequest).first?[column] as? Data {
+                    return data
+                }
+            }
+            return nil
+        }
+    }
+
+    // MARK: Body Measurements
+    // Oldest first, read straight into the columnar series; values are already centimetres
+    func measurementSeries(for profileID: NSManagedObjectID) async throws -> MeasurementSeries {
+        try await query { context in
+            let metrics = BodyMetric.allCases
+            let fetchRequest = Self.projection("BodyMeasurement", ["date"] + metrics.map(\.attributeName))
+            fetchRequest.predicate = NSPredicate(format: "userProfile == %@", profileID)
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+            var series = MeasurementSeries()
+            for row in try context.loggedFetch(fetchRequest) {
+                guard let date = row["date"] as? Date else { continue }
+                series.append(date: date, centimeters: metrics.map { row[$0.attributeName] as? Double ?? 0 })
+            }
+            return series
+        }
+    }
+
+    // MARK: Profile
+    func profile() async throws -> ProfileSnapshot? {
+        try await storedProfile()?.snapshot
+    }
+
+    // With its object ID, so ProfileStore can load off the main thread and still edit the row later
+    func storedProfile() async throws -> (objectID: NSManagedObjectID, snapshot: ProfileSnapshot)? {
+        try await query { context in
+            let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "lastSavedDate", ascending: false)]
+            fetchRequest.fetchLimit = 1
+            return try context.loggedFetch(fetchRequest).first.map { (objectID: $0.objectID, snapshot: ProfileSnapshot($0)) }
+        }
+    }
+
+    // MARK: Activities
+    func activities() async throws -> [ActivitySnapshot] {
+        var byID = ActivityRegistry.catalogSnapshots
+        for stored in try await storedActivities() {
+            byID[stored.snapshot.id] = stored.snapshot
+        }
+        return byID.values.sorted { $0.name < $1.name }
+    }
+
+    // The stored rows (custom activities and built-in overlays), for ActivityRegistry's first load
+    func storedActivities() async throws -> [ActivityRegistry.StoredActivity] {
+        try await query { context in
+            let catalog = ActivityRegistry.catalogSnapshots
+            return try context.loggedFetch(ActivityModel.fetchRequest()).compactMap { activity in
+                ActivityRegistry.snapshot(for: activity, base: catalog).map { (objectID: activity.objectID, snapshot: $0) }
+            }
+        }
+    }
+
+    // MARK: Plumbing
+    // Dictionary rows holding only `properties`; no managed objects are registered, so nothing lands in the row cache
+    private static func projection(_ entityName: String, _ properties: [String], includingObjectID: Bool = false) -> NSFetchRequest<NSDictionary> {
+        let fetchRequest = NSFetchRequest<NSDictionary>(entityName: entityName)
+        fetchRequest.resultType = .dictionaryResultType
+        var propertiesToFetch: [Any] = properties
+        if includingObjectID {
+            let objectID = NSExpressionDescription()
+            objectID.name = "objectID"
+            objectID.expression = NSExpression.expressionForEvaluatedObject()
+            objectID.expressionResultType = .objectIDAttributeType
+            propertiesToFetch.append(objectID)
+        }
+        fetchRequest.propertiesToFetch = propertiesToFetch
+        return fetchRequest
+    }
+
+    private static func hasChildren(_ recordID: NSManagedObjectID, in context: NSManagedObjectContext) throws -> Bool {
+        for entityName in ["CoreDiaryEntry", "WeighInEntry"] {
+            let fetchRequest = NSFetchRequest<NSNumber>(entityName: entityName)
+            fetchRequest.predicate = NSPredicate(format: "dailyRecord == %@", recordID)
+            fetchRequest.fetchLimit = 1
+            if try context.count(for: fetchRequest) > 0 {
+                return true
+            }
+        }
+        return false
+    }
+
+    // Waits for the store, then runs the body on the background context's queue
+    private func query<T>(_ body: @escaping (NSManagedObjectContext) throws -> T) async throws -> T {
+        try await persistence.waitForStores()
+        let context = self.context
+        return try await context.perform {
+            defer { context.reset() } // Snapshots are copied out; don't let the row cache grow with history
+            return try AppLog.interval("Repository query", category: .persistence) {
+                try body(context)
+            }
+        }
+    }
+}
+
+// MARK: - Snapshot Mapping
+extension DaySummary {
+    static let properties = ["date", "calorieIntake", "calorieGoal", "passFail", "weighIn", "waterIntake", "waterGoal", "waterUnit"]
+
+    // Straight from the archive's columns; only the water unit touches the variable-width section
+    static func archived(_ archive: HistoryArchive, in range: Range<Int>) throws -> [DaySummary] {
+        try range.map { index in
+            DaySummary(
+                date: archive.date(at: index),
+                calorieIntake: archive.value(.calorieIntake, at: index),
+                calorieGoal: archive.value(.calorieGoal, at: index),
+                passFail: archive.passed(at: index),
+                weighIn: archive.value(.weighIn, at: index),
+                waterIntake: archive.value(.waterIntake, at: index),
+                waterGoal: archive.value(.waterGoal, at: index),
+                waterUnit: try archive.waterUnit(at: index)
+            )
+        }
+    }
+
+    init(_ row: NSDictionary, day: Date) {
+        self.date = day
+        self.calorieIntake = row["calorieIntake"] as? Double ?? 0
+        self.calorieGoal = row["calorieGoal"] as? Double ?? 0
+        self.passFail = row["passFail"] as? Bool ?? false
+        self.weighIn = row["weighIn"] as? Double ?? 0
+        self.waterIntake = row["waterIntake"] as? Double ?? 0
+        self.waterGoal = row["waterGoal"] as? Double ?? 0
+        self.waterUnit = row["waterUnit"] as? String
+    }
+}
+
+extension DiaryEntry {
+    // Every column DiaryEntry shows except imageData
+    static let properties = ["id", "timestamp", "iconName", "entryDescription", "detail", "calories", "type", "imageName", "fats", "carbs", "protein", "waterAmountMl"]
+
+    init(_ row: NSDictionary, on day: Date, imageDeferred: Bool) {
+        self.init(
+            id: row["id"] as? UUID ?? UUID(),
+            timestamp: row["timestamp"] as? Date ?? day,
+            iconName: row["iconName"] as? String ?? "",
+            description: row["entryDescription"] as? String ?? "",
+            detail: row["detail"] as? String ?? "",
+            calories: (row["calories"] as? NSNumber)?.intValue ?? 0,
+            type: row["type"] as? String ?? "",
+            imageName: row["imageName"] as? String,
+            imageData: nil,
+            fats: row["fats"] as? Double ?? 0,
+            carbs: row["carbs"] as? Double ?? 0,
+            protein: row["protein"] as? Double ?? 0,
+            waterAmountMl: row["waterAmountMl"] as? Double ?? 0,
+            imageDeferred: imageDeferred
+        )
+    }
+
+    // A deferred entry never touches imageData, so the stored bytes aren't faulted in
+    init(_ entity: CoreDiaryEntry, on day: Date, imageDeferred: Bool = false) {
+        self.init(
+            id: entity.id ?? UUID(),
+            timestamp: entity.timestamp ?? day,
+            iconName: entity.iconName ?? "",
+            description: entity.entryDescription ?? "",
+            detail: entity.detail ?? "",
+            calories: Int(entity.calories),
+            type: entity.type ?? "",
+            imageName: entity.imageName,
+            imageData: imageDeferred ? nil : entity.imageData,
+            fats: entity.fats,
+            carbs: entity.carbs,
+            protein: entity.protein,
+            waterAmountMl: entity.waterAmountMl,
+            imageDeferred: imageDeferred
+        )
+    }
+}
@@ -0,0 +1,502 @@
+//
+//  DataTransfer.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Data Exporter
+// Writes every entity out as CSV (one file per entity) or as a single JSON document. Each entity is walked
+// by object ID in batches of dictionary rows that are written straight to disk, with the context reset in
+// between, so memory stays flat whatever the size of the history. Binary attributes (photos, icons) are left out.
+final class DataExporter {
+    enum Format: String, CaseIterable, Identifiable {
+        case csv = "CSV"
+        case json = "JSON"
+
+        var id: String { rawValue }
+    }
+
+    static let shared = DataExporter(persistence: .shared)
+
+    // Parents before children, so a file reads top to bottom
+    private static let entityNames = [
+        "UserProfile", "DailyRecord", "CoreDiaryEntry", "WorkoutEntry", "WeighInEntry",
+        "BodyMeasurement", "ProgressPicture", "ActivityModel"
+    ]
+    private static let batchSize = 500
+
+    private let persistence: PersistenceController
+
+    init(persistence: PersistenceController) {
+        self.persistence = persistence
+    }
+
+    // Files land in a new temporary folder, ready to hand to a share sheet.
+    // `progress` is called on the exporter's queue with the fraction of rows written.
+    func export(_ format: Format, progress: ((Double) -> Void)? = nil) async throws -> [URL] {
+        try await persistence.waitForStores()
+        let directory = FileManager.default.temporaryDirectory
+            .appendingPathComponent("Calorie Counter Export \(Self.fileStamp())", isDirectory: true)
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+        let context = persistence.container.newBackgroundContext()
+        context.undoManager = nil
+        let entities = persistence.container.managedObjectModel.entitiesByName
+        let tables = Self.entityNames.compactMap { entities[$0] }.map(ExportTable.init)
+
+        return try await AppLog.interval("Export", category: .persistence, detail: format.rawValue) {
+            try await context.perform {
+                let total = try tables.reduce(0) { $0 + (try context.count(for: NSFetchRequest<NSNumber>(entityName: $1.entityName))) }
+                var written = 0
+                let rowWritten = {
+                    written += 1
+                    if written % Self.batchSize == 0 {
+                        progress?(Double(written) / Double(max(total, 1)))
+                    }
+                }
+
+                var urls: [URL] = []
+                switch format {
+                case .csv:
+                    for table in tables {
+                        let url = directory.appendingPathComponent("\(table.entityName).csv")
+                        let file = try ExportFile(url: url)
+                        try file.write(CSV.line(table.columnNames))
+                        try Self.forEachRow(of: table, in: context) { row in
+                            try file.write(CSV.line(table.csvFields(row)))
+                            rowWritten()
+                        }
+                        try file.close()
+                        urls.append(url)
+                    }
+                case .json:
+                    let url = directory.appendingPathComponent("Calorie Counter Export.json")
+                    let file = try ExportFile(url: url)
+                    try file.write("{\"format\":\"Calorie Counter export\",\"version\":1,\"exportedAt\":\"\(ExportTable.timestampFormatter.string(from: Date()))\",\"entities\":{")
+                    for (index, table) in tables.enumerated() {
+                        try file.write("\(index == 0 ? "" : ",")\n\"\(table.entityName)\":[")
+                        var separator = "\n"
+                        try Self.forEachRow(of: table, in: context) { row in
+                            try file.write(separator)
+                            try file.write(JSONSerialization.data(withJSONObject: table.jsonObject(row), options: [.sortedKeys]))
+                            separator = ",\n"
+                            rowWritten()
+                        }
+                        try file.write("\n]")
+                    }
+                    try file.write("\n}}\n")
+                    try file.close()
+                    urls.append(url)
+                }
+                progress?(1)
+                AppLog.info("Exported \(written) rows as \(format.rawValue) to \(directory.lastPathComponent)", category: .persistence)
+                return urls
+            }
+        }
+    }
+
+    // Only object IDs are held for the whole entity; the rows themselves are fetched a batch at a time
+    private static func forEachRow(of table: ExportTable, in context: NSManagedObjectContext, _ body: ([String: Any]) throws -> Void) throws {
+        let idRequest = NSFetchRequest<NSManagedObjectID>(entityName: table.entityName)
+        idRequest.resultType = .managedObjectIDResultType
+        idRequest.sortDescriptors = table.sortDescriptors
+        let objectIDs = try context.loggedFetch(idRequest)
+
+        for start in stride(from: 0, to: objectIDs.count, by: batchSize) {
+            let fetchRequest = table.rowRequest()
+            fetchRequest.predicate = NSPredicate(format: "self IN %@", Array(objectIDs[start..<min(start + batchSize, objectIDs.count)]))
+            for row in try context.loggedFetch(fetchRequest) {
+                try body(row as? [String: Any] ?? [:])
+            }
+            context.reset()
+        }
+    }
+
+    private static func fileStamp() -> String {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.dateFormat = "yyyy-MM-dd HHmmss"
+        return formatter.string(from: Date())
+    }
+}
+
+// MARK: - Export Table
+// The exported columns of one entity: its non-binary attributes by name, plus the owning day's date
+// for rows that belong to a DailyRecord
+private struct ExportTable {
+    static let timestampFormatter = ISO8601DateFormatter()
+    private static let dayDateColumn = "dailyRecordDate"
+
+    let entityName: String
+    private let attributes: [(name: String, type: NSAttributeType)]
+    private let hasDay: Bool
+    let sortDescriptors: [NSSortDescriptor]
+
+    init(_ entity: NSEntityDescription) {
+        entityName = entity.name ?? ""
+        attributes = entity.attributesByName.values
+            .filter { ![.binaryDataAttributeType, .transformableAttributeType, .objectIDAttributeType].contains($0.attributeType) }
+            .sorted { $0.name < $1.name }
+            .map { (name: $0.name, type: $0.attributeType) }
+        hasDay = entity.relationshipsByName["dailyRecord"] != nil
+        sortDescriptors = ["date", "timestamp"].first { entity.attributesByName[$0] != nil }
+            .map { [NSSortDescriptor(key: $0, ascending: true)] } ?? []
+    }
+
+    var columnNames: [String] {
+        attributes.map(\.name) + (hasDay ? [Self.dayDateColumn] : [])
+    }
+
+    func rowRequest() -> NSFetchRequest<NSDictionary> {
+        let fetchRequest = NSFetchRequest<NSDictionary>(entityName: entityName)
+        fetchRequest.resultType = .dictionaryResultType
+        var propertiesToFetch: [Any] = attributes.map(\.name)
+        if hasDay {
+            let dayDate = NSExpressionDescription()
+            dayDate.name = Self.dayDateColumn
+            dayDate.expression = NSExpression(forKeyPath: "dailyRecord.date")
+            dayDate.expressionResultType = .dateAttributeType
+            propertiesToFetch.append(dayDate)
+        }
+        fetchRequest.propertiesToFetch = propertiesToFetch
+        fetchRequest.sortDescriptors = sortDescriptors
+        return fetchRequest
+    }
+
+    func csvFields(_ row: [String: Any]) -> [String] {
+        columns.map { name, type in
+            guard let value = row[name] else { return "" }
+            switch value {
+            case let date as Date:
+                return Self.timestampFormatter.string(from: date)
+            case let uuid as UUID:
+                return uuid.uuidString
+            case let number as NSNumber where type == .booleanAttributeType:
+                return number.boolValue ? "true" : "false"
+            default:
+                return "\(value)"
+            }
+        }
+    }
+
+    // Dates as ISO 8601 strings, booleans as true/false and missing values as null
+    func jsonObject(_ row: [String: Any]) -> [String: Any] {
+        var object: [String: Any] = [:]
+        for (name, type) in columns {
+            switch row[name] {
+            case let date as Date:
+                object[name] = Self.timestampFormatter.string(from: date)
+            case let uuid as UUID:
+                object[name] = uuid.uuidString
+            case let number as NSNumber where type == .booleanAttributeType:
+                object[name] = number.boolValue
+            case let value?:
+                object[name] = value
+            case nil:
+                object[name] = NSNull()
+            }
+        }
+        return object
+    }
+
+    private var columns: [(name: String, type: NSAttributeType)] {
+        attributes + (hasDay ? [(name: Self.dayDateColumn, type: .dateAttributeType)] : [])
+    }
+}
+
+// MARK: - Export File
+// Buffered appends to a new file
+private final class ExportFile {
+    private static let flushBytes = 256 * 1024
+
+    private let handle: FileHandle
+    private var buffer = Data()
+
+    init(url: URL) throws {
+        FileManager.default.createFile(atPath: url.path, contents: nil)
+        handle = try FileHandle(forWritingTo: url)
+    }
+
+    func write(_ string: String) throws {
+        try write(Data(string.utf8))
+    }
+
+    func write(_ data: Data) throws {
+        buffer.append(data)
+        if buffer.count >= Self.flushBytes {
+            try flush()
+        }
+    }
+
+    func close() throws {
+        try flush()
+        try handle.close()
+    }
+
+    private func flush() throws {
+        try handle.write(contentsOf: buffer)
+        buffer.removeAll(keepingCapacity: true)
+    }
+}
+
+// MARK: - Diary Importer
+// Imports a food-diary CSV (this app's CoreDiaryEntry export, MyFitnessPal, Cronometer, Lose It! or any file
+// with date, name and calories columns; see DiaryCSVMapping). The file is parsed as it streams in. Missing
+// days are created with one NSBatchInsertRequest; batch inserts can't set relationships, so the foods go
+// through a private-queue context in day chunks that are saved and reset, as SyntheticDataGenerator does.
+// Foods already on a day (same name, calories and minute) are skipped, so importing a file twice is harmless.
+final class DiaryImporter {
+    struct Summary {
+        let source: DiaryCSVMapping.Source
+        let foods: Int
+        let days: Int
+        let newDays: Int
+        let duplicates: Int
+        let skippedRows: Int
+        let seconds: Double
+    }
+
+    enum ImportError: LocalizedError {
+        case unrecognizedHeader
+        case noProfile
+
+        var errorDescription: String? {
+            switch self {
+            case .unrecognizedHeader: return "The file needs date, food name and calories columns."
+            case .noProfile: return "Set up your profile before importing a diary."
+            }
+        }
+    }
+
+    static let shared = DiaryImporter(persistence: .shared, clock: .shared, archiver: .shared, rollover: .shared)
+
+    private static let readBytes = 64 * 1024
+    private static let chunkDays = 90
+    private static let lookupBatch = 500
+
+    private let persistence: PersistenceController
+    private let clock: AppClock
+    private let archiver: HistoryArchiver?
+    private let rollover: RolloverProcessor?
+
+    init(persistence: PersistenceController, clock: AppClock, archiver: HistoryArchiver? = nil, rollover: RolloverProcessor? = nil) {
+        self.persistence = persistence
+        self.clock = clock
+        self.archiver = archiver
+        self.rollover = rollover
+    }
+
+    // `progress` is called on the importer's queue with the fraction of days written
+    func importDiary(from url: URL, progress: ((Double) -> Void)? = nil) async throws -> Summary {
+        try await persistence.waitForStores()
+        let start = DispatchTime.now().uptimeNanoseconds
+        let calendar = clock.calendar
+        let today = clock.today
+
+        let scoped = url.startAccessingSecurityScopedResource()
+        defer {
+            if scoped {
+                url.stopAccessingSecurityScopedResource()
+            }
+        }
+        let (mapping, rows, unreadable) = try AppLog.interval("Import parse", category: .persistence) {
+            try Self.read(url, calendar: calendar)
+        }
+        let foods = rows.filter { $0.day <= today } // Days that haven't happened yet are left out
+        let foodsByDay = Dictionary(grouping: foods, by: \.day)
+        let days = foodsByDay.keys.sorted()
+
+        let context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+        let result = try await AppLog.interval("Import diary", category: .persistence, detail: "\(foods.count) foods") {
+            try await context.perform {
+                try Self.write(foodsByDay, days: days, today: today, in: context, progress: progress)
+            }
+        }
+
+        // Batch inserts bypass the contexts; the food saves reach the view context through automaticallyMergesChangesFromParent
+        let viewContext = persistence.container.viewContext
+        await MainActor.run {
+            NSManagedObjectContext.mergeChanges(fromRemoteContextSave: [NSInsertedObjectsKey: result.newDayIDs], into: [viewContext])
+        }
+
+        // Archived days are immutable; when the import reaches back into them, rebuild the archive from the store
+        if let archiver = archiver, let firstDay = days.first,
+           let lastArchived = archiver.snapshot()?.lastDate, firstDay <= lastArchived {
+            archiver.discard()
+            await rollover?.archiveClosedDays()
+        }
+
+        let summary = Summary(
+            source: mapping.source,
+            foods: result.inserted,
+            days: days.count,
+            newDays: result.newDayIDs.count,
+            duplicates: result.duplicates,
+            skippedRows: unreadable + rows.count - foods.count,
+            seconds: Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        )
+        AppLog.info("Imported \(summary.foods) foods from \(summary.source.rawValue) over \(summary.days) days (\(summary.newDays) new) in \(String(format: "%.1f", summary.seconds))s; \(summary.duplicates) duplicate(s), \(summary.skippedRows) row(s) skipped", category: .persistence)
+        return summary
+    }
+
+    // MARK: Reading
+    private static func read(_ url: URL, calendar: Calendar) throws -> (DiaryCSVMapping, [ImportedFood], unreadable: Int) {
+        let handle = try FileHandle(forReadingFrom: url)
+        defer { try? handle.close() }
+
+        var mapping: DiaryCSVMapping?
+        var foods: [ImportedFood] = []
+        var unreadable = 0
+        func handleRow(_ row: [String]) throws {
+            guard let mapping = mapping else {
+                mapping = DiaryCSVMapping(header: row, calendar: calendar)
+                if mapping == nil {
+                    throw ImportError.unrecognizedHeader
+                }
+                return
+            }
+            if let food = mapping.food(from: row) {
+                foods.append(food)
+            } else {
+                unreadable += 1
+            }
+        }
+
+        var parser = CSVParser()
+        while let chunk = try handle.read(upToCount: readBytes), !chunk.isEmpty {
+            try parser.feed(chunk, row: handleRow)
+        }
+        try parser.finish(row: handleRow)
+        guard let found = mapping else { throw ImportError.unrecognizedHeader }
+        return (found, foods, unreadable)
+    }
+
+    // MARK: Writing
+    private struct FoodKey: Hashable {
+        let day: Date
+        let name: String
+        let calories: Int32
+        let minute: Int? // Minutes into the day; ISO 8601 exports drop the sub-second part of timestamps
+    }
+
+    private static func write(_ foodsByDay: [Date: [ImportedFood]], days: [Date], today: Date, in context: NSManagedObjectContext,
+                              progress: ((Double) -> Void)?) throws -> (newDayIDs: [NSManagedObjectID], inserted: Int, duplicates: Int) {
+        guard let profileID = try SyntheticDataGenerator.profileID(in: context),
+              let userProfile = try context.existingObject(with: profileID) as? UserProfile else {
+            throw ImportError.noProfile
+        }
+        let newDayValues: [String: Any] = [
+            "calorieGoal": Double(userProfile.dailyCalorieGoal),
+            "calorieIntake": 0.0,
+            "passFail": false,
+            "waterGoal": userProfile.waterGoal,
+            "waterIntake": 0.0,
+            "waterUnit": userProfile.waterUnit ?? WaterUnit.flOz.rawValue,
+            "weighIn": 0.0
+        ]
+        context.reset()
+
+        var recordIDs = try Self.recordIDs(for: days, in: context)
+        let missingDays = days.filter { recordIDs[$0] == nil }
+        var newDayIDs: [NSManagedObjectID] = []
+        if !missingDays.isEmpty {
+            let request = NSBatchInsertRequest(entityName: "DailyRecord", objects: missingDays.map { day in
+                newDayValues.merging(["date": day]) { $1 }
+            })
+            request.resultType = .objectIDs
+            newDayIDs = (try context.execute(request) as? NSBatchInsertResult)?.result as? [NSManagedObjectID] ?? []
+            recordIDs.merge(try Self.recordIDs(for: missingDays, in: context)) { existing, _ in existing }
+        }
+
+        var inserted = 0
+        var duplicates = 0
+        for chunkStart in stride(from: 0, to: days.count, by: chunkDays) {
+            let chunk = days[chunkStart..<min(chunkStart + chunkDays, days.count)]
+            var seen = try existingFoodKeys(on: chunk.compactMap { recordIDs[$0] }, in: context)
+            for day in chunk {
+                guard let recordID = recordIDs[day], let record = try context.existingObject(with: recordID) as? DailyRecord else { continue }
+                var addedCalories = 0.0
+                for food in foodsByDay[day] ?? [] {
+                    let calories = Int32(food.calories.rounded())
+                    let timestamp = food.timestamp ?? day.addingTimeInterval(12 * 3600) // Midday when the file has no times
+                    guard seen.insert(FoodKey(day: day, name: food.name, calories: calories, minute: minute(of: timestamp, on: day))).inserted else {
+                        duplicates += 1
+                        continue
+                    }
+                    let entry = CoreDiaryEntry(context: context)
+                    entry.id = UUID()
+                    entry.timestamp = timestamp
+                    entry.type = "Food"
+                    entry.entryDescription = food.name
+                    entry.detail = "\(calories) cal"
+                    entry.iconName = "DefaultFood"
+                    entry.imageName = AppAsset.defaultFood.name
+                    entry.calories = calories
+                    entry.protein = food.protein
+                    entry.carbs = food.carbs
+                    entry.fats = food.fats
+                    entry.dailyRecord = record
+                    addedCalories += Double(calories)
+                    inserted += 1
+                }
+                if addedCalories > 0 {
+                    record.calorieIntake += addedCalories
+                    if day < today { // Closed days are re-judged; today is judged when it closes
+                        record.passFail = record.calorieIntake <= record.calorieGoal
+                    }
+                }
+            }
+            try context.save()
+            context.reset()
+            progress?(Double(chunkStart + chunk.count) / Double(days.count))
+        }
+        return (newDayIDs, inserted, duplicates)
+    }
+
+    // One record per date; where duplicate records exist the oldest row wins
+    private static func recordIDs(for days: [Date], in context: NSManagedObjectContext) throws -> [Date: NSManagedObjectID] {
+        var recordIDs: [Date: NSManagedObjectID] = [:]
+        for start in stride(from: 0, to: days.count, by: lookupBatch) {
+            let fetchRequest = NSFetchRequest<NSDictionary>(entityName: "DailyRecord")
+            fetchRequest.resultType = .dictionaryResultType
+            let objectID = NSExpressionDescription()
+            objectID.name = "objectID"
+            objectID.expression = NSExpression.expressionForEvaluatedObject()
+            objectID.expressionResultType = .objectIDAttributeType
+            fetchRequest.propertiesToFetch = ["date", objectID]
+            fetchRequest.predicate = NSPredicate(format: "date IN %@", Array(days[start..<min(start + lookupBatch, days.count)]))
+            for row in try context.loggedFetch(fetchRequest) {
+                guard let date = row["date"] as? Date, let recordID = row["objectID"] as? NSManagedObjectID else { continue }
+                recordIDs[date] = recordIDs[date] ?? recordID
+            }
+        }
+        return recordIDs
+    }
+
+    private static func existingFoodKeys(on recordIDs: [NSManagedObjectID], in context: NSManagedObjectContext) throws -> Set<FoodKey> {
+        let fetchRequest = NSFetchRequest<NSDictionary>(entityName: "CoreDiaryEntry")
+        fetchRequest.resultType = .dictionaryResultType
+        let dayDate = NSExpressionDescription()
+        dayDate.name = "day"
+        dayDate.expression = NSExpression(forKeyPath: "dailyRecord.date")
+        dayDate.expressionResultType = .dateAttributeType
+        fetchRequest.propertiesToFetch = ["entryDescription", "calories", "timestamp", dayDate]
+        fetchRequest.predicate = NSPredicate(format: "type == %@ AND dailyRecord IN %@", "Food", recordIDs)
+        return Set(try context.loggedFetch(fetchRequest).compactMap { row -> FoodKey? in
+            guard let day = row["day"] as? Date else { return nil }
+            return FoodKey(
+                day: day,
+                name: row["entryDescription"] as? String ?? "",
+                calories: (row["calories"] as? NSNumber)?.int32Value ?? 0,
+                minute: (row["timestamp"] as? Date).map { minute(of: $0, on: day) }
+            )
+        })
+    }
+
+    private static func minute(of timestamp: Date, on day: Date) -> Int {
+        Int((timestamp.timeIntervalSince(day) / 60).rounded(.down))
+    }
+}
@@ -0,0 +1,132 @@
+//
+//  DayRollover.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Day Rollover
+// What happens when a new day starts: the birthday age bump, the previous day's weigh-in becoming
+// currentWeight, BMR and the calorie goal for the day. Shared by the Today screen and the
+// time-travel engine so both follow the same rules.
+enum DayRollover {
+    // Profile updates for a day that has just started; `previousWeighIn` is the prior day's average, if any
+    static func beginDay(_ day: Date, profile userProfile: UserProfile, previousWeighIn: Double?, calendar: Calendar) {
+        // Check if it's the user's birthday and update age
+        if let birthdate = userProfile.birthdate {
+            let todayComponents = calendar.dateComponents([.month, .day], from: day)
+            let birthComponents = calendar.dateComponents([.month, .day], from: birthdate)
+            if todayComponents.month == birthComponents.month && todayComponents.day == birthComponents.day {
+                let ageComponents = calendar.dateComponents([.year], from: birthdate, to: day)
+                let newAge = Int32(ageComponents.year ?? 0)
+                if newAge != userProfile.age {
+                    userProfile.age = newAge
+                    AppLog.debug("Updated user age to \(newAge) on birthday", category: .diary)
+                }
+            }
+        }
+
+        // Use previous day's weigh-in to set currentWeight for BMR calculation
+        if let previousWeighIn = previousWeighIn, previousWeighIn != userProfile.currentWeight {
+            userProfile.currentWeight = previousWeighIn
+            AppLog.debug("Set UserProfile.currentWeight to \(previousWeighIn) from previous day's weigh-in for new day", category: .diary)
+        }
+
+        // Recalculate BMR with updated weight and age
+        let newBMR = bmr(
+            weight: userProfile.currentWeight,
+            heightCm: userProfile.heightCm,
+            heightFt: userProfile.heightFt,
+            heightIn: userProfile.heightIn,
+            age: userProfile.age,
+            gender: userProfile.gender ?? "",
+            activityInt: userProfile.activityInt,
+            useMetric: userProfile.useMetric
+        )
+        if newBMR != userProfile.userBMR {
+            userProfile.userBMR = newBMR
+            AppLog.debug("Recalculated BMR to \(newBMR) for new day", category: .diary)
+        }
+
+        // Update weightDifference based on currentWeight and goalWeight
+        if userProfile.goalWeight > 0 {
+            userProfile.weightDifference = abs(userProfile.currentWeight - userProfile.goalWeight)
+        }
+
+        updateCalorieGoal(for: userProfile, on: day, calendar: calendar)
+    }
+
+    static func updateCalorieGoal(for userProfile: UserProfile, on day: Date, calendar: Calendar) {
+        let calorieFactor: Double = userProfile.useMetric ? 7000.0 : 3500.0
+        userProfile.dailyCalorieDif = Int32((calorieFactor * userProfile.weekGoal) / 7)
+
+        var newCalorieGoal: Int32 = userProfile.userBMR
+        switch userProfile.goalId {
+        case 1:
+            let absCalorieDif = abs(userProfile.dailyCalorieDif)
+            newCalorieGoal = userProfile.weekGoal < 0 ? userProfile.userBMR - absCalorieDif : userProfile.userBMR + absCalorieDif
+
+        case 2:
+            if userProfile.goalWeight > 0 {
+                let absCalorieDif = abs(userProfile.dailyCalorieDif)
+                newCalorieGoal = userProfile.weekGoal < 0 ? userProfile.userBMR - absCalorieDif : userProfile.userBMR + absCalorieDif
+            } else {
+                newCalorieGoal = userProfile.userBMR
+            }
+
+        case 3:
+            if let targetDate = userProfile.targetDate, userProfile.goalWeight > 0 {
+                let daysUntilTarget = calendar.dateComponents([.day], from: day, to: targetDate).day ?? 0
+                if daysUntilTarget > 0 {
+                    let totalCalorieAdjustment = (userProfile.weightDifference * calorieFactor) / Double(daysUntilTarget)
+                    newCalorieGoal = userProfile.weekGoal < 0 ? userProfile.userBMR - Int32(totalCalorieAdjustment) : userProfile.userBMR + Int32(totalCalorieAdjustment)
+                } else {
+                    newCalorieGoal = userProfile.userBMR
+                }
+            } else {
+                newCalorieGoal = userProfile.userBMR
+            }
+
+        case 4:
+            newCalorieGoal = userProfile.userBMR
+
+        case 5:
+            newCalorieGoal = userProfile.customCals
+
+        default:
+            newCalorieGoal = userProfile.userBMR
+        }
+
+        if newCalorieGoal != userProfile.dailyCalorieGoal {
+            userProfile.dailyCalorieGoal = newCalorieGoal
+            AppLog.debug("Updated UserProfile.dailyCalorieGoal to \(newCalorieGoal) for new day", category: .diary)
+        }
+    }
+
+    static func bmr(weight: Double, heightCm: Int32, heightFt: Int32, heightIn: Int32, age: Int32, gender: String, activityInt: Int32, useMetric: Bool) -> Int32 {
+        var bmr: Double = 0.0
+
+        let weightKg = useMetric ? weight : weight * 0.453592
+        let heightCmDouble: Double
+        if useMetric {
+            heightCmDouble = Double(heightCm)
+        } else {
+            heightCmDouble = Double(heightFt * 12 + heightIn) * 2.54
+        }
+
+        if gender.lowercased() == "man" {
+            bmr = 88.362 + (13.397 * weightKg) + (4.799 * heightCmDouble) - (5.677 * Double(age))
+        } else if gender.lowercased() == "woman" {
+            bmr = 447.593 + (9.247 * weightKg) + (3.098 * heightCmDouble) - (4.330 * Double(age))
+        } else {
+            bmr = (88.362 + (13.397 * weightKg) + (4.799 * heightCmDouble) - (5.677 * Double(age)) + 447.593 + (9.247 * weightKg) + (3.098 * heightCmDouble) - (4.330 * Double(age))) / 2
+        }
+
+        let activityMultipliers: [Double] = [1.2, 1.375, 1.55, 1.725, 1.9]
+        let activityIndex = min(max(Int(activityInt), 0), activityMultipliers.count - 1)
+        bmr *= activityMultipliers[activityIndex]
+
+        return Int32(bmr.rounded())
+    }
+}
@@ -0,0 +1,281 @@
+//
+//  DiaryCSV.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - CSV Writing
+enum CSV {
+    // RFC 4180 quoting: only fields with a delimiter, quote or line break are quoted
+    static func escape(_ field: String) -> String {
+        guard field.contains(where: { $0 == "," || $0 == "\"" || $0 == "\n" || $0 == "\r" }) else { return field }
+        return "\"" + field.replacingOccurrences(of: "\"", with: "\"\"") + "\""
+    }
+
+    static func line(_ fields: [String]) -> String {
+        fields.map(escape).joined(separator: ",") + "\n"
+    }
+}
+
+// MARK: - CSV Parser
+// Incremental RFC 4180 parser: feed it the file a chunk at a time and it hands back each complete row,
+// so a large export never has to be in memory at once. Handles quoted fields with embedded delimiters,
+// doubled quotes and line breaks, CRLF or LF line endings, a UTF-8 byte order mark and blank lines.
+struct CSVParser {
+    private static let quote = UInt8(ascii: "\"")
+    private static let comma = UInt8(ascii: ",")
+    private static let lineFeed = UInt8(ascii: "\n")
+    private static let carriageReturn = UInt8(ascii: "\r")
+    private static let byteOrderMark: [UInt8] = [0xEF, 0xBB, 0xBF]
+
+    private var field: [UInt8] = []
+    private var row: [String] = []
+    private var inQuotes = false
+    private var quoteInQuotes = false // A quote inside a quoted field: the closing one, or the first of a doubled pair
+    private var afterCarriageReturn = false
+    private var leadingBytes: [UInt8]? = [] // Held back until the byte order mark is ruled out
+
+    private(set) var rowCount = 0
+
+    init() {}
+
+    mutating func feed(_ data: Data, row emit: ([String]) throws -> Void) rethrows {
+        for byte in data {
+            if var leading = leadingBytes {
+                leading.append(byte)
+                if leading == Self.byteOrderMark {
+                    leadingBytes = nil
+                } else if Self.byteOrderMark.starts(with: leading) {
+                    leadingBytes = leading
+                } else {
+                    leadingBytes = nil
+                    for held in leading {
+                        try consume(held, emit)
+                    }
+                }
+                continue
+            }
+            try consume(byte, emit)
+        }
+    }
+
+    // The last row may have no line break after it
+    mutating func finish(row emit: ([String]) throws -> Void) rethrows {
+        if let leading = leadingBytes {
+            leadingBytes = nil
+            for held in leading where leading != Self.byteOrderMark {
+                try consume(held, emit)
+            }
+        }
+        inQuotes = false
+        quoteInQuotes = false
+        if !field.isEmpty || !row.isEmpty {
+            try endRow(emit)
+        }
+    }
+
+    private mutating func consume(_ byte: UInt8, _ emit: ([String]) throws -> Void) rethrows {
+        if inQuotes {
+            if quoteInQuotes {
+                quoteInQuotes = false
+                if byte == Self.quote {
+                    field.append(byte)
+                    return
+                }
+                inQuotes = false // That was the closing quote; the byte is handled as unquoted below
+            } else if byte == Self.quote {
+                quoteInQuotes = true
+                return
+            } else {
+                field.append(byte)
+                return
+            }
+        }
+
+        let wasCarriageReturn = afterCarriageReturn
+        afterCarriageReturn = false
+        switch byte {
+        case Self.quote where field.isEmpty:
+            inQuotes = true
+        case Self.comma:
+            endField()
+        case Self.carriageReturn:
+            afterCarriageReturn = true
+            try endRow(emit)
+        case Self.lineFeed:
+            if !wasCarriageReturn {
+                try endRow(emit)
+            }
+        default:
+            field.append(byte)
+        }
+    }
+
+    private mutating func endField() {
+        row.append(String(decoding: field, as: UTF8.self))
+        field.removeAll(keepingCapacity: true)
+    }
+
+    private mutating func endRow(_ emit: ([String]) throws -> Void) rethrows {
+        endField()
+        let completed = row
+        row.removeAll(keepingCapacity: true)
+        guard completed != [""] else { return } // Blank line
+        rowCount += 1
+        try emit(completed)
+    }
+}
+
+// MARK: - Diary Import Mapping
+// One food from an imported diary, on the calendar day it was eaten
+struct ImportedFood: Equatable {
+    let day: Date
+    let timestamp: Date?
+    let name: String
+    let calories: Double
+    let protein: Double
+    let carbs: Double
+    let fats: Double
+}
+
+// Maps a food-diary CSV onto ImportedFood by its header. Recognises this app's own CoreDiaryEntry export
+// and the usual third-party layouts (MyFitnessPal, Cronometer, Lose It!); any other file with a date,
+// a name and a calories column is read generically. Header matching ignores case and surrounding spaces.
+struct DiaryCSVMapping {
+    enum Source: String {
+        case calorieCounter = "Calorie Counter"
+        case myFitnessPal = "MyFitnessPal"
+        case cronometer = "Cronometer"
+        case loseIt = "Lose It!"
+        case generic = "CSV"
+    }
+
+    // Earlier synonyms win when a file has several
+    private static let dateHeaders = ["date", "day", "timestamp"]
+    private static let timeHeaders = ["time"]
+    private static let nameHeaders = ["food name", "entrydescription", "name", "description", "food", "meal"]
+    private static let caloriesHeaders = ["calories", "energy (kcal)", "calories (kcal)", "kcal", "energy"]
+    private static let proteinHeaders = ["protein (g)", "protein"]
+    private static let carbsHeaders = ["carbohydrates (g)", "carbs (g)", "net carbs (g)", "carbohydrates", "carbs"]
+    private static let fatsHeaders = ["fat (g)", "total fat (g)", "fat", "fats"]
+    private static let typeHeaders = ["type", "category"]
+    // Rows of these types are not food: exercise in Lose It!, water and workouts in this app's export
+    private static let skippedTypes: Set<String> = ["exercise", "workout", "water"]
+
+    let source: Source
+    private let date: Int
+    private let name: Int
+    private let calories: Int
+    private let time: Int?
+    private let protein: Int?
+    private let carbs: Int?
+    private let fats: Int?
+    private let type: Int?
+    private let calendar: Calendar
+    private let dayFormatters: [DateFormatter]
+    private let timeFormatters: [DateFormatter]
+    private let timestampFormatter = ISO8601DateFormatter()
+
+    // nil when the header has no date, name or calories column
+    init?(header: [String], calendar: Calendar = .current) {
+        let normalized = header.map { $0.trimmingCharacters(in: .whitespaces).lowercased() }
+        func column(_ synonyms: [String]) -> Int? {
+            synonyms.lazy.compactMap { normalized.firstIndex(of: $0) }.first
+        }
+        guard let date = column(Self.dateHeaders),
+              let name = column(Self.nameHeaders),
+              let calories = column(Self.caloriesHeaders) else {
+            return nil
+        }
+        self.date = date
+        self.name = name
+        self.calories = calories
+        time = column(Self.timeHeaders)
+        protein = column(Self.proteinHeaders)
+        carbs = column(Self.carbsHeaders)
+        fats = column(Self.fatsHeaders)
+        type = column(Self.typeHeaders)
+
+        let headers = Set(normalized)
+        if headers.contains("entrydescription") {
+            source = .calorieCounter
+        } else if headers.contains("food name") && headers.contains("energy (kcal)") {
+            source = .cronometer
+        } else if headers.contains("meal") && headers.contains("fat (g)") {
+            source = .myFitnessPal
+        } else if headers.contains("name") && headers.contains("type") && headers.contains("units") {
+            source = .loseIt
+        } else {
+            source = .generic
+        }
+
+        self.calendar = calendar
+        dayFormatters = ["yyyy-MM-dd", "MM/dd/yyyy", "M/d/yyyy", "M/d/yy", "yyyy/MM/dd"].map { Self.formatter($0, calendar: calendar) }
+        timeFormatters = ["HH:mm", "HH:mm:ss", "h:mm a", "h:mma"].map { Self.formatter($0, calendar: calendar) }
+    }
+
+    // nil for rows that aren't food or whose date or calories can't be read
+    func food(from fields: [String]) -> ImportedFood? {
+        if let type = type, type < fields.count,
+           Self.skippedTypes.contains(fields[type].trimmingCharacters(in: .whitespaces).lowercased()) {
+            return nil
+        }
+        guard date < fields.count, calories < fields.count,
+              let calorieCount = Self.number(fields[calories]), calorieCount >= 0 else {
+            return nil
+        }
+
+        let dateField = fields[date].trimmingCharacters(in: .whitespaces)
+        var timestamp: Date?
+        let day: Date
+        if let instant = timestampFormatter.date(from: dateField) {
+            timestamp = instant
+            day = calendar.startOfDay(for: instant)
+        } else if let parsed = dayFormatters.lazy.compactMap({ $0.date(from: dateField) }).first {
+            day = calendar.startOfDay(for: parsed)
+        } else {
+            return nil
+        }
+        if timestamp == nil, let time = time, time < fields.count {
+            let timeField = fields[time].trimmingCharacters(in: .whitespaces)
+            if let parsed = timeFormatters.lazy.compactMap({ $0.date(from: timeField) }).first {
+                let components = calendar.dateComponents([.hour, .minute, .second], from: parsed)
+                timestamp = calendar.date(bySettingHour: components.hour ?? 0, minute: components.minute ?? 0,
+                                          second: components.second ?? 0, of: day)
+            }
+        }
+
+        let foodName = name < fields.count ? fields[name].trimmingCharacters(in: .whitespacesAndNewlines) : ""
+        return ImportedFood(
+            day: day,
+            timestamp: timestamp,
+            name: foodName.isEmpty ? "Imported food" : foodName,
+            calories: calorieCount,
+            protein: value(protein, in: fields),
+            carbs: value(carbs, in: fields),
+            fats: value(fats, in: fields)
+        )
+    }
+
+    private func value(_ column: Int?, in fields: [String]) -> Double {
+        guard let column = column, column < fields.count else { return 0 }
+        return Self.number(fields[column]) ?? 0
+    }
+
+    // Tolerates thousands separators and units, e.g. "1,250" or "12.5 g"
+    private static func number(_ field: String) -> Double? {
+        let cleaned = field.filter { $0.isNumber || $0 == "." || $0 == "-" }
+        return cleaned.isEmpty ? nil : Double(cleaned)
+    }
+
+    private static func formatter(_ format: String, calendar: Calendar) -> DateFormatter {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.calendar = calendar
+        formatter.timeZone = calendar.timeZone
+        formatter.dateFormat = format
+        formatter.isLenient = false
+        return formatter
+    }
+}
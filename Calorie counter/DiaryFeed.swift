@@ -0,0 +1,198 @@
+//
+//  DiaryFeed.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+import Combine
+
+// MARK: - Diary Feed Change
+// Indices follow fetched-results batch rules: deletes and move sources refer to the old list,
+// inserts and move destinations to the new one
+enum DiaryFeedChange: Equatable {
+    case insert(DiaryEntry, at: Int)
+    case update(DiaryEntry, at: Int)
+    case delete(id: UUID, at: Int)
+    case move(DiaryEntry, from: Int, to: Int)
+}
+
+// MARK: - Diary Feed
+// The selected day's diary entries, kept by a fetched-results controller on the view context.
+// Saves produce per-row diffs keyed by the stable entry id instead of a rebuilt list.
+// The fetch leaves out imageData; rows that have an image are marked imageDeferred and the row
+// loads it through DataRepository.entryImage(id:) when it is drawn.
+final class DiaryFeed: NSObject, ObservableObject {
+    static let shared = DiaryFeed(context: PersistenceController.shared.context)
+
+    @Published private(set) var entries: [DiaryEntry] = [] // Sorted by timestamp
+    let changes = PassthroughSubject<[DiaryFeedChange], Never>()
+    private(set) var day: Date?
+
+    private let context: NSManagedObjectContext
+    private let calendar: Calendar
+    private var controller: NSFetchedResultsController<CoreDiaryEntry>?
+    private var pendingChanges: [DiaryFeedChange] = []
+    private var imagedIDs: Set<UUID> = [] // Rows of the shown day whose image was left out of the fetch
+
+    init(context: NSManagedObjectContext, clock: AppClock = .shared) {
+        self.context = context
+        self.calendar = clock.calendar
+        super.init()
+    }
+
+    // Switching days replaces the list outright; staying on the same day is a no-op
+    func show(day date: Date) {
+        let day = calendar.startOfDay(for: date)
+        guard day != self.day else { return }
+        self.day = day
+
+        let fetchRequest: NSFetchRequest<CoreDiaryEntry> = CoreDiaryEntry.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "dailyRecord.date == %@", day as NSDate)
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "timestamp", ascending: true)]
+        fetchRequest.fetchBatchSize = 32
+        fetchRequest.propertiesToFetch = DiaryEntry.properties
+
+        let controller = NSFetchedResultsController(fetchRequest: fetchRequest, managedObjectContext: context, sectionNameKeyPath: nil, cacheName: nil)
+        controller.delegate = self
+        self.controller = controller
+        do {
+            try AppLog.interval("Fetch diary", category: .diary, counter: .fetches) {
+                try controller.performFetch()
+                imagedIDs = try imagedEntryIDs(on: day)
+            }
+            entries = (controller.fetchedObjects ?? []).map { entry($0, on: day) }
+        } catch {
+            AppLog.error("Failed to load diary for \(day): \(error.localizedDescription)", category: .diary)
+            imagedIDs = []
+            entries = []
+        }
+    }
+
+    // The ids alone, as a dictionary fetch, so finding out which rows have an image reads no image bytes
+    private func imagedEntryIDs(on day: Date) throws -> Set<UUID> {
+        let fetchRequest = NSFetchRequest<NSDictionary>(entityName: "CoreDiaryEntry")
+        fetchRequest.resultType = .dictionaryResultType
+        fetchRequest.propertiesToFetch = ["id"]
+        fetchRequest.includesPendingChanges = false // Not supported for dictionary results; the day is read as saved
+        fetchRequest.predicate = NSPredicate(format: "dailyRecord.date == %@ AND imageData != nil", day as NSDate)
+        return Set(try context.loggedFetch(fetchRequest).compactMap { $0["id"] as? UUID })
+    }
+
+    // Rows from the first fetch keep their image deferred; rows added afterwards are read in full,
+    // they were just saved and their image is already in memory
+    private func entry(_ entity: CoreDiaryEntry, on day: Date) -> DiaryEntry {
+        DiaryEntry(entity, on: day, imageDeferred: entity.id.map(imagedIDs.contains) ?? false)
+    }
+
+    // Refetches the day being shown, for when the store under the context was replaced (a backup restore)
+    func reload() {
+        guard let day = day else { return }
+        self.day = nil
+        show(day: day)
+    }
+}
+
+// MARK: - Fetched Results Delegate
+extension DiaryFeed: NSFetchedResultsControllerDelegate {
+    func controllerWillChangeContent(_ controller: NSFetchedResultsController<NSFetchRequestResult>) {
+        pendingChanges = []
+    }
+
+    func controller(_ controller: NSFetchedResultsController<NSFetchRequestResult>, didChange anObject: Any, at indexPath: IndexPath?, for type: NSFetchedResultsChangeType, newIndexPath: IndexPath?) {
+        guard let day = day else { return }
+        switch type {
+        case .insert:
+            guard let entity = anObject as? CoreDiaryEntry, let newIndex = newIndexPath?.item else { return }
+            pendingChanges.append(.insert(entry(entity, on: day), at: newIndex))
+        case .update:
+            guard let entity = anObject as? CoreDiaryEntry, let oldIndex = indexPath?.item else { return }
+            pendingChanges.append(.update(entry(entity, on: day), at: oldIndex))
+        case .delete:
+            // A deleted object's values may already be gone, the id comes from the current list
+            guard let oldIndex = indexPath?.item, entries.indices.contains(oldIndex) else { return }
+            pendingChanges.append(.delete(id: entries[oldIndex].id, at: oldIndex))
+        case .move:
+            guard let entity = anObject as? CoreDiaryEntry, let oldIndex = indexPath?.item, let newIndex = newIndexPath?.item else { return }
+            pendingChanges.append(.move(entry(entity, on: day), from: oldIndex, to: newIndex))
+        @unknown default:
+            break
+        }
+    }
+
+    func controllerDidChangeContent(_ controller: NSFetchedResultsController<NSFetchRequestResult>) {
+        let batch = pendingChanges.filter { change in
+            // Re-saving unchanged values still reports an update; drop those
+            if case let .update(entry, at: index) = change {
+                return !entries.indices.contains(index) || entries[index] != entry
+            }
+            return true
+        }
+        pendingChanges = []
+        guard !batch.isEmpty else { return }
+        entries.apply(batch)
+        changes.send(batch)
+    }
+}
+
+// MARK: - Applying Changes
+extension Array where Element == DiaryEntry {
+    // Plain sum of the canonical amounts, no string parsing
+    var totalWaterMilliliters: Double {
+        reduce(0) { $0 + ($1.type == "Water" ? $1.waterAmountMl : 0) }
+    }
+
+    // Applies a fetched-results batch by index; `self` must be the list the batch was computed against
+    mutating func apply(_ batch: [DiaryFeedChange]) {
+        var removals: [Int] = []
+        var insertions: [(index: Int, entry: DiaryEntry)] = []
+        var updates: [DiaryEntry] = []
+        for change in batch {
+            switch change {
+            case let .insert(entry, at: index):
+                insertions.append((index, entry))
+            case let .update(entry, at: _):
+                updates.append(entry)
+            case let .delete(id: _, at: index):
+                removals.append(index)
+            case let .move(entry, from: oldIndex, to: newIndex):
+                removals.append(oldIndex)
+                insertions.append((newIndex, entry))
+            }
+        }
+        for index in removals.sorted(by: >) where indices.contains(index) {
+            remove(at: index)
+        }
+        for insertion in insertions.sorted(by: { $0.index < $1.index }) {
+            insert(insertion.entry, at: Swift.min(insertion.index, count))
+        }
+        for entry in updates {
+            if let index = firstIndex(where: { $0.id == entry.id }) {
+                self[index] = entry
+            }
+        }
+    }
+
+    // Merges a batch into a list that may hold local, not yet saved entries; matches rows by id
+    mutating func merge(_ batch: [DiaryFeedChange]) {
+        for change in batch {
+            switch change {
+            case let .insert(entry, at: _), let .update(entry, at: _), let .move(entry, from: _, to: _):
+                upsert(entry)
+            case let .delete(id: id, at: _):
+                removeAll { $0.id == id }
+            }
+        }
+    }
+
+    // Replaces the row with the same id, or inserts in timestamp order
+    mutating func upsert(_ entry: DiaryEntry) {
+        if let index = firstIndex(where: { $0.id == entry.id }) {
+            if self[index] != entry {
+                self[index] = entry
+            }
+        } else {
+            insert(entry, at: firstIndex(where: { $0.timestamp > entry.timestamp }) ?? count)
+        }
+    }
+}
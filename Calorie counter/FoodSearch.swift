@@ -0,0 +1,38 @@
+//
+//  FoodSearch.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Food Search
+// Request building and response parsing for the Open Food Facts text search.
+// Foundation only; the network call itself stays in AddFoodView.
+struct FoodSearchResult: Equatable {
+    let name: String
+    let barcode: String
+}
+
+enum FoodSearch {
+    // V1 search endpoint, it has better full-text search support than V2
+    static func url(for query: String, pageSize: Int = 5) -> URL? {
+        guard let encodedQuery = query.addingPercentEncoding(withAllowedCharacters: .urlQueryAllowed) else { return nil }
+        return URL(string: "https://world.openfoodfacts.org/cgi/search.pl?search_terms=\(encodedQuery)&search_simple=1&action=process&json=1&page_size=\(pageSize)")
+    }
+
+    // nil when the body has no products array; products without a name or barcode are dropped
+    static func results(from data: Data) throws -> [FoodSearchResult]? {
+        guard let json = try JSONSerialization.jsonObject(with: data, options: []) as? [String: Any],
+              let products = json["products"] as? [[String: Any]] else {
+            return nil
+        }
+        return products.compactMap { product in
+            guard let name = product["product_name"] as? String,
+                  let barcode = product["code"] as? String,
+                  !name.isEmpty, !barcode.isEmpty else {
+                return nil
+            }
+            return FoodSearchResult(name: name, barcode: barcode)
+        }
+    }
+}
@@ -0,0 +1,223 @@
+//
+//  GIFEncoder.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - GIF Encoder
+// Streaming GIF89a writer. Each frame is quantized, LZW-compressed and handed to `sink` before the
+// next one is accepted, so memory is bounded by a single frame however long the animation runs.
+// Foundation only, so it builds and benchmarks headless.
+struct GIFEncoder {
+    let width: Int
+    let height: Int
+    private let sink: (Data) throws -> Void
+    private(set) var frameCount = 0
+    private var isFinished = false
+
+    // `loopCount` 0 repeats forever
+    init(width: Int, height: Int, loopCount: Int = 0, sink: @escaping (Data) throws -> Void) throws {
+        precondition(width > 0 && width <= 0xFFFF && height > 0 && height <= 0xFFFF, "GIF dimensions out of range")
+        self.width = width
+        self.height = height
+        self.sink = sink
+
+        var header = Data("GIF89a".utf8)
+        header.appendLittleEndian(UInt16(width))
+        header.appendLittleEndian(UInt16(height))
+        header.append(0xF7) // Global color table of 256 entries, 8 bits per primary
+        header.append(0) // Background color index
+        header.append(0) // Square pixels
+        header.append(GIFPalette.colorTable)
+        // Application extension that makes browsers and Photos loop the animation
+        header.append(contentsOf: [0x21, 0xFF, 0x0B])
+        header.append(Data("NETSCAPE2.0".utf8))
+        header.append(contentsOf: [0x03, 0x01])
+        header.appendLittleEndian(UInt16(clamping: loopCount))
+        header.append(0)
+        try sink(header)
+    }
+
+    // `delay` is in hundredths of a second. Frames are treated as opaque.
+    mutating func addFrame(_ frame: PixelBuffer, delay: Int) throws {
+        precondition(!isFinished, "Frame added after finish()")
+        precondition(frame.width == width && frame.height == height, "Frame size doesn't match the animation")
+        var data = Data()
+        data.reserveCapacity(width * height / 2)
+
+        // Graphic control extension: leave the frame in place, no transparency
+        data.append(contentsOf: [0x21, 0xF9, 0x04, 0x04])
+        data.appendLittleEndian(UInt16(clamping: max(delay, 0)))
+        data.append(0) // Transparent color index (unused)
+        data.append(0)
+
+        // Image descriptor covering the whole canvas, using the global color table
+        data.append(0x2C)
+        data.appendLittleEndian(UInt16(0))
+        data.appendLittleEndian(UInt16(0))
+        data.appendLittleEndian(UInt16(width))
+        data.appendLittleEndian(UInt16(height))
+        data.append(0)
+
+        GIFLZW.compress(GIFPalette.indices(for: frame), minimumCodeSize: 8, into: &data)
+        try sink(data)
+        frameCount += 1
+    }
+
+    mutating func finish() throws {
+        guard !isFinished else { return }
+        isFinished = true
+        try sink(Data([0x3B])) // Trailer
+    }
+}
+
+// MARK: - Palette
+// A fixed 6x7x6 color cube (green gets the extra level, as the eye is most sensitive to it) with a
+// 4x4 ordered dither. Fixed so frames need no analysis pass and every frame shares one table.
+enum GIFPalette {
+    static let levels = (red: 6, green: 7, blue: 6)
+
+    static let colorTable: Data = {
+        var table = Data(count: 256 * 3) // Unused tail entries stay black
+        var index = 0
+        for red in 0..<levels.red {
+            for green in 0..<levels.green {
+                for blue in 0..<levels.blue {
+                    table[index * 3] = UInt8(red * 255 / (levels.red - 1))
+                    table[index * 3 + 1] = UInt8(green * 255 / (levels.green - 1))
+                    table[index * 3 + 2] = UInt8(blue * 255 / (levels.blue - 1))
+                    index += 1
+                }
+            }
+        }
+        return table
+    }()
+
+    private static let bayer: [Int] = [
+        0, 8, 2, 10,
+        12, 4, 14, 6,
+        3, 11, 1, 9,
+        15, 7, 13, 5
+    ]
+
+    static func indices(for frame: PixelBuffer) -> [UInt8] {
+        var indices = [UInt8](repeating: 0, count: frame.width * frame.height)
+        let width = frame.width
+        frame.bytes.withUnsafeBufferPointer { bytes in
+            indices.withUnsafeMutableBufferPointer { indices in
+                for y in 0..<frame.height {
+                    for x in 0..<width {
+                        let pixel = y * width + x
+                        // Threshold strictly inside (0, 1) in units of 1/4080
+                        let threshold = bayer[(y & 3) * 4 + (x & 3)] * 255 + 128
+                        let red = quantize(bytes[pixel * 4], levels: levels.red, threshold: threshold)
+                        let green = quantize(bytes[pixel * 4 + 1], levels: levels.green, threshold: threshold)
+                        let blue = quantize(bytes[pixel * 4 + 2], levels: levels.blue, threshold: threshold)
+                        indices[pixel] = UInt8((red * levels.green + green) * levels.blue + blue)
+                    }
+                }
+            }
+        }
+        return indices
+    }
+
+    @inline(__always)
+    private static func quantize(_ value: UInt8, levels: Int, threshold: Int) -> Int {
+        min((Int(value) * (levels - 1) * 16 + threshold) / 4080, levels - 1)
+    }
+}
+
+// MARK: - LZW
+// Variable-width codes up to 12 bits, packed LSB first into 255-byte sub-blocks. The table is
+// cleared once code 4095 is assigned.
+enum GIFLZW {
+    private static let maxCode = 4095
+
+    static func compress(_ indices: [UInt8], minimumCodeSize: Int, into output: inout Data) {
+        output.append(UInt8(minimumCodeSize))
+        let clearCode = 1 << minimumCodeSize
+        let endCode = clearCode + 1
+        var writer = SubBlockWriter()
+        var codeSize = minimumCodeSize + 1
+        var lastCode = endCode
+        var table = [Int: Int](minimumCapacity: maxCode + 1) // (prefix << 8 | index) -> code
+
+        writer.write(clearCode, bits: codeSize, into: &output)
+        guard var prefix = indices.first.map(Int.init) else {
+            writer.write(endCode, bits: codeSize, into: &output)
+            writer.finish(into: &output)
+            return
+        }
+        for index in indices.dropFirst() {
+            let key = prefix << 8 | Int(index)
+            if let code = table[key] {
+                prefix = code
+                continue
+            }
+            writer.write(prefix, bits: codeSize, into: &output)
+            lastCode += 1
+            table[key] = lastCode
+            if lastCode >= 1 << codeSize {
+                codeSize += 1
+            }
+            if lastCode == maxCode {
+                writer.write(clearCode, bits: codeSize, into: &output)
+                table.removeAll(keepingCapacity: true)
+                codeSize = minimumCodeSize + 1
+                lastCode = endCode
+            }
+            prefix = Int(index)
+        }
+        writer.write(prefix, bits: codeSize, into: &output)
+        writer.write(endCode, bits: codeSize, into: &output)
+        writer.finish(into: &output)
+    }
+
+    private struct SubBlockWriter {
+        private var block = [UInt8]()
+        private var bitBuffer = 0
+        private var bitCount = 0
+
+        mutating func write(_ code: Int, bits: Int, into output: inout Data) {
+            bitBuffer |= code << bitCount
+            bitCount += bits
+            while bitCount >= 8 {
+                append(UInt8(bitBuffer & 0xFF), into: &output)
+                bitBuffer >>= 8
+                bitCount -= 8
+            }
+        }
+
+        // Flushes the partial byte and block, then the zero-length terminator
+        mutating func finish(into output: inout Data) {
+            if bitCount > 0 {
+                append(UInt8(bitBuffer & 0xFF), into: &output)
+                bitBuffer = 0
+                bitCount = 0
+            }
+            flush(into: &output)
+            output.append(0)
+        }
+
+        private mutating func append(_ byte: UInt8, into output: inout Data) {
+            block.append(byte)
+            if block.count == 255 {
+                flush(into: &output)
+            }
+        }
+
+        private mutating func flush(into output: inout Data) {
+            guard !block.isEmpty else { return }
+            output.append(UInt8(block.count))
+            output.append(contentsOf: block)
+            block.removeAll(keepingCapacity: true)
+        }
+    }
+}
+
+extension Data {
+    mutating func appendLittleEndian<T: FixedWidthInteger>(_ value: T) {
+        Swift.withUnsafeBytes(of: value.littleEndian) { append(contentsOf: $0) }
+    }
+}
@@ -0,0 +1,462 @@
+//
+//  HistoryArchive.swift
+//  Calorie counter
+//
+
+import Foundation
+
+#if _endian(big)
+#error("HistoryArchive reads its little-endian columns in place and needs a little-endian host")
+#endif
+
+// MARK: - Archived Day
+// A closed day as the archive keeps it: DaySummary's columns, the totals long-range stats need, and the entries
+struct ArchivedDay: Equatable {
+    var date: Date // Start of day
+    var calorieIntake: Double = 0
+    var calorieGoal: Double = 0
+    var passed = false
+    var weighIn: Double = 0
+    var waterIntake: Double = 0
+    var waterGoal: Double = 0
+    var waterUnit: String? = nil
+    var protein: Double = 0
+    var carbs: Double = 0
+    var fats: Double = 0
+    var workoutMinutes: Double = 0
+    var entries: [ArchivedEntry] = []
+}
+
+struct ArchivedEntry: Equatable {
+    enum Kind: UInt8 {
+        case food = 1, water, workout, weighIn
+    }
+
+    var kind: Kind
+    var timestamp: Date
+    var name: String = ""
+    var calories: Double = 0
+    var protein: Double = 0
+    var carbs: Double = 0
+    var fats: Double = 0
+    var amount: Double = 0 // Water millilitres, workout minutes or the weigh-in weight
+}
+
+// MARK: - Columns
+// One file per column holding `width` little-endian bytes per day. The case order is part of the format.
+enum HistoryColumn: String, CaseIterable {
+    case date // Float64 seconds since the reference date
+    case calorieIntake
+    case calorieGoal
+    case passed // UInt8
+    case weighIn
+    case waterIntake
+    case waterGoal
+    case protein
+    case carbs
+    case fats
+    case workoutMinutes
+    case blobEnd // UInt64 end offset of the day's record in the blobs file
+
+    var width: Int {
+        self == .passed ? 1 : 8
+    }
+
+    var fileName: String { "\(rawValue).col" }
+}
+
+enum HistoryArchiveError: LocalizedError, Equatable {
+    case notAnArchive
+    case unsupportedVersion(UInt16)
+    case checksumMismatch(String)
+    case truncated(String)
+    case outOfOrder(Date)
+
+    var errorDescription: String? {
+        switch self {
+        case .notAnArchive: return "The history archive manifest is not recognised"
+        case .unsupportedVersion(let version): return "History archive version \(version) is not supported"
+        case .checksumMismatch(let file): return "The history archive's \(file) failed its checksum"
+        case .truncated(let file): return "The history archive's \(file) is shorter than its manifest says"
+        case .outOfOrder(let date): return "Archived days must be newer than the last one; got \(date)"
+        }
+    }
+}
+
+// MARK: - History Archive
+// Append-only columnar store for closed days, kept beside the Core Data store. Each fixed-width column is
+// its own file, so a whole-history scan of one value is a single contiguous, memory-mapped array. Each
+// day's variable-width part (water unit and entries) goes into one blobs file, delimited by the blobEnd
+// column. A small manifest records the format version, the committed day count and blobs length, and a
+// running CRC-32 of every file; it is replaced atomically after the files are extended and synced.
+//
+// A value of this type is an immutable snapshot: appending returns a new one, and bytes a snapshot can
+// see are never rewritten.
+struct HistoryArchive {
+    static let formatVersion: UInt16 = 1
+    static let manifestName = "manifest"
+    static let blobsName = "blobs.dat"
+
+    let directory: URL
+    let dayCount: Int
+    private let columns: [HistoryColumn: Data]
+    private let blobs: Data
+    private let checksums: [UInt32] // Each column in case order, then the blobs
+
+    var isEmpty: Bool { dayCount == 0 }
+    var firstDate: Date? { isEmpty ? nil : date(at: 0) }
+    var lastDate: Date? { isEmpty ? nil : date(at: dayCount - 1) }
+
+    private init(directory: URL, manifest: Manifest, columns: [HistoryColumn: Data], blobs: Data) {
+        self.directory = directory
+        self.dayCount = manifest.dayCount
+        self.columns = columns
+        self.blobs = blobs
+        self.checksums = manifest.checksums
+    }
+
+    // Maps the committed part of every file. A directory without a manifest opens as an empty archive.
+    // `verify` checks each file against its checksum, which reads it all once.
+    static func open(at directory: URL, verify: Bool = true) throws -> HistoryArchive {
+        let manifestURL = directory.appendingPathComponent(manifestName)
+        guard FileManager.default.fileExists(atPath: manifestURL.path) else {
+            return HistoryArchive(directory: directory, manifest: Manifest(), columns: [:], blobs: Data())
+        }
+        let manifest = try Manifest(Data(contentsOf: manifestURL))
+
+        var columns: [HistoryColumn: Data] = [:]
+        for column in HistoryColumn.allCases {
+            columns[column] = try mapped(directory.appendingPathComponent(column.fileName), length: manifest.dayCount * column.width, name: column.rawValue)
+        }
+        let blobs = try mapped(directory.appendingPathComponent(blobsName), length: manifest.blobsLength, name: blobsName)
+
+        if verify {
+            for (index, column) in HistoryColumn.allCases.enumerated() where CRC32.checksum(columns[column]!) != manifest.checksums[index] {
+                throw HistoryArchiveError.checksumMismatch(column.rawValue)
+            }
+            if CRC32.checksum(blobs) != manifest.checksums[HistoryColumn.allCases.count] {
+                throw HistoryArchiveError.checksumMismatch(blobsName)
+            }
+        }
+        return HistoryArchive(directory: directory, manifest: manifest, columns: columns, blobs: blobs)
+    }
+
+    // Files can run past the manifest after an interrupted append; only the committed prefix is used
+    private static func mapped(_ url: URL, length: Int, name: String) throws -> Data {
+        guard length > 0 else { return Data() }
+        let data = try Data(contentsOf: url, options: .alwaysMapped)
+        guard data.count >= length else { throw HistoryArchiveError.truncated(name) }
+        return data.prefix(length)
+    }
+
+    // MARK: Reading
+    // A Float64 column read in place; `date` holds seconds since the reference date
+    func withValues<R>(_ column: HistoryColumn, _ body: (UnsafeBufferPointer<Double>) throws -> R) rethrows -> R {
+        precondition(column.width == 8 && column != .blobEnd, "\(column.rawValue) is not a Float64 column")
+        guard let data = columns[column] else { return try body(UnsafeBufferPointer(start: nil, count: 0)) }
+        return try data.withUnsafeBytes { try body($0.bindMemory(to: Double.self)) }
+    }
+
+    func withFlags<R>(_ column: HistoryColumn, _ body: (UnsafeBufferPointer<UInt8>) throws -> R) rethrows -> R {
+        precondition(column.width == 1, "\(column.rawValue) is not a UInt8 column")
+        guard let data = columns[column] else { return try body(UnsafeBufferPointer(start: nil, count: 0)) }
+        return try data.withUnsafeBytes { try body($0.bindMemory(to: UInt8.self)) }
+    }
+
+    func date(at index: Int) -> Date {
+        Date(timeIntervalSinceReferenceDate: value(.date, at: index))
+    }
+
+    func value(_ column: HistoryColumn, at index: Int) -> Double {
+        withValues(column) { $0[index] }
+    }
+
+    func passed(at index: Int) -> Bool {
+        withFlags(.passed) { $0[index] != 0 }
+    }
+
+    // Indices of the archived days in [start, end)
+    func indices(from start: Date, to end: Date) -> Range<Int> {
+        withValues(.date) { dates in
+            let lower = Self.firstIndex(notBefore: start.timeIntervalSinceReferenceDate, in: dates)
+            let upper = Self.firstIndex(notBefore: end.timeIntervalSinceReferenceDate, in: dates)
+            return lower..<max(lower, upper)
+        }
+    }
+
+    private static func firstIndex(notBefore value: Double, in dates: UnsafeBufferPointer<Double>) -> Int {
+        var low = 0
+        var high = dates.count
+        while low < high {
+            let middle = (low + high) / 2
+            if dates[middle] < value {
+                low = middle + 1
+            } else {
+                high = middle
+            }
+        }
+        return low
+    }
+
+    // The whole day, entries included
+    func day(at index: Int) throws -> ArchivedDay {
+        var day = ArchivedDay(
+            date: date(at: index),
+            calorieIntake: value(.calorieIntake, at: index),
+            calorieGoal: value(.calorieGoal, at: index),
+            passed: passed(at: index),
+            weighIn: value(.weighIn, at: index),
+            waterIntake: value(.waterIntake, at: index),
+            waterGoal: value(.waterGoal, at: index),
+            protein: value(.protein, at: index),
+            carbs: value(.carbs, at: index),
+            fats: value(.fats, at: index),
+            workoutMinutes: value(.workoutMinutes, at: index)
+        )
+        var reader = ByteReader(blobs[blobRange(at: index)], name: Self.blobsName)
+        day.waterUnit = try Self.readWaterUnit(&reader)
+        let entryCount = try reader.read(UInt32.self)
+        day.entries.reserveCapacity(Int(entryCount))
+        for _ in 0..<entryCount {
+            guard let kind = ArchivedEntry.Kind(rawValue: try reader.read(UInt8.self)) else {
+                throw HistoryArchiveError.checksumMismatch(Self.blobsName)
+            }
+            var entry = ArchivedEntry(kind: kind, timestamp: Date(timeIntervalSinceReferenceDate: try reader.double()))
+            entry.calories = try reader.double()
+            entry.protein = try reader.double()
+            entry.carbs = try reader.double()
+            entry.fats = try reader.double()
+            entry.amount = try reader.double()
+            let nameLength = try reader.read(UInt16.self)
+            entry.name = try reader.string(length: Int(nameLength))
+            day.entries.append(entry)
+        }
+        return day
+    }
+
+    // Only the start of the day's blob, without decoding the entries
+    func waterUnit(at index: Int) throws -> String? {
+        var reader = ByteReader(blobs[blobRange(at: index)], name: Self.blobsName)
+        return try Self.readWaterUnit(&reader)
+    }
+
+    private static func readWaterUnit(_ reader: inout ByteReader) throws -> String? {
+        let length = try reader.read(UInt8.self)
+        let unit = try reader.string(length: Int(length))
+        return unit.isEmpty ? nil : unit
+    }
+
+    private func blobRange(at index: Int) -> Range<Int> {
+        let ends = columns[.blobEnd] ?? Data()
+        let end = ends.withUnsafeBytes { Int($0.loadUnaligned(fromByteOffset: index * 8, as: UInt64.self)) }
+        let start = index == 0 ? 0 : ends.withUnsafeBytes { Int($0.loadUnaligned(fromByteOffset: (index - 1) * 8, as: UInt64.self)) }
+        return (blobs.startIndex + start)..<(blobs.startIndex + end)
+    }
+
+    // MARK: Appending
+    // Adds days newer than `lastDate`, oldest first, and returns the archive including them. The files are
+    // extended and synced before the manifest is replaced, so an interrupted append leaves this snapshot's
+    // archive intact; the uncommitted tails are cut off by the next append.
+    func appending(_ days: [ArchivedDay]) throws -> HistoryArchive {
+        guard !days.isEmpty else { return self }
+        var previous = lastDate
+        for day in days {
+            if let previous = previous, day.date <= previous {
+                throw HistoryArchiveError.outOfOrder(day.date)
+            }
+            previous = day.date
+        }
+        try FileManager.default.createDirectory(at: directory, withIntermediateDirectories: true)
+
+        // Blobs first; their end offsets fill the blobEnd column
+        var newBlobs = Data()
+        var blobEnds: [UInt64] = []
+        blobEnds.reserveCapacity(days.count)
+        for day in days {
+            Self.encodeBlob(day, into: &newBlobs)
+            blobEnds.append(UInt64(blobs.count + newBlobs.count))
+        }
+
+        var checksums = self.checksums
+        for (index, column) in HistoryColumn.allCases.enumerated() {
+            var data = Data(capacity: days.count * column.width)
+            for (row, day) in days.enumerated() {
+                switch column {
+                case .date: data.appendLittleEndian(day.date.timeIntervalSinceReferenceDate.bitPattern)
+                case .passed: data.append(day.passed ? 1 : 0)
+                case .blobEnd: data.appendLittleEndian(blobEnds[row])
+                default: data.appendLittleEndian(day.value(column).bitPattern)
+                }
+            }
+            try Self.write(data, to: directory.appendingPathComponent(column.fileName), at: dayCount * column.width)
+            checksums[index] = CRC32.update(checksums[index], with: data)
+        }
+        try Self.write(newBlobs, to: directory.appendingPathComponent(Self.blobsName), at: blobs.count)
+        checksums[HistoryColumn.allCases.count] = CRC32.update(checksums[HistoryColumn.allCases.count], with: newBlobs)
+
+        let manifest = Manifest(dayCount: dayCount + days.count, blobsLength: blobs.count + newBlobs.count, checksums: checksums)
+        try manifest.data.write(to: directory.appendingPathComponent(Self.manifestName), options: .atomic)
+        return try HistoryArchive.open(at: directory, verify: false)
+    }
+
+    private static func write(_ data: Data, to url: URL, at offset: Int) throws {
+        if !FileManager.default.fileExists(atPath: url.path) {
+            FileManager.default.createFile(atPath: url.path, contents: nil)
+        }
+        let handle = try FileHandle(forWritingTo: url)
+        defer { try? handle.close() }
+        try handle.truncate(atOffset: UInt64(offset))
+        try handle.write(contentsOf: data)
+        try handle.synchronize()
+    }
+
+    private static let maxNameBytes = 1024
+
+    // Water unit, entry count, then each entry: kind, timestamp, calories, macros, amount and name
+    private static func encodeBlob(_ day: ArchivedDay, into data: inout Data) {
+        let unit = Array((day.waterUnit ?? "").utf8.prefix(Int(UInt8.max)))
+        data.append(UInt8(unit.count))
+        data.append(contentsOf: unit)
+        data.appendLittleEndian(UInt32(day.entries.count))
+        for entry in day.entries {
+            data.append(entry.kind.rawValue)
+            for value in [entry.timestamp.timeIntervalSinceReferenceDate, entry.calories, entry.protein, entry.carbs, entry.fats, entry.amount] {
+                data.appendLittleEndian(value.bitPattern)
+            }
+            let name = Array(entry.name.utf8.prefix(maxNameBytes))
+            data.appendLittleEndian(UInt16(name.count))
+            data.append(contentsOf: name)
+        }
+    }
+}
+
+private extension ArchivedDay {
+    func value(_ column: HistoryColumn) -> Double {
+        switch column {
+        case .calorieIntake: return calorieIntake
+        case .calorieGoal: return calorieGoal
+        case .weighIn: return weighIn
+        case .waterIntake: return waterIntake
+        case .waterGoal: return waterGoal
+        case .protein: return protein
+        case .carbs: return carbs
+        case .fats: return fats
+        case .workoutMinutes: return workoutMinutes
+        case .date, .passed, .blobEnd: preconditionFailure("\(column.rawValue) is not a stored total")
+        }
+    }
+}
+
+// MARK: - Manifest
+// "CCHA", UInt16 version, UInt16 column count, UInt32 day count, UInt64 blobs length, a UInt32 CRC-32 per
+// column and for the blobs, then a CRC-32 of everything before it
+private struct Manifest {
+    static let magic = Array("CCHA".utf8)
+
+    var dayCount = 0
+    var blobsLength = 0
+    var checksums = [UInt32](repeating: 0, count: HistoryColumn.allCases.count + 1)
+
+    init() {}
+
+    init(dayCount: Int, blobsLength: Int, checksums: [UInt32]) {
+        self.dayCount = dayCount
+        self.blobsLength = blobsLength
+        self.checksums = checksums
+    }
+
+    init(_ data: Data) throws {
+        var reader = ByteReader(data, name: HistoryArchive.manifestName)
+        guard try reader.bytes(Self.magic.count) == Self.magic else { throw HistoryArchiveError.notAnArchive }
+        let version = try reader.read(UInt16.self)
+        guard version == HistoryArchive.formatVersion else { throw HistoryArchiveError.unsupportedVersion(version) }
+        guard try reader.read(UInt16.self) == HistoryColumn.allCases.count else { throw HistoryArchiveError.notAnArchive }
+        dayCount = Int(try reader.read(UInt32.self))
+        blobsLength = Int(try reader.read(UInt64.self))
+        checksums = try (0...HistoryColumn.allCases.count).map { _ in try reader.read(UInt32.self) }
+        let bodyLength = reader.offset
+        guard try reader.read(UInt32.self) == CRC32.checksum(data.prefix(bodyLength)) else {
+            throw HistoryArchiveError.checksumMismatch(HistoryArchive.manifestName)
+        }
+    }
+
+    var data: Data {
+        var data = Data(Self.magic)
+        data.appendLittleEndian(HistoryArchive.formatVersion)
+        data.appendLittleEndian(UInt16(HistoryColumn.allCases.count))
+        data.appendLittleEndian(UInt32(dayCount))
+        data.appendLittleEndian(UInt64(blobsLength))
+        for checksum in checksums {
+            data.appendLittleEndian(checksum)
+        }
+        data.appendLittleEndian(CRC32.checksum(data))
+        return data
+    }
+}
+
+// MARK: - Byte Reader
+// Bounds-checked little-endian reads; running off the end is reported as a truncated file
+private struct ByteReader {
+    let data: Data
+    let name: String
+    private(set) var offset = 0
+
+    init(_ data: Data, name: String) {
+        self.data = data
+        self.name = name
+    }
+
+    mutating func read<T: FixedWidthInteger>(_ type: T.Type) throws -> T {
+        let start = offset
+        let raw = try take(MemoryLayout<T>.size) { $0.loadUnaligned(fromByteOffset: start, as: T.self) }
+        return T(littleEndian: raw)
+    }
+
+    mutating func double() throws -> Double {
+        Double(bitPattern: try read(UInt64.self))
+    }
+
+    mutating func bytes(_ count: Int) throws -> [UInt8] {
+        let start = offset
+        return try take(count) { Array($0[start..<(start + count)]) }
+    }
+
+    mutating func string(length: Int) throws -> String {
+        String(decoding: try bytes(length), as: UTF8.self)
+    }
+
+    private mutating func take<T>(_ count: Int, _ body: (UnsafeRawBufferPointer) -> T) throws -> T {
+        guard count >= 0, offset + count <= data.count else { throw HistoryArchiveError.truncated(name) }
+        let value = data.withUnsafeBytes(body)
+        offset += count
+        return value
+    }
+}
+
+// MARK: - CRC-32
+// IEEE 802.3 polynomial, as zip and PNG use. `update` continues a previous checksum, so appends never rescan.
+enum CRC32 {
+    private static let table: [UInt32] = (0..<256).map { index in
+        var crc = UInt32(index)
+        for _ in 0..<8 {
+            crc = crc & 1 != 0 ? 0xEDB8_8320 ^ (crc >> 1) : crc >> 1
+        }
+        return crc
+    }
+
+    static func checksum(_ data: Data) -> UInt32 {
+        update(0, with: data)
+    }
+
+    static func update(_ checksum: UInt32, with data: Data) -> UInt32 {
+        var crc = ~checksum
+        table.withUnsafeBufferPointer { table in
+            data.withUnsafeBytes { bytes in
+                for byte in bytes {
+                    crc = table[Int((crc ^ UInt32(byte)) & 0xFF)] ^ (crc >> 8)
+                }
+            }
+        }
+        return ~crc
+    }
+}
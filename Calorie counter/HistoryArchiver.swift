@@ -0,0 +1,182 @@
+//
+//  HistoryArchiver.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - History Archiver
+// Keeps the HistoryArchive in step with the store. At every rollover, closed days (before today) newer than
+// the archive's last day are copied in, oldest first; the first run backfills the whole history in batches.
+// Readers take a snapshot and scan its columns without touching Core Data.
+final class HistoryArchiver {
+    static let shared = HistoryArchiver(directory: defaultDirectory)
+
+    static var defaultDirectory: URL {
+        FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("History.archive", isDirectory: true)
+    }
+
+    private static let batchDays = 180
+
+    private let directory: URL
+    private let lock = NSLock()
+    private var archive: HistoryArchive?
+    private var didOpen = false
+
+    init(directory: URL) {
+        self.directory = directory
+    }
+
+    // The archive as of the last append; verified against its checksums the first time
+    func snapshot() -> HistoryArchive? {
+        lock.lock()
+        defer { lock.unlock() }
+        if !didOpen {
+            didOpen = true
+            archive = openVerified()
+        }
+        return archive
+    }
+
+    // Only while every archived day is before `today`. After the clock is moved back, archived days
+    // may be open again and edited, so callers read those from the store instead.
+    func snapshot(before today: Date) -> HistoryArchive? {
+        guard let archive = snapshot(), (archive.lastDate.map { $0 < today } ?? true) else { return nil }
+        return archive
+    }
+
+    // Starts the archive over, for when archived days change in the store (a diary import reaching back
+    // into them). Readers fall back to the store until the next rollover has backfilled it.
+    func discard() {
+        lock.lock()
+        defer { lock.unlock() }
+        didOpen = true
+        do {
+            try? FileManager.default.removeItem(at: directory)
+            archive = try HistoryArchive.open(at: directory)
+            AppLog.info("History archive discarded for rebuild", category: .persistence)
+        } catch {
+            archive = nil
+            AppLog.error("Couldn't reset the history archive: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // A damaged archive is dropped and rebuilt from the store by the next rollover
+    private func openVerified() -> HistoryArchive? {
+        do {
+            return try AppLog.interval("History archive open", category: .persistence) {
+                try HistoryArchive.open(at: directory)
+            }
+        } catch {
+            AppLog.error("History archive unusable, rebuilding: \(error.localizedDescription)", category: .persistence)
+            do {
+                try FileManager.default.removeItem(at: directory)
+                return try HistoryArchive.open(at: directory)
+            } catch {
+                AppLog.error("Couldn't reset the history archive: \(error.localizedDescription)", category: .persistence)
+                return nil
+            }
+        }
+    }
+
+    // Appends every closed day the archive doesn't have yet. Must run on the context's queue;
+    // the context is reset between batches.
+    func archiveClosedDays(before today: Date, in context: NSManagedObjectContext) throws {
+        guard var archive = snapshot() else { return }
+        var archivedCount = 0
+        while true {
+            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+            if let lastDate = archive.lastDate {
+                fetchRequest.predicate = NSPredicate(format: "date > %@ AND date < %@", lastDate as NSDate, today as NSDate)
+            } else {
+                fetchRequest.predicate = NSPredicate(format: "date < %@", today as NSDate)
+            }
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+            fetchRequest.fetchLimit = Self.batchDays
+            fetchRequest.relationshipKeyPathsForPrefetching = ["diaryEntries", "workoutEntries", "weighIns"]
+            let records = try context.loggedFetch(fetchRequest)
+            guard !records.isEmpty else { break }
+
+            let days = Self.archivedDays(records)
+            context.reset()
+            archive = try archive.appending(days)
+            archivedCount += days.count
+            lock.lock()
+            self.archive = archive
+            lock.unlock()
+            if records.count < Self.batchDays {
+                break
+            }
+        }
+        if archivedCount > 0 {
+            AppLog.info("Archived \(archivedCount) closed day(s), \(archive.dayCount) in total", category: .persistence)
+        }
+    }
+
+    // One day per date; where duplicate records exist, the first one that has entries wins, as in DataRepository.dayRecord
+    private static func archivedDays(_ records: [DailyRecord]) -> [ArchivedDay] {
+        var days: [ArchivedDay] = []
+        var index = records.startIndex
+        while index < records.endIndex {
+            guard let date = records[index].date else {
+                index += 1
+                continue
+            }
+            var end = index + 1
+            while end < records.endIndex, records[end].date == date {
+                end += 1
+            }
+            let duplicates = records[index..<end]
+            let record = duplicates.first { !$0.isEmptyDay } ?? records[index]
+            days.append(archivedDay(record, date: date))
+            index = end
+        }
+        return days
+    }
+
+    private static func archivedDay(_ record: DailyRecord, date: Date) -> ArchivedDay {
+        var day = ArchivedDay(
+            date: date,
+            calorieIntake: record.calorieIntake,
+            calorieGoal: record.calorieGoal,
+            passed: record.passFail,
+            weighIn: record.weighIn,
+            waterIntake: record.waterIntake,
+            waterGoal: record.waterGoal,
+            waterUnit: record.waterUnit
+        )
+        // Workout rows in the diary mirror WorkoutEntry, which also has the duration, so only food and water come from the diary
+        for entry in (record.diaryEntries as? Set<CoreDiaryEntry>) ?? [] {
+            switch entry.type {
+            case "Food":
+                day.protein += entry.protein
+                day.carbs += entry.carbs
+                day.fats += entry.fats
+                day.entries.append(ArchivedEntry(kind: .food, timestamp: entry.timestamp ?? date, name: entry.entryDescription ?? "",
+                                                 calories: Double(entry.calories), protein: entry.protein, carbs: entry.carbs, fats: entry.fats))
+            case "Water":
+                day.entries.append(ArchivedEntry(kind: .water, timestamp: entry.timestamp ?? date, amount: entry.waterAmountMl))
+            default:
+                break
+            }
+        }
+        for workout in (record.workoutEntries as? Set<WorkoutEntry>) ?? [] {
+            day.workoutMinutes += workout.duration
+            day.entries.append(ArchivedEntry(kind: .workout, timestamp: workout.timestamp ?? date, name: workout.name ?? "",
+                                             calories: workout.caloriesBurned, amount: workout.duration))
+        }
+        for weighIn in (record.weighIns as? Set<WeighInEntry>) ?? [] {
+            day.entries.append(ArchivedEntry(kind: .weighIn, timestamp: weighIn.timestamp ?? date, amount: weighIn.weight))
+        }
+        day.entries.sort { $0.timestamp < $1.timestamp }
+        return day
+    }
+}
+
+extension DailyRecord {
+    var isEmptyDay: Bool {
+        (diaryEntries?.count ?? 0) == 0 && (workoutEntries?.count ?? 0) == 0 && (weighIns?.count ?? 0) == 0
+    }
+}
@@ -0,0 +1,194 @@
+//
+//  MeasurementSeries.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Length Units
+// Body measurements are stored in centimetres (BodyMeasurement); the unit is only used for display and input.
+enum LengthUnit {
+    case centimeters
+    case inches
+
+    static let centimetersPerInch = 2.54
+
+    init(useMetric: Bool) {
+        self = useMetric ? .centimeters : .inches
+    }
+
+    var centimetersPerUnit: Double {
+        switch self {
+        case .centimeters: return 1
+        case .inches: return Self.centimetersPerInch
+        }
+    }
+
+    var shortLabel: String {
+        switch self {
+        case .centimeters: return "cm"
+        case .inches: return "in"
+        }
+    }
+
+    func toCentimeters(_ amount: Double) -> Double {
+        amount * centimetersPerUnit
+    }
+
+    func fromCentimeters(_ centimeters: Double) -> Double {
+        centimeters / centimetersPerUnit
+    }
+}
+
+// MARK: - Body Metrics
+// Raw values index the series columns; the order matches the rows on the Progress tab
+enum BodyMetric: Int, CaseIterable, Identifiable {
+    case chest, waist, hips, leftArm, rightArm, leftThigh, rightThigh
+
+    var id: Int { rawValue }
+
+    var label: String {
+        switch self {
+        case .chest: return "Chest"
+        case .waist: return "Waist"
+        case .hips: return "Hips"
+        case .leftArm: return "Arms (L)"
+        case .rightArm: return "Arms (R)"
+        case .leftThigh: return "Thighs (L)"
+        case .rightThigh: return "Thighs (R)"
+        }
+    }
+
+    // The BodyMeasurement attribute holding this metric
+    var attributeName: String {
+        switch self {
+        case .chest: return "chest"
+        case .waist: return "waist"
+        case .hips: return "hips"
+        case .leftArm: return "leftArm"
+        case .rightArm: return "rightArm"
+        case .leftThigh: return "leftThigh"
+        case .rightThigh: return "rightThigh"
+        }
+    }
+}
+
+// MARK: - Series Stats
+// Running min/max, first/latest and least-squares sums, updated per sample in O(1). Days are counted
+// from the series' first sample so the sums stay small however long the history.
+struct SeriesStats {
+    private(set) var count = 0
+    private(set) var minimum = Double.infinity
+    private(set) var maximum = -Double.infinity
+    private(set) var first: Double?
+    private(set) var latest: Double?
+    private var sumDays = 0.0
+    private var sumValues = 0.0
+    private var sumDaysSquared = 0.0
+    private var sumDaysTimesValues = 0.0
+
+    mutating func add(_ value: Double, day: Double) {
+        count += 1
+        minimum = min(minimum, value)
+        maximum = max(maximum, value)
+        if first == nil {
+            first = value
+        }
+        latest = value
+        sumDays += day
+        sumValues += value
+        sumDaysSquared += day * day
+        sumDaysTimesValues += day * value
+    }
+
+    // Latest minus first; nil until there are two samples
+    var change: Double? {
+        guard count > 1, let first = first, let latest = latest else { return nil }
+        return latest - first
+    }
+
+    // Slope of the least-squares line through every sample; nil until samples span more than one instant
+    var slopePerDay: Double? {
+        let n = Double(count)
+        let denominator = n * sumDaysSquared - sumDays * sumDays
+        guard count > 1, denominator > 1e-9 else { return nil }
+        return (n * sumDaysTimesValues - sumDays * sumValues) / denominator
+    }
+
+    var ratePerWeek: Double? {
+        slopePerDay.map { $0 * 7 }
+    }
+}
+
+// MARK: - Measurement Series
+// Body measurements laid out by column: one contiguous centimetre array per metric, aligned with `dates`,
+// so a chart of one metric reads one array. Stats and the waist-to-hip ratio are maintained as each
+// sample is appended. A 0 in the store means the metric wasn't measured that time; it is kept as NaN
+// in the column and skipped by the stats.
+struct MeasurementSeries {
+    private(set) var dates: [Date] = []
+    private var columns: [[Double]] = Array(repeating: [], count: BodyMetric.allCases.count)
+    private var columnStats: [SeriesStats] = Array(repeating: SeriesStats(), count: BodyMetric.allCases.count)
+    private(set) var waistToHip: [Double] = []
+    private(set) var waistToHipStats = SeriesStats()
+    private(set) var latestIsBlank = true // Every metric 0 in the newest sample
+
+    init() {}
+
+    // Samples in any order; each is the metrics in BodyMetric order, in centimetres
+    init<S: Sequence>(_ samples: S) where S.Element == (date: Date, centimeters: [Double]) {
+        for sample in samples.sorted(by: { $0.date < $1.date }) {
+            append(date: sample.date, centimeters: sample.centimeters)
+        }
+    }
+
+    var count: Int { dates.count }
+    var isEmpty: Bool { dates.isEmpty }
+    var latestDate: Date? { dates.last }
+
+    func values(_ metric: BodyMetric) -> [Double] {
+        columns[metric.rawValue]
+    }
+
+    func stats(_ metric: BodyMetric) -> SeriesStats {
+        columnStats[metric.rawValue]
+    }
+
+    // Dates must not go backwards; an older sample rebuilds the series in order instead
+    mutating func append(date: Date, centimeters: [Double]) {
+        precondition(centimeters.count == BodyMetric.allCases.count, "One value per BodyMetric")
+        if let last = dates.last, date < last {
+            self = MeasurementSeries(samples + [(date: date, centimeters: centimeters)])
+            return
+        }
+        let day = dates.first.map { date.timeIntervalSince($0) / 86_400 } ?? 0
+        dates.append(date)
+        var isBlank = true
+        for (index, value) in centimeters.enumerated() {
+            if value > 0 {
+                columns[index].append(value)
+                columnStats[index].add(value, day: day)
+                isBlank = false
+            } else {
+                columns[index].append(.nan)
+            }
+        }
+        latestIsBlank = isBlank
+
+        let waist = centimeters[BodyMetric.waist.rawValue]
+        let hips = centimeters[BodyMetric.hips.rawValue]
+        if waist > 0, hips > 0 {
+            waistToHip.append(waist / hips)
+            waistToHipStats.add(waist / hips, day: day)
+        } else {
+            waistToHip.append(.nan)
+        }
+    }
+
+    // Rows back out of the columns, for a rebuild
+    private var samples: [(date: Date, centimeters: [Double])] {
+        dates.indices.map { row in
+            (date: dates[row], centimeters: columns.map { $0[row].isNaN ? 0 : $0[row] })
+        }
+    }
+}
@@ -11,27 +11,79 @@ struct PersistenceController {
     static let shared = PersistenceController()
 
     let container: NSPersistentContainer
+    private let storeLoad = StoreLoadState()
 
-    init() {
+    init(inMemory: Bool = false) {
         container = NSPersistentContainer(name: "CalorieCounterModel")
         
         let description = container.persistentStoreDescriptions.first
+        if inMemory {
+            description?.url = URL(fileURLWithPath: "/dev/null")
+        }
         description?.setOption(true as NSNumber, forKey: NSMigratePersistentStoresAutomaticallyOption)
         description?.setOption(true as NSNumber, forKey: NSInferMappingModelAutomaticallyOption)
+        // Load off the main thread; StartupPipeline awaits waitForStores() before any UI touches the context
+        description?.shouldAddStoreAsynchronously = true
+
+        container.viewContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        container.viewContext.automaticallyMergesChangesFromParent = true
+        container.viewContext.undoManager = nil
 
+        // SQLite can only VACUUM as the store is added, so a maintenance sweep that left enough free pages asks for it here
+        let compacting = !inMemory && UserDefaults.standard.bool(forKey: StoreMaintenance.compactionDueKey)
+        let sizeBeforeCompaction = compacting ? (description?.url).map { StoreMaintenance.storeSize(at: $0) } ?? 0 : 0
+        if compacting {
+            description?.setOption(true as NSNumber, forKey: NSSQLiteManualVacuumOption)
+            description?.setOption(true as NSNumber, forKey: NSSQLiteAnalyzeOption)
+        }
+
+        loadStores(compacting: compacting, sizeBeforeCompaction: sizeBeforeCompaction)
+    }
+
+    private func loadStores(compacting: Bool = false, sizeBeforeCompaction: Int64 = 0) {
+        let storeLoad = self.storeLoad
         container.loadPersistentStores { description, error in
             if let error = error as NSError? {
-                print("❌ Failed to load persistent store: \(error), \(error.userInfo)")
+                AppLog.error("Failed to load persistent store: \(error), \(error.userInfo)", category: .persistence)
+                storeLoad.finish(.failure(error))
             } else {
-                print("✅ Core Data stack initialized at: \(description.url?.absoluteString ?? "Unknown Location")")
+                AppLog.info("Core Data stack initialized at: \(description.url?.absoluteString ?? "Unknown Location")", category: .persistence)
+                if compacting, let url = description.url {
+                    let reclaimed = max(sizeBeforeCompaction - StoreMaintenance.storeSize(at: url), 0)
+                    UserDefaults.standard.set(reclaimed, forKey: StoreMaintenance.lastCompactionReclaimedKey)
+                    UserDefaults.standard.removeObject(forKey: StoreMaintenance.compactionDueKey)
+                    AppLog.info("Compacted the store, reclaimed \(reclaimed) bytes", category: .persistence)
+                }
+                storeLoad.finish(.success(()))
             }
         }
+    }
 
-        container.viewContext.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
-        container.viewContext.automaticallyMergesChangesFromParent = true
-        container.viewContext.undoManager = nil
+    // Adds the store again after a failed load, e.g. once the user has freed up space;
+    // waitForStores() then waits on the new attempt
+    func retryStoreLoad() {
+        guard storeLoad.clearFailure() else { return }
+        loadStores()
+    }
 
-        preloadActivitiesIfNeeded()
+    // Resumes once the store has been added (or failed to load)
+    func waitForStores() async throws {
+        try await storeLoad.wait()
+    }
+
+    // One-time data fixes; run by StartupPipeline once the store is loaded, on a background context.
+    // Saves reach the view context through automaticallyMergesChangesFromParent.
+    func runDataMigrations() async {
+        let context = container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+        await context.perform {
+            migratePreloadedActivitiesIfNeeded(in: context)
+            migrateWaterAmountsIfNeeded(in: context)
+            migrateEntryTimestampsIfNeeded(in: context)
+            migrateDiaryEntryIDsIfNeeded(in: context)
+            migrateBodyMeasurementsToCentimetersIfNeeded(in: context)
+        }
     }
 
     var context: NSManagedObjectContext {
@@ -43,10 +95,10 @@ struct PersistenceController {
         if context.hasChanges {
             do {
                 try context.save()
-                print("✅ Changes saved successfully!")
+                AppLog.info("Saved view context changes", category: .persistence)
             } catch {
                 let nsError = error as NSError
-                print("❌ Failed to save context: \(nsError), \(nsError.userInfo)")
+                AppLog.error("Failed to save context: \(nsError), \(nsError.userInfo)", category: .persistence)
             }
         }
     }
@@ -58,110 +110,222 @@ struct PersistenceController {
         do {
             return try container.viewContext.fetch(request) as? [T] ?? []
         } catch {
-            print("❌ Fetch error: \(error)")
+            AppLog.error("Failed to fetch \(entity): \(error.localizedDescription)", category: .persistence)
             return []
         }
     }
 
+    // Batch deletes skip the delete rules, so cascaded children go first, and the view context is told about both
     func deleteAll<T: NSManagedObject>(_ entity: T.Type) {
+        let context = container.viewContext
         let request = T.fetchRequest()
-        let batchDeleteRequest = NSBatchDeleteRequest(fetchRequest: request)
+        let cascaded = T.entity().relationshipsByName.values.filter { $0.deleteRule == .cascadeDeleteRule }
+
+        do {
+            var deletedIDs: [NSManagedObjectID] = []
+            for relationship in cascaded {
+                guard let destination = relationship.destinationEntity?.name, let inverse = relationship.inverseRelationship else { continue }
+                let childRequest = NSFetchRequest<NSFetchRequestResult>(entityName: destination)
+                childRequest.predicate = NSPredicate(format: "%K != nil", inverse.name)
+                deletedIDs += try batchDelete(childRequest, in: context)
+            }
+            deletedIDs += try batchDelete(request, in: context)
+            NSManagedObjectContext.mergeChanges(fromRemoteContextSave: [NSDeletedObjectsKey: deletedIDs], into: [context])
+            AppLog.info("Deleted all \(entity) objects", category: .persistence)
+        } catch {
+            AppLog.error("Failed to delete \(entity): \(error)", category: .persistence)
+        }
+    }
+
+    private func batchDelete(_ fetchRequest: NSFetchRequest<NSFetchRequestResult>, in context: NSManagedObjectContext) throws -> [NSManagedObjectID] {
+        let request = NSBatchDeleteRequest(fetchRequest: fetchRequest)
+        request.resultType = .resultTypeObjectIDs
+        let result = try context.execute(request) as? NSBatchDeleteResult
+        return result?.result as? [NSManagedObjectID] ?? []
+    }
+
+    // One-time pass after the v2 model migration: parse legacy water detail strings into waterAmountMl
+    private func migrateWaterAmountsIfNeeded(in context: NSManagedObjectContext) {
+        let migrationKey = "didMigrateWaterAmountsToMl"
+        guard !UserDefaults.standard.bool(forKey: migrationKey) else { return }
+
+        let fetchRequest: NSFetchRequest<CoreDiaryEntry> = CoreDiaryEntry.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "type == %@ AND waterAmountMl == 0", "Water")
 
         do {
-            try container.viewContext.execute(batchDeleteRequest)
-            print("🗑️ All \(entity) objects deleted successfully!")
+            let entries = try context.fetch(fetchRequest)
+            for entry in entries {
+                entry.waterAmountMl = WaterUnit.millilitersFromLegacyDetail(entry.detail ?? "")
+            }
+            if context.hasChanges {
+                try context.save()
+            }
+            UserDefaults.standard.set(true, forKey: migrationKey)
+            AppLog.info("Migrated \(entries.count) water entries to millilitres", category: .persistence)
         } catch {
-            print("❌ Failed to delete \(entity): \(error)")
+            AppLog.error("Failed to migrate water entries: \(error.localizedDescription)", category: .persistence)
         }
     }
 
-    private func preloadActivitiesIfNeeded() {
-        let context = container.viewContext
-        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
+    // One-time pass after the v2 model migration: turn legacy "h:mm a" strings into real timestamps on the record's day.
+    // Legacy workout diary rows also stored the duration as the title and the activity as the detail; they are
+    // swapped to match DiaryEntry. Only rows without a timestamp predate v2, so newer rows are never touched.
+    private func migrateEntryTimestampsIfNeeded(in context: NSManagedObjectContext) {
+        let migrationKey = "didMigrateEntryTimestamps"
+        guard !UserDefaults.standard.bool(forKey: migrationKey) else { return }
+
+        var migratedCount = 0
+
+        do {
+            for entityName in ["CoreDiaryEntry", "WeighInEntry", "WorkoutEntry"] {
+                let fetchRequest = NSFetchRequest<NSManagedObject>(entityName: entityName)
+                fetchRequest.predicate = NSPredicate(format: "timestamp == nil")
+                fetchRequest.relationshipKeyPathsForPrefetching = ["dailyRecord"]
+                for entry in try context.fetch(fetchRequest) {
+                    let day = entry.value(forKeyPath: "dailyRecord.date") as? Date ?? Date()
+                    entry.setValue(legacyEntryTimestamp(entry.value(forKey: "time") as? String, on: day), forKey: "timestamp")
+                    if let entry = entry as? CoreDiaryEntry, entry.type == "Workout" {
+                        (entry.entryDescription, entry.detail) = (entry.detail, entry.entryDescription)
+                    }
+                    migratedCount += 1
+                }
+            }
+            if context.hasChanges {
+                try context.save()
+            }
+            UserDefaults.standard.set(true, forKey: migrationKey)
+            AppLog.info("Migrated \(migratedCount) entry timestamps", category: .persistence)
+        } catch {
+            AppLog.error("Failed to migrate entry timestamps: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // One-time pass when diary rows gained a stable id: give every existing row one
+    private func migrateDiaryEntryIDsIfNeeded(in context: NSManagedObjectContext) {
+        let migrationKey = "didMigrateDiaryEntryIDs"
+        guard !UserDefaults.standard.bool(forKey: migrationKey) else { return }
+
+        let fetchRequest: NSFetchRequest<CoreDiaryEntry> = CoreDiaryEntry.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "id == nil")
+
+        do {
+            let entries = try context.fetch(fetchRequest)
+            for entry in entries {
+                entry.id = UUID()
+            }
+            if context.hasChanges {
+                try context.save()
+            }
+            UserDefaults.standard.set(true, forKey: migrationKey)
+            AppLog.info("Assigned ids to \(entries.count) diary entries", category: .persistence)
+        } catch {
+            AppLog.error("Failed to migrate diary entry ids: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // One-time pass when measurements became canonical centimetres: rows used to be saved in the
+    // profile's unit, so those belonging to imperial profiles are converted from inches
+    private func migrateBodyMeasurementsToCentimetersIfNeeded(in context: NSManagedObjectContext) {
+        let migrationKey = "didMigrateBodyMeasurementsToCm"
+        guard !UserDefaults.standard.bool(forKey: migrationKey) else { return }
+
+        let fetchRequest: NSFetchRequest<BodyMeasurement> = BodyMeasurement.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "userProfile.useMetric == NO")
 
         do {
-            let count = try context.count(for: fetchRequest)
-            if count == 0 {
-                let activities = [
-                    ("Abs", 2.8, "ABS"),
-                    ("Badminton", 4.5, "ShuttleCock"),
-                    ("Baseball", 5.0, "Baseball"),
-                    ("Basketball", 6.5, "Basketball"),
-                    ("Boxing", 12.0, "Boxing"),
-                    ("Calisthenics", 8.0, "calisthenics"),
-                    (" VICross-Country Skiing", 9.0, "XSkiing"),
-                    ("Cycling", 8.0, "Bikeing"),
-                    ("Elliptical", 5.0, "Eliptical"),
-                    ("Golf", 4.3, "Golf"),
-                    ("Hiking", 6.5, "Hiking"),
-                    ("Hockey", 8.0, "Hockey"),
-                    ("Jogging", 7.0, "Running"),
-                    ("Mountain Biking", 8.5, "MountainBike"),
-                    ("Paddle Boarding", 4.0, "Paddle"),
-                    ("Pickleball", 4.1, "Pickle"),
-                    ("Pilates", 3.0, "Pilates"),
-                    ("Racquetball", 7.0, "racquetball"),
-                    ("Rock Climbing", 9.0, "Rockclimbing"),
-                    ("Rowing", 7.0, "Rowing"),
-                    ("Running", 9.8, "Running"),
-                    ("Scuba Diving", 7.0, "scuba"),
-                    ("Skiing", 7.0, "Skiing"),
-                    ("Snowboarding", 5.0, "Snowboarding"),
-                    ("Soccer", 7.0, "Soccer"),
-                    ("Spinning", 8.5 "Spining"),
-                    ("Squash", 7.3, "racquetball"),
-                    ("Swimming", 8.3, "Swiming"),
-                    ("Tennis", 7.3, "tennis"),
-                    ("Volleyball", 3.5, "volley"),
-                    ("Walking", 3.8, "Walking"),
-                    ("Weight Training", 6.0, "Weights"),
-                    ("Yoga", 2.5, "Yoga"),
-                    ("Zumba", 5.5, "Zumba"),
-                    ("Cleaning", 3.5, "cleaning"),
-                    ("Gardening", 3.8, "Garden"),
-                    ("Mowing Lawn", 5.5, "mowing"),
-                    ("Shoveling Snow", 6.0, "snow"),
-                    ("Cleaning Windows", 3.2, "Cleaningwindows"),
-                    ("Painting", 4.5, "Paint"),
-                    ("Shopping", 2.3, "Shop"),
-                    ("Childcare", 3.0, "Child"),
-                    ("Standing", 2.5, "BMDefault"),
-                    ("Construction Work", 4.0, "Const"),
-                    ("Carpentry", 6.0, "Carpentery"),
-                    ("Nursing", 3.3, "nurse"),
-                    ("Teaching", 2.8, "Teach"),
-                    ("Moving Furniture", 6.0, "Moving"),
-                    ("Rucking", 7.0, "Rucking"),
-                    ("Sprinting", 14.0, "Sprinting"),
-                    ("Treading Water", 3.5, "Swiming"),
-                    ("Table Tennis", 4.0, "PingPong"),
-                    ("Martial Arts", 10.0, "MartialArts"),
-                    ("Stretching", 2.5, "Stretch"),
-                    ("Aerobics", 5.0, "Zumba"),
-                    ("Jump Rope", 8.8, "jumpRope"),
-                    ("Dancing", 3.0, "Zumba"),
-                    ("Fishing", 3.5, "Fish"),
-                    ("Horseback Riding", 5.8, "Horse"),
-                    ("Skating", 7.0, "Skateing"),
-                    ("Ice Skating", 7.0, "IceSkateing"),
-                    ("Kayaking", 5.0, "Kayak"),
-                    ("Canoeing", 3.0, "Kayak"),
-                    ("Playing Video Games", 3.8, "vgame")
-                ]
-
-                for (name, metValue, imageName) in activities {
-                    let newActivity = ActivityModel(context: context)
-                    newActivity.id = UUID()
-                    newActivity.name = name
-                    newActivity.metValue = metValue
-                    newActivity.imageName = imageName
+            let measurements = try context.fetch(fetchRequest)
+            for measurement in measurements {
+                for metric in BodyMetric.allCases {
+                    let inches = measurement.value(forKey: metric.attributeName) as? Double ?? 0
+                    measurement.setValue(LengthUnit.inches.toCentimeters(inches), forKey: metric.attributeName)
                 }
+            }
+            if context.hasChanges {
+                try context.save()
+            }
+            UserDefaults.standard.set(true, forKey: migrationKey)
+            AppLog.info("Migrated \(measurements.count) body measurements to centimetres", category: .persistence)
+        } catch {
+            AppLog.error("Failed to migrate body measurements: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // One-time pass when built-ins moved into BuiltInActivityCatalog: preloaded rows become overlays
+    // keyed by the catalog id if the user favorited or used them, otherwise they are dropped
+    private func migratePreloadedActivitiesIfNeeded(in context: NSManagedObjectContext) {
+        let migrationKey = "didMigratePreloadedActivities"
+        guard !UserDefaults.standard.bool(forKey: migrationKey) else { return }
+
+        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "isCustom == NO")
+        var keptIDs = Set<UUID>()
+        var deletedCount = 0
 
+        do {
+            for activity in try context.fetch(fetchRequest) {
+                if let id = activity.id, BuiltInActivityCatalog.isBuiltIn(id), !keptIDs.contains(id) {
+                    keptIDs.insert(id)
+                    continue
+                }
+                guard let builtIn = BuiltInActivityCatalog.activity(named: activity.name ?? ""),
+                      activity.isFavorite || activity.lastUsed != nil,
+                      !keptIDs.contains(builtIn.id) else {
+                    context.delete(activity)
+                    deletedCount += 1
+                    continue
+                }
+                activity.id = builtIn.id
+                activity.name = builtIn.name
+                activity.metValue = builtIn.metValue
+                activity.imageName = builtIn.imageName
+                keptIDs.insert(builtIn.id)
+            }
+            if context.hasChanges {
                 try context.save()
-                print("✅ Activities preloaded successfully!")
             }
+            UserDefaults.standard.set(true, forKey: migrationKey)
+            AppLog.info("Migrated preloaded activities: \(keptIDs.count) overlays kept, \(deletedCount) rows removed", category: .persistence)
         } catch {
-            print("❌ ERROR: Failed to preload activities: \(error.localizedDescription)")
+            AppLog.error("Failed to migrate preloaded activities: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+}
+
+// MARK: - Store Load State
+// Holds the async store-load result so any number of callers can await it, before or after it finishes
+private final class StoreLoadState {
+    private let lock = NSLock()
+    private var result: Result<Void, Error>?
+    private var waiters: [CheckedContinuation<Void, Error>] = []
+
+    func finish(_ result: Result<Void, Error>) {
+        lock.lock()
+        self.result = result
+        let pending = waiters
+        waiters = []
+        lock.unlock()
+        pending.forEach { $0.resume(with: result) }
+    }
+
+    // Forgets a failed load so it can be attempted again; false once the store has loaded or while it is loading
+    func clearFailure() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        guard case .failure = result else { return false }
+        result = nil
+        return true
+    }
+
+    func wait() async throws {
+        try await withCheckedThrowingContinuation { (continuation: CheckedContinuation<Void, Error>) in
+            lock.lock()
+            if let result = result {
+                lock.unlock()
+                continuation.resume(with: result)
+            } else {
+                waiters.append(continuation)
+                lock.unlock()
+            }
         }
     }
 }
@@ -0,0 +1,191 @@
+//
+//  PhotoIngest.swift
+//  Calorie counter
+//
+
+import UIKit
+import CoreData
+import ImageIO
+import UniformTypeIdentifiers
+
+// MARK: - Photo Renditions
+// What a picked photo is stored as: a bounded master plus full-screen and grid sizes.
+// All three are upright JPEGs; EXIF orientation is baked in and no metadata is carried over.
+struct PhotoRenditions {
+    let master: Data
+    let display: Data
+    let thumbnail: Data
+    let pixelWidth: Int // Master dimensions
+    let pixelHeight: Int
+
+    var byteCount: Int { master.count + display.count + thumbnail.count }
+}
+
+enum PhotoIngestError: LocalizedError {
+    case unreadable
+    case encodingFailed
+
+    var errorDescription: String? {
+        switch self {
+        case .unreadable: return "The photo could not be read"
+        case .encodingFailed: return "The photo could not be re-encoded"
+        }
+    }
+}
+
+// MARK: - Photo Ingest
+// ImageIO downsamples straight from the compressed source, so a 12 MP HEIC is never decoded at full size
+enum PhotoIngest {
+    struct Rendition {
+        let maxPixelSize: Int // Longest edge; smaller sources are not upscaled
+        let quality: Double
+    }
+
+    static let master = Rendition(maxPixelSize: 2048, quality: 0.8)
+    static let display = Rendition(maxPixelSize: 1280, quality: 0.75)
+    static let thumbnail = Rendition(maxPixelSize: 320, quality: 0.7)
+
+    // Transcodes on a background task; safe to await from the main actor
+    static func renditions(from data: Data) async throws -> PhotoRenditions {
+        try await Task.detached(priority: .userInitiated) {
+            try makeRenditions(from: data)
+        }.value
+    }
+
+    static func makeRenditions(from data: Data) throws -> PhotoRenditions {
+        try AppLog.interval("Photo ingest", category: .images, detail: "\(data.count) bytes") {
+            guard let source = CGImageSourceCreateWithData(data as CFData, [kCGImageSourceShouldCache: false] as CFDictionary),
+                  CGImageSourceGetCount(source) > 0 else {
+                throw PhotoIngestError.unreadable
+            }
+            let masterImage = try image(from: source, rendition: master)
+            let renditions = PhotoRenditions(
+                master: try encode(masterImage, quality: master.quality),
+                display: try encode(image(from: source, rendition: display), quality: display.quality),
+                thumbnail: try encode(image(from: source, rendition: thumbnail), quality: thumbnail.quality),
+                pixelWidth: masterImage.width,
+                pixelHeight: masterImage.height
+            )
+            AppLog.info("Ingested photo: \(data.count) bytes in, \(renditions.byteCount) stored at \(masterImage.width)x\(masterImage.height)", category: .images)
+            return renditions
+        }
+    }
+
+    // Decoded and downsampled in one step; used off the main thread for grid cells
+    static func thumbnailImage(from data: Data, maxPixelSize: Int = thumbnail.maxPixelSize) -> UIImage? {
+        AppLog.interval("Image decode", category: .images, detail: "\(data.count) bytes") {
+            PerfCounters.shared.add(.bytesDecoded, data.count)
+            guard let source = CGImageSourceCreateWithData(data as CFData, [kCGImageSourceShouldCache: false] as CFDictionary),
+                  let image = try? image(from: source, rendition: Rendition(maxPixelSize: maxPixelSize, quality: 1)) else {
+                return nil
+            }
+            return UIImage(cgImage: image)
+        }
+    }
+
+    private static func image(from source: CGImageSource, rendition: Rendition) throws -> CGImage {
+        let options: [CFString: Any] = [
+            kCGImageSourceCreateThumbnailFromImageAlways: true,
+            kCGImageSourceCreateThumbnailWithTransform: true, // Applies EXIF orientation
+            kCGImageSourceThumbnailMaxPixelSize: rendition.maxPixelSize,
+            kCGImageSourceShouldCacheImmediately: true
+        ]
+        guard let image = CGImageSourceCreateThumbnailAtIndex(source, 0, options as CFDictionary) else {
+            throw PhotoIngestError.unreadable
+        }
+        return image
+    }
+
+    private static func encode(_ image: CGImage, quality: Double) throws -> Data {
+        let data = NSMutableData()
+        guard let destination = CGImageDestinationCreateWithData(data as CFMutableData, UTType.jpeg.identifier as CFString, 1, nil) else {
+            throw PhotoIngestError.encodingFailed
+        }
+        CGImageDestinationAddImage(destination, image, [kCGImageDestinationLossyCompressionQuality: quality] as CFDictionary)
+        guard CGImageDestinationFinalize(destination) else {
+            throw PhotoIngestError.encodingFailed
+        }
+        return data as Data
+    }
+
+    // MARK: Backfill
+    // Re-ingests photos stored before renditions existed, one at a time on a private-queue context
+    // so only a single original is in memory. Rows that fail to transcode are left as they are.
+    static func backfillLegacyPhotos(in persistence: PersistenceController = .shared) async {
+        let context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+        do {
+            try await persistence.waitForStores()
+            let pictureIDs = try await context.perform {
+                try legacyObjectIDs("ProgressPicture", predicate: "imageData != nil AND thumbnailData == nil", in: context)
+            }
+            let profileIDs = try await context.perform {
+                try legacyObjectIDs("UserProfile", predicate: "startPicture != nil AND startPictureThumbnail == nil", in: context)
+            }
+            guard !pictureIDs.isEmpty || !profileIDs.isEmpty else { return }
+
+            var savedBytes = 0
+            for objectID in pictureIDs + profileIDs {
+                guard !Task.isCancelled else { break }
+                savedBytes += await context.perform {
+                    defer { context.reset() }
+                    return reingest(objectID, in: context)
+                }
+            }
+            AppLog.info("Backfilled \(pictureIDs.count + profileIDs.count) photo(s), \(savedBytes) bytes reclaimed", category: .images)
+        } catch {
+            AppLog.error("Photo backfill failed: \(error.localizedDescription)", category: .images)
+        }
+    }
+
+    private static func legacyObjectIDs(_ entityName: String, predicate format: String, in context: NSManagedObjectContext) throws -> [NSManagedObjectID] {
+        let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: entityName)
+        fetchRequest.resultType = .managedObjectIDResultType
+        fetchRequest.predicate = NSPredicate(format: format)
+        return try context.fetch(fetchRequest)
+    }
+
+    // Bytes saved, 0 when the row was skipped
+    private static func reingest(_ objectID: NSManagedObjectID, in context: NSManagedObjectContext) -> Int {
+        do {
+            let object = try context.existingObject(with: objectID)
+            if let picture = object as? ProgressPicture, let original = picture.imageData {
+                let renditions = try makeRenditions(from: original)
+                picture.store(renditions)
+                try context.save()
+                return original.count - renditions.byteCount
+            }
+            if let profile = object as? UserProfile, let original = profile.startPicture {
+                let renditions = try makeRenditions(from: original)
+                profile.storeStartPicture(renditions)
+                try context.save()
+                return original.count - renditions.byteCount
+            }
+        } catch {
+            context.rollback()
+            AppLog.warning("Skipped photo backfill for \(objectID.uriRepresentation().lastPathComponent): \(error.localizedDescription)", category: .images)
+        }
+        return 0
+    }
+}
+
+// MARK: - Storing Renditions
+extension ProgressPicture {
+    func store(_ renditions: PhotoRenditions) {
+        imageData = renditions.master
+        displayData = renditions.display
+        thumbnailData = renditions.thumbnail
+        pixelWidth = Int32(renditions.pixelWidth)
+        pixelHeight = Int32(renditions.pixelHeight)
+        byteCount = Int64(renditions.byteCount)
+    }
+}
+
+extension UserProfile {
+    func storeStartPicture(_ renditions: PhotoRenditions) {
+        startPicture = renditions.master
+        startPictureDisplay = renditions.display
+        startPictureThumbnail = renditions.thumbnail
+    }
+}
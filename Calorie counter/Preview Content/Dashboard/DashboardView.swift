@@ -167,16 +167,16 @@ struct DashboardView: View {
         }
     }
 
-    private func saveWeighIn(time: String, weight: String) {
+    private func saveWeighIn(timestamp: Date, weight: String) {
         DispatchQueue.main.async {
-            weighIns.append(WeighIn(time: time, weight: weight)) // Updated to use WeighIn
+            weighIns.append(WeighIn(timestamp: timestamp, weight: weight)) // Updated to use WeighIn
         }
     }
 }
 
 struct FullScreenOverlay: View {
     let closeAction: () -> Void
-    let saveWeighIn: (String, String) -> Void
+    let saveWeighIn: (Date, String) -> Void
     @Binding var isPlusButtonPressed: Bool
     @Binding var showSemiCircle: Bool
     @Binding var currentRadius: CGFloat
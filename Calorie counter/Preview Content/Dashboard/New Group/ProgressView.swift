@@ -16,20 +16,15 @@ struct ProgressView: View {
     @Environment(\.managedObjectContext) private var viewContext
     
     @State private var userProfile: UserProfile?
-    @State private var dailyRecords: [DailyRecord] = []
-    @State private var bodyMeasurements: [BodyMeasurement] = []
+    @State private var dailyWeights: [WeighInSample] = []
+    @State private var measurementSeries = MeasurementSeries()
     @State private var showBodyMeasurementView = false
     @State private var showDeleteConfirmation = false
     @State private var pictureToDelete: ProgressPicture? = nil
     @State private var showDeleteOptions = false
     
     // Simulated Date Logic
-    private var simulatedCurrentDate: Date {
-        if let savedDate = UserDefaults.standard.object(forKey: "simulatedCurrentDate") as? Date {
-            return Calendar.current.startOfDay(for: savedDate)
-        }
-        return Calendar.current.startOfDay(for: Date())
-    }
+    @ObservedObject private var clock = AppClock.shared
     
     var body: some View {
         ZStack {
@@ -45,10 +40,10 @@ struct ProgressView: View {
                         }
                     )
                     .environment(\.managedObjectContext, viewContext)
-                    WeightProgressView(userProfile: $userProfile, dailyRecords: $dailyRecords)
+                    WeightProgressView(userProfile: $userProfile, dailyWeights: $dailyWeights)
                     BodyMeasurementView(
                         userProfile: $userProfile,
-                        bodyMeasurements: $bodyMeasurements,
+                        series: measurementSeries,
                         showBodyMeasurementView: $showBodyMeasurementView
                     )
                     ExerciseOverviewView(
@@ -59,10 +54,13 @@ struct ProgressView: View {
             .frame(maxWidth: .infinity, maxHeight: .infinity)
             .background(Styles.primaryBackground)
             .ignoresSafeArea(edges: .top)
+            .profilingScreen("Progress")
             .onAppear {
                 fetchUserProfile()
-                fetchDailyRecords()
-                fetchBodyMeasurements()
+            }
+            .task {
+                await fetchDailyWeights()
+                await fetchMeasurementSeries()
             }
             .sheet(isPresented: $showBodyMeasurementView) {
                 MeasurementInputView(userProfile: userProfile)
@@ -70,7 +68,7 @@ struct ProgressView: View {
             }
             .onChange(of: showBodyMeasurementView) { newValue in
                 if !newValue { // Sheet dismissed
-                    fetchBodyMeasurements()
+                    Task { await fetchMeasurementSeries() }
                 }
             }
             
@@ -93,7 +91,7 @@ struct ProgressView: View {
                         .foregroundColor(Styles.primaryText)
                         .multilineTextAlignment(.center)
                         .padding(.vertical)
-                    if let picture = pictureToDelete, let imageData = picture.imageData, let image = UIImage(data: imageData) {
+                    if let picture = pictureToDelete, let imageData = picture.displayData ?? picture.imageData, let image = UIImage.decoded(from: imageData) {
                         Image(uiImage: image)
                             .resizable()
                             .scaledToFill()
@@ -150,15 +148,10 @@ struct ProgressView: View {
     }
     
     private func fetchUserProfile() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let profile = try viewContext.fetch(fetchRequest).first {
-                userProfile = profile
-                print("✅ ProgressView fetched user profile: \(profile.name ?? "Unknown")")
-            } else {
-                print("⚠️ No UserProfile found in Core Data for ProgressView")
-                let newProfile = UserProfile(context: viewContext)
+        let profileStore = ProfileStore.shared
+        if profileStore.profile == nil {
+            print("⚠️ No UserProfile found in Core Data for ProgressView")
+            let created = profileStore.createProfileIfNeeded { newProfile in
                 newProfile.name = "Default User"
                 newProfile.gender = "Male"
                 newProfile.currentWeight = 0.0
@@ -166,45 +159,43 @@ struct ProgressView: View {
                 newProfile.goalWeight = 0.0
                 newProfile.useMetric = false
                 newProfile.highestActivityStreak = 1 // Initialize to 1 as per your requirement
-                newProfile.startDate = Calendar.current.startOfDay(for: Date()) // Set start date for streak calculations
+                newProfile.startDate = clock.today // Set start date for streak calculations
                 newProfile.dailyCalorieGoal = 2000 // Reasonable default calorie goal
                 newProfile.waterGoal = 8 // Default water goal (e.g., 8 cups or 2L, depending on unit)
                 newProfile.waterUnit = newProfile.useMetric ? "L" : "cups" // Consistent water unit
-                try viewContext.save()
-                userProfile = newProfile
-                print("✅ Created default user profile: \(newProfile.name ?? "Unknown") with highestActivityStreak: \(newProfile.highestActivityStreak)")
             }
-        } catch {
-            print("❌ Error fetching user profile: \(error.localizedDescription)")
-            userProfile = nil
+            if created {
+                print("✅ Created default user profile")
+            }
+        }
+        // The picture and measurement screens need the managed object for their relationships
+        userProfile = profileStore.managedProfile
+        if let profile = userProfile {
+            print("✅ ProgressView loaded user profile: \(profile.name ?? "Unknown")")
         }
     }
-    private func fetchDailyRecords() {
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+    // Date and weigh-in columns only; the chart never needs the records themselves
+    private func fetchDailyWeights() async {
         do {
-            dailyRecords = try viewContext.fetch(fetchRequest)
-            print("✅ Fetched \(dailyRecords.count) daily records")
+            dailyWeights = try await DataRepository.shared.dailyWeights()
+            print("✅ Fetched \(dailyWeights.count) daily weights")
         } catch {
-            print("❌ Error fetching daily records: \(error.localizedDescription)")
-            dailyRecords = []
+            print("❌ Error fetching daily weights: \(error.localizedDescription)")
+            dailyWeights = []
         }
     }
     
-    private func fetchBodyMeasurements() {
+    private func fetchMeasurementSeries() async {
         guard let userProfile = userProfile else {
             print("❌ No user profile for fetching measurements")
             return
         }
-        let fetchRequest: NSFetchRequest<BodyMeasurement> = BodyMeasurement.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "userProfile == %@", userProfile)
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
         do {
-            bodyMeasurements = try viewContext.fetch(fetchRequest)
-            print("✅ Fetched \(bodyMeasurements.count) body measurements")
+            measurementSeries = try await DataRepository.shared.measurementSeries(for: userProfile.objectID)
+            AppLog.debug("Fetched \(measurementSeries.count) body measurements", category: .profile)
         } catch {
-            print("❌ Fetch error: \(error.localizedDescription)")
-            bodyMeasurements = []
+            AppLog.error("Failed to fetch body measurements: \(error.localizedDescription)", category: .profile)
+            measurementSeries = MeasurementSeries()
         }
     }
     
@@ -6,21 +6,15 @@
 
 import SwiftUI
 import Charts
-import CoreData
 
 struct PastView: View {
-    @Environment(\.managedObjectContext) private var viewContext
+    @State private var pastRecords: [DaySummary] = []
+    @ObservedObject private var profileStore = ProfileStore.shared
+    @State private var selectedRecord: DaySummary?
     
-    @State private var pastRecords: [DailyRecord] = []
-    @State private var userProfile: UserProfile?
-    @State private var selectedRecord: DailyRecord?
-    
-    private var simulatedCurrentDate: Date {
-        if let savedDate = UserDefaults.standard.object(forKey: "simulatedCurrentDate") as? Date {
-            return Calendar.current.startOfDay(for: savedDate)
-        }
-        return Calendar.current.startOfDay(for: Date())
-    }
+    private var userProfile: ProfileSnapshot? { profileStore.profile }
+
+    @ObservedObject private var clock = AppClock.shared
     
     private struct CaloriePoint: Identifiable {
         let id = UUID()
@@ -31,55 +25,53 @@ struct PastView: View {
     
     private var chartData: [CaloriePoint] {
         var data: [CaloriePoint] = []
-        let filteredRecords = pastRecords.filter { !Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }
+        let filteredRecords = pastRecords.filter { !clock.isToday($0.date) }
         guard !filteredRecords.isEmpty else { return data }
         
-        let sortedRecords = filteredRecords.sorted { $0.date ?? Date() < $1.date ?? Date() }
+        let sortedRecords = filteredRecords.sorted { $0.date < $1.date }
         guard let firstDate = sortedRecords.first?.date,
               let lastDate = sortedRecords.last?.date else { return data }
         
         for record in sortedRecords {
-            if let date = record.date {
-                data.append(CaloriePoint(date: date, value: record.calorieIntake, category: "Intake"))
-                data.append(CaloriePoint(date: date, value: record.calorieGoal, category: "Goal"))
-            }
+            data.append(CaloriePoint(date: record.date, value: record.calorieIntake, category: "Intake"))
+            data.append(CaloriePoint(date: record.date, value: record.calorieGoal, category: "Goal"))
         }
         
         return data
     }
     
     private var averageCalories: Double {
-        let filteredRecords = pastRecords.filter { !Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }
+        let filteredRecords = pastRecords.filter { !clock.isToday($0.date) }
         guard !filteredRecords.isEmpty else { return 0.0 }
         let total = filteredRecords.reduce(0) { $0 + $1.calorieIntake }
         return total / Double(filteredRecords.count)
     }
     
     private var passPercentage: Double {
-        let filteredRecords = pastRecords.filter { !Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }
+        let filteredRecords = pastRecords.filter { !clock.isToday($0.date) }
         guard !filteredRecords.isEmpty else { return 0.0 }
         let passCount = filteredRecords.filter { $0.passFail }.count
         return (Double(passCount) / Double(filteredRecords.count)) * 100
     }
     
     private var xAxisDates: [Date] {
-        let filteredRecords = pastRecords.filter { !Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }
+        let filteredRecords = pastRecords.filter { !clock.isToday($0.date) }
         guard !filteredRecords.isEmpty else { return [] }
-        let sortedRecords = filteredRecords.sorted { $0.date ?? Date() < $1.date ?? Date() }
+        let sortedRecords = filteredRecords.sorted { $0.date < $1.date }
         guard let firstDate = sortedRecords.first?.date,
               let lastDate = sortedRecords.last?.date else { return [] }
         
-        let totalDays = Calendar.current.dateComponents([.day], from: firstDate, to: lastDate).day ?? 0
+        let totalDays = clock.calendar.dateComponents([.day], from: firstDate, to: lastDate).day ?? 0
         let maxLabels = 5
         let step = max(1, totalDays / (maxLabels - 1))
         
         var dates: [Date] = []
         for i in stride(from: 0, through: totalDays, by: step) {
-            if let date = Calendar.current.date(byAdding: .day, value: i, to: firstDate) {
+            if let date = clock.calendar.date(byAdding: .day, value: i, to: firstDate) {
                 dates.append(date)
             }
         }
-        if !dates.contains(where: { Calendar.current.isDate($0, inSameDayAs: lastDate) }) {
+        if !dates.contains(where: { clock.calendar.isDate($0, inSameDayAs: lastDate) }) {
             dates.append(lastDate)
         }
         return dates
@@ -97,7 +89,7 @@ struct PastView: View {
                     .foregroundColor(Styles.primaryText)
                     .frame(maxWidth: .infinity, alignment: .center)
                 
-                if !pastRecords.filter({ !Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }).isEmpty {
+                if !pastRecords.filter({ !clock.isToday($0.date) }).isEmpty {
                     VStack(spacing: 10) {
                         Text("Calories per Day")
                             .font(.headline)
@@ -162,7 +154,7 @@ struct PastView: View {
                             GeometryReader { geometry in
                                 Rectangle().fill(.clear).contentShape(Rectangle())
                                     .overlay(alignment: .leading) {
-                                        if let firstDate = pastRecords.filter({ !Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }).min(by: { $0.date ?? Date() < $1.date ?? Date() })?.date,
+                                        if let firstDate = pastRecords.filter({ !clock.isToday($0.date) }).min(by: { $0.date < $1.date })?.date,
                                            let xPosition = proxy.position(forX: firstDate),
                                            let yPosition = proxy.position(forY: averageCalories) {
                                             Text("\(Int(averageCalories))")
@@ -224,11 +216,12 @@ struct PastView: View {
                         PastDailyDBView(
                             record: selectedRecord,
                             userProfile: userProfile,
+                            dayNumber: (pastRecords.firstIndex(of: selectedRecord) ?? 0) + 1,
                             onBack: { withAnimation { self.selectedRecord = nil } }
                         )
                     } else {
                         VStack(spacing: 10) {
-                            ForEach(Array(pastRecords.enumerated()).reversed().filter { !Calendar.current.isDate($0.element.date ?? Date.distantFuture, inSameDayAs: simulatedCurrentDate) }, id: \.element.objectID) { index, record in
+                            ForEach(Array(pastRecords.enumerated()).reversed().filter { !clock.isToday($0.element.date) }, id: \.element.id) { index, record in
                                 PastDayRow(record: record, userProfile: userProfile, dayNumber: index + 1)
                                     .onTapGesture {
                                         withAnimation {
@@ -250,47 +243,29 @@ struct PastView: View {
         .frame(maxWidth: .infinity, maxHeight: .infinity)
         .background(Styles.primaryBackground)
         .ignoresSafeArea(edges: .top)
-        .onAppear {
-            fetchPastRecords()
-            fetchUserProfile()
+        .profilingScreen("Past")
+        .task {
+            await fetchPastRecords()
         }
     }
     
-    private func fetchPastRecords() {
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
-        
+    private func fetchPastRecords() async {
         do {
-            pastRecords = try viewContext.fetch(fetchRequest)
-            print("DEBUG: Fetched \(pastRecords.count) past records")
-            pastRecords.forEach { record in
-                print("Record - Date: \(record.date ?? Date()), Intake: \(record.calorieIntake), Goal: \(record.calorieGoal)")
-            }
+            pastRecords = try await DataRepository.shared.daySummaries()
+            AppLog.debug("Fetched \(pastRecords.count) past records", category: .persistence)
         } catch {
-            print("❌ Error fetching past records: \(error.localizedDescription)")
+            AppLog.error("Error fetching past records: \(error.localizedDescription)", category: .persistence)
             pastRecords = []
         }
     }
-    
-    private func fetchUserProfile() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        
-        do {
-            userProfile = try viewContext.fetch(fetchRequest).first
-        } catch {
-            print("❌ Error fetching user profile: \(error.localizedDescription)")
-            userProfile = nil
-        }
-    }
 }
 
 struct PastDailyDBView: View {
-    let record: DailyRecord
-    let userProfile: UserProfile?
+    let record: DaySummary
+    let userProfile: ProfileSnapshot?
+    let dayNumber: Int
     let onBack: () -> Void
     
-    @Environment(\.managedObjectContext) private var viewContext
     @State private var diaryEntries: [DiaryEntry] = []
     @State private var weighIns: [WeighIn] = []
     @State private var waterGoal: CGFloat = 0
@@ -298,20 +273,7 @@ struct PastDailyDBView: View {
     @State private var isWaterPickerPresented: Bool = false
     @State private var isWeighInExpanded: Bool = false
     
-    private var selectedDate: Date { record.date ?? Date() }
-    private var dayNumber: Int {
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
-        do {
-            let records = try viewContext.fetch(fetchRequest)
-            if let index = records.firstIndex(where: { Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: selectedDate) }) {
-                return index + 1
-            }
-        } catch {
-            print("❌ Error fetching records for dayNumber: \(error.localizedDescription)")
-        }
-        return 0
-    }
+    private var selectedDate: Date { record.date }
     
     private var totalCalories: Double {
         let foodCalories = diaryEntries.filter { $0.type == "Food" }.reduce(0) { $0 + Double($1.calories) }
@@ -340,56 +302,7 @@ struct PastDailyDBView: View {
     }
     
     private var totalDailyWater: CGFloat {
-        var totalIntake: CGFloat = 0
-        for entry in diaryEntries where entry.type == "Water" {
-            let (amount, unit) = extractWaterAmountAndUnit(entry.detail)
-            let convertedAmount = convertWaterUnit(amount: amount, from: unit, to: selectedUnit)
-            totalIntake += convertedAmount
-        }
-        return totalIntake
-    }
-    
-    private func extractWaterAmountAndUnit(_ detail: String) -> (CGFloat, String) {
-        let fractionMap: [String: CGFloat] = ["1/4": 0.25, "1/2": 0.5, "3/4": 0.75, "1": 1.0]
-        let components = detail.split(separator: " ")
-        if components.count == 2 {
-            let amountString = String(components[0])
-            let unit = String(components[1])
-            if let fractionValue = fractionMap[amountString] {
-                return (fractionValue, unit)
-            } else if let amount = Double(amountString) {
-                return (CGFloat(amount), unit)
-            }
-        } else if detail.contains("fl oz") {
-            let numberString = detail.replacingOccurrences(of: "fl oz", with: "").trimmingCharacters(in: .whitespaces)
-            if let amount = Double(numberString) {
-                return (CGFloat(amount), "fl oz")
-            }
-        }
-        return (0, "ml")
-    }
-    
-    private func convertWaterUnit(amount: CGFloat, from fromUnit: String, to toUnit: String) -> CGFloat {
-        let mlPerFlOz: CGFloat = 29.5735
-        let mlPerGallon: CGFloat = 3785.41
-        let mlPerLiter: CGFloat = 1000
-        
-        var amountInMl: CGFloat
-        switch fromUnit.lowercased() {
-        case "milliliters", "ml": amountInMl = amount
-        case "liters", "l": amountInMl = amount * mlPerLiter
-        case "gallons", "gal": amountInMl = amount * mlPerGallon
-        case "fl", "fl oz": amountInMl = amount * mlPerFlOz
-        default: return amount
-        }
-        
-        switch toUnit.lowercased() {
-        case "milliliters", "ml": return amountInMl
-        case "liters", "l": return amountInMl / mlPerLiter
-        case "gallons", "gal": return amountInMl / mlPerGallon
-        case "fl", "fl oz": return amountInMl / mlPerFlOz
-        default: return amount
-        }
+        CGFloat(WaterUnit.displayAmount(milliliters: diaryEntries.totalWaterMilliliters, in: selectedUnit))
     }
     
     private func formattedDate(_ date: Date) -> String {
@@ -435,7 +348,7 @@ struct PastDailyDBView: View {
                 
                 VStack(spacing: 15) {
                     HStack(spacing: 10) {
-                        Image("bolt")
+                        AppAsset.bolt.image
                             .resizable()
                             .renderingMode(.template)
                             .foregroundColor(Styles.primaryText)
@@ -499,7 +412,7 @@ struct PastDailyDBView: View {
                     Divider()
                     VStack(alignment: .leading, spacing: 5) {
                         HStack(spacing: 10) {
-                            Image("CalW")
+                            AppAsset.calW.image
                                 .resizable()
                                 .renderingMode(.template)
                                 .foregroundColor(Styles.primaryText)
@@ -565,49 +478,36 @@ struct PastDailyDBView: View {
                     .disabled(true)
             }
         }
-        .onAppear {
-            loadDailyRecord()
+        .task {
+            await loadDailyRecord()
         }
     }
     
-    private func loadDailyRecord() {
-        diaryEntries = (record.diaryEntries as? Set<CoreDiaryEntry>)?.map { entity in
-            DiaryEntry(
-                time: entity.time ?? "",
-                iconName: entity.iconName ?? "",
-                description: entity.entryDescription ?? "",
-                detail: entity.detail ?? "",
-                calories: Int(entity.calories),
-                type: entity.type ?? "",
-                imageName: entity.imageName,
-                imageData: entity.imageData,
-                fats: entity.fats,
-                carbs: entity.carbs,
-                protein: entity.protein
-            )
-        } ?? []
+    private func loadDailyRecord() async {
         waterGoal = CGFloat(record.waterGoal)
         selectedUnit = record.waterUnit ?? "fl oz"
-        if record.weighIn > 0 {
-            weighIns = [WeighIn(time: formattedCurrentTime(), weight: String(format: "%.1f", record.weighIn))]
+        do {
+            let snapshot = try await DataRepository.shared.dayRecord(for: selectedDate)
+            diaryEntries = snapshot?.entries ?? []
+            if let recordedWeighIns = snapshot?.weighIns, !recordedWeighIns.isEmpty {
+                weighIns = recordedWeighIns.map { WeighIn(timestamp: $0.timestamp, weight: String(format: "%.1f", $0.weight)) }
+            } else if record.weighIn > 0 {
+                weighIns = [WeighIn(timestamp: selectedDate, weight: String(format: "%.1f", record.weighIn))]
+            }
+            AppLog.debug("Loaded past day - Date: \(formattedDate(selectedDate)), Entries: \(diaryEntries.count)", category: .persistence)
+        } catch {
+            AppLog.error("Error loading past day: \(error.localizedDescription)", category: .persistence)
         }
-        print("DEBUG: Loaded past day - Date: \(formattedDate(selectedDate)), Entries: \(diaryEntries.count)")
-    }
-    
-    private func formattedCurrentTime() -> String {
-        let formatter = DateFormatter()
-        formatter.dateFormat = "h:mm a"
-        return formatter.string(from: Date())
     }
 }
 
 struct PastDayRow: View {
-    let record: DailyRecord
-    let userProfile: UserProfile?
+    let record: DaySummary
+    let userProfile: ProfileSnapshot?
     let dayNumber: Int
     
     private var formattedDate: String {
-        guard let date = record.date else { return "Unknown Date" }
+        let date = record.date
         let formatter = DateFormatter()
         formatter.dateStyle = .medium
         return formatter.string(from: date)
@@ -14,31 +14,26 @@
 // Created by frank lasalvia on 2/26/25.
 
 import SwiftUI
+import Charts
 
 struct BodyMeasurementView: View {
     @Binding var userProfile: UserProfile?
-    @Binding var bodyMeasurements: [BodyMeasurement]
+    let series: MeasurementSeries
     @Binding var showBodyMeasurementView: Bool
     
     // Simulated Date Logic (consistent with DailyDBView.swift)
-    private var simulatedCurrentDate: Date {
-        if let savedDate = UserDefaults.standard.object(forKey: "simulatedCurrentDate") as? Date {
-            return Calendar.current.startOfDay(for: savedDate)
-        }
-        return Calendar.current.startOfDay(for: Date())
-    }
+    @ObservedObject private var clock = AppClock.shared
+    @State private var chartMetric: BodyMetric = .waist
     
     var body: some View {
         ZStack(alignment: .top) {
             VStack(spacing: 15) {
-                let hasMultipleEntries = bodyMeasurements.count > 1
-                let latestMeasurement = bodyMeasurements.last
-                let earliestMeasurement = bodyMeasurements.first
-                let allZero = latestMeasurement.map { $0.chest == 0 && $0.waist == 0 && $0.hips == 0 && $0.leftArm == 0 && $0.rightArm == 0 && $0.leftThigh == 0 && $0.rightThigh == 0 } ?? true
+                let useMetric = userProfile?.useMetric ?? false
+                let unit = LengthUnit(useMetric: useMetric)
                 
                 // Main content container
                 HStack(spacing: 15) {
-                    Image("BMDefault")
+                    AppAsset.bmDefault.image
                         .resizable()
                         .scaledToFit()
                         .frame(width: 100, height: 263)
@@ -49,57 +44,29 @@ struct BodyMeasurementView: View {
                             difference: nil,
                             showDifference: false,
                             useMetric: false,
-                            customText: dateString(for: latestMeasurement?.date)
-                        )
-                        MeasurementRow(
-                            label: "Chest",
-                            value: latestMeasurement?.chest ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.chest, latest: latestMeasurement?.chest),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
-                        )
-                        MeasurementRow(
-                            label: "Waist",
-                            value: latestMeasurement?.waist ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.waist, latest: latestMeasurement?.waist),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
-                        )
-                        MeasurementRow(
-                            label: "Hips",
-                            value: latestMeasurement?.hips ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.hips, latest: latestMeasurement?.hips),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
-                        )
-                        MeasurementRow(
-                            label: "Arms (L)",
-                            value: latestMeasurement?.leftArm ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.leftArm, latest: latestMeasurement?.leftArm),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
-                        )
-                        MeasurementRow(
-                            label: "Arms (R)",
-                            value: latestMeasurement?.rightArm ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.rightArm, latest: latestMeasurement?.rightArm),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
-                        )
-                        MeasurementRow(
-                            label: "Thighs (L)",
-                            value: latestMeasurement?.leftThigh ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.leftThigh, latest: latestMeasurement?.leftThigh),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
-                        )
-                        MeasurementRow(
-                            label: "Thighs (R)",
-                            value: latestMeasurement?.rightThigh ?? 0,
-                            difference: calculateDifference(earliest: earliestMeasurement?.rightThigh, latest: latestMeasurement?.rightThigh),
-                            showDifference: hasMultipleEntries,
-                            useMetric: userProfile?.useMetric ?? false
+                            customText: DateFormatter.mediumDate.string(from: series.latestDate ?? clock.today)
                         )
+                        // Latest and change since the first time each metric was measured
+                        ForEach(BodyMetric.allCases) { metric in
+                            let stats = series.stats(metric)
+                            MeasurementRow(
+                                label: metric.label,
+                                value: unit.fromCentimeters(stats.latest ?? 0),
+                                difference: stats.change.map(unit.fromCentimeters),
+                                showDifference: stats.count > 1,
+                                useMetric: useMetric
+                            )
+                        }
+                        if let ratio = series.waistToHipStats.latest {
+                            MeasurementRow(
+                                label: "Waist/Hip",
+                                value: 0,
+                                difference: nil,
+                                showDifference: false,
+                                useMetric: useMetric,
+                                customText: String(format: "%.2f", ratio)
+                            )
+                        }
                     }
                     .frame(maxWidth: .infinity, alignment: .leading)
                 }
@@ -111,11 +78,15 @@ struct BodyMeasurementView: View {
                 .frame(maxWidth: 340) // Approx width: image (100) + spacing (15) + text (label 80 + value ~145) = ~340
                 .padding(.top, 40) // Push content down from top label bar
                 
-                if allZero {
+                if series.latestIsBlank {
                     Text("Enter your measurements")
                         .font(.subheadline)
                         .foregroundColor(Styles.secondaryText)
                         .padding(.bottom, 5)
+                } else if series.count > 1 {
+                    MeasurementTrendChart(series: series, metric: $chartMetric, unit: unit)
+                        .frame(maxWidth: 340)
+                        .padding(.bottom, 15)
                 }
             }
             .frame(maxWidth: .infinity) // Ensure VStack fills available width for centering
@@ -139,17 +110,79 @@ struct BodyMeasurementView: View {
             .zIndex(1)
         }
     }
+}
+
+// One metric over time, read from its column of the series, with the least-squares rate per week
+struct MeasurementTrendChart: View {
+    let series: MeasurementSeries
+    @Binding var metric: BodyMetric
+    let unit: LengthUnit
     
-    private func dateString(for date: Date?) -> String {
-        let formatter = DateFormatter()
-        formatter.dateStyle = .medium
-        formatter.timeStyle = .none
-        return formatter.string(from: date ?? simulatedCurrentDate)
-    }
-    
-    private func calculateDifference(earliest: Double?, latest: Double?) -> Double? {
-        guard let earliest = earliest, let latest = latest else { return nil }
-        return latest - earliest
+    var body: some View {
+        let values = series.values(metric)
+        let stats = series.stats(metric)
+        VStack(alignment: .leading, spacing: 8) {
+            HStack {
+                Picker("Measurement", selection: $metric) {
+                    ForEach(BodyMetric.allCases) { metric in
+                        Text(metric.label).tag(metric)
+                    }
+                }
+                .pickerStyle(.menu)
+                .tint(Styles.primaryText)
+                Spacer()
+                if let rate = stats.ratePerWeek {
+                    Text(String(format: "%+.2f %@/wk", unit.fromCentimeters(rate), unit.shortLabel))
+                        .font(.subheadline)
+                        .foregroundColor(rate > 0 ? .red : .green)
+                }
+            }
+            if stats.count > 1 {
+                let padding = max((stats.maximum - stats.minimum) * 0.1, 1)
+                Chart {
+                    ForEach(series.dates.indices, id: \.self) { index in
+                        if !values[index].isNaN {
+                            LineMark(
+                                x: .value("Date", series.dates[index]),
+                                y: .value(metric.label, unit.fromCentimeters(values[index]))
+                            )
+                            .foregroundStyle(.blue)
+                            PointMark(
+                                x: .value("Date", series.dates[index]),
+                                y: .value(metric.label, unit.fromCentimeters(values[index]))
+                            )
+                            .foregroundStyle(.blue)
+                            .symbolSize(20)
+                        }
+                    }
+                }
+                .chartYScale(domain: unit.fromCentimeters(stats.minimum - padding)...unit.fromCentimeters(stats.maximum + padding))
+                .chartXAxis {
+                    AxisMarks(position: .bottom) { _ in
+                        AxisGridLine()
+                            .foregroundStyle(Styles.primaryText)
+                        AxisValueLabel(format: .dateTime.month(.defaultDigits).day())
+                            .foregroundStyle(Styles.primaryText)
+                    }
+                }
+                .chartYAxis {
+                    AxisMarks(position: .leading) { _ in
+                        AxisGridLine()
+                            .foregroundStyle(Styles.primaryText)
+                        AxisValueLabel()
+                            .foregroundStyle(Styles.primaryText)
+                    }
+                }
+                .frame(height: 160)
+            } else {
+                Text("Two measurements are needed for a trend")
+                    .font(.subheadline)
+                    .foregroundColor(Styles.secondaryText)
+            }
+        }
+        .padding()
+        .background(Styles.primaryBackground)
+        .cornerRadius(8)
     }
 }
 
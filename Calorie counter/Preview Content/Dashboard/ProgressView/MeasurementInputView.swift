@@ -217,26 +217,24 @@ struct MeasurementInputView: View {
             return
         }
         
-        print("DEBUG: Saving for user: \(userProfile.name ?? "unknown"), ID: \(userProfile.objectID.uriRepresentation())")
-        print("DEBUG: Input values - Chest: \(chest), Waist: \(waist), Hips: \(hips), LeftArm: \(leftArm), RightArm: \(rightArm), LeftThigh: \(leftThigh), RightThigh: \(rightThigh)")
-        
+        // The tape picker works in inches; the store is always centimetres
+        let inches = LengthUnit.inches
         let measurement = BodyMeasurement(context: viewContext)
-        measurement.chest = userProfile.useMetric ? chest * 2.54 : chest
-        measurement.waist = userProfile.useMetric ? waist * 2.54 : waist
-        measurement.hips = userProfile.useMetric ? hips * 2.54 : hips
-        measurement.leftArm = userProfile.useMetric ? leftArm * 2.54 : leftArm
-        measurement.rightArm = userProfile.useMetric ? rightArm * 2.54 : rightArm
-        measurement.leftThigh = userProfile.useMetric ? leftThigh * 2.54 : leftThigh
-        measurement.rightThigh = userProfile.useMetric ? rightThigh * 2.54 : rightThigh
-        measurement.date = Date()
+        measurement.chest = inches.toCentimeters(chest)
+        measurement.waist = inches.toCentimeters(waist)
+        measurement.hips = inches.toCentimeters(hips)
+        measurement.leftArm = inches.toCentimeters(leftArm)
+        measurement.rightArm = inches.toCentimeters(rightArm)
+        measurement.leftThigh = inches.toCentimeters(leftThigh)
+        measurement.rightThigh = inches.toCentimeters(rightThigh)
+        measurement.date = AppClock.shared.now
         measurement.userProfile = userProfile
         
         do {
             try viewContext.save()
-            let unit = userProfile.useMetric ? "cm" : "in"
-            print("✅ Saved BodyMeasurement - Chest: \(measurement.chest) \(unit), Date: \(measurement.date?.description ?? "nil"), ObjectID: \(measurement.objectID.uriRepresentation())")
+            AppLog.debug("Saved body measurement, chest \(measurement.chest) cm", category: .profile)
         } catch {
-            print("❌ Save error: \(error.localizedDescription)")
+            AppLog.error("Failed to save body measurement: \(error.localizedDescription)", category: .profile)
         }
     }
 }
@@ -247,14 +245,16 @@ struct MeasurementInput: View {
     let useMetric: Bool
     let isFocused: Bool
     
+    private var unit: LengthUnit { LengthUnit(useMetric: useMetric) }
+    
     var body: some View {
         HStack {
-            Text("\(label) (\(useMetric ? "cm" : "in"))")
+            Text("\(label) (\(unit.shortLabel))")
                 .font(.subheadline)
                 .foregroundColor(Styles.secondaryText)
                 .frame(width: 100, alignment: .leading)
             
-            Text(String(format: "%.2f", useMetric ? value * 2.54 : value))
+            Text(String(format: "%.2f", unit.fromCentimeters(LengthUnit.inches.toCentimeters(value))))
                 .foregroundColor(Styles.primaryText)
                 .padding(10)
                 .frame(width: 95, height: 36)
@@ -28,7 +28,15 @@ struct ProgressPictureView: View {
     @State private var isExpanded = false
     @State private var temporaryLatestPicture: ProgressPicture? = nil
     @State private var showShareSheet = false
+    @State private var shareImage: UIImage?
+    @State private var showTimelapseExport = false
     @State private var localUserProfile: UserProfile?
+    @State private var galleryPhotos: [ProgressPhotoSummary] = []
+    @State private var startPicture: UIImage?
+    @State private var latestPicture: UIImage?
+    
+    private static let prefetchCount = 8 // About one screen of gallery cells ahead
+    private static let comparisonPixelSize = 600 // Half the screen wide and 200 pt tall at 3x
     
     init(userProfile: Binding<UserProfile?>, showDeleteOptions: Binding<Bool>, onDeletePicture: @escaping (ProgressPicture) -> Void) {
         self._userProfile = userProfile
@@ -36,13 +44,12 @@ struct ProgressPictureView: View {
         self.onDeletePicture = onDeletePicture
         
         if let profile = userProfile.wrappedValue {
-            let predicate = NSPredicate(format: "userProfile == %@", profile)
-            let sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
-            _progressPictures = FetchRequest<ProgressPicture>(
-                entity: ProgressPicture.entity(),
-                sortDescriptors: sortDescriptors,
-                predicate: predicate
-            )
+            // Batched so count and .last don't load every row; the gallery strip reads galleryPhotos instead
+            let fetchRequest: NSFetchRequest<ProgressPicture> = ProgressPicture.fetchRequest()
+            fetchRequest.predicate = NSPredicate(format: "userProfile == %@", profile)
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
+            fetchRequest.fetchBatchSize = 20
+            _progressPictures = FetchRequest(fetchRequest: fetchRequest)
         } else {
             _progressPictures = FetchRequest<ProgressPicture>(
                 entity: ProgressPicture.entity(),
@@ -53,44 +60,26 @@ struct ProgressPictureView: View {
     }
     
     // Progress Picture Computed Properties
-    private var startPicture: UIImage? {
-        if let startData = effectiveUserProfile?.startPicture, let image = UIImage(data: startData) {
-            return image
-        }
-        return nil
+    // The comparison row draws startPicture and latestPicture, decoded once per id in loadComparisonPicture
+    private var startPhotoID: NSManagedObjectID? {
+        effectiveUserProfile?.startPicture != nil ? effectiveUserProfile?.objectID : nil
     }
     
-    private var latestPicture: UIImage? {
-        print("🔍 Evaluating latestPicture - temporaryLatestPicture: \(temporaryLatestPicture?.date?.description ?? "nil"), progressPictures.count: \(progressPictures.count)")
-        if let temp = temporaryLatestPicture, let imageData = temp.imageData, let image = UIImage(data: imageData) {
-            print("🔍 Returning temporaryLatestPicture: \(temp.date?.description ?? "nil")")
-            return image
-        }
-        if let latest = progressPictures.last, let imageData = latest.imageData, let image = UIImage(data: imageData) {
-            print("🔍 Returning progressPictures.last: \(latest.date?.description ?? "nil")")
-            return image
-        }
-        print("🔍 Returning nil for latestPicture")
-        return nil
+    // The start-picture stand-in has no row of its own, so it resolves to the profile
+    private var latestPhotoID: NSManagedObjectID? {
+        temporaryLatestPicture.map { $0.managedObjectContext == nil ? effectiveUserProfile?.objectID : $0.objectID } ?? progressPictures.last?.objectID
     }
     
+    private var defaultPictureAsset: AppAsset {
+        effectiveUserProfile?.gender == "man" ? .emptyManPP : .emptyWomanPP
+    }
+
     private var defaultPicture: UIImage {
-        let gender = effectiveUserProfile?.gender ?? "woman"
-        if gender == "man" {
-            if let image = UIImage(named: "Empty man PP") {
-                return image
-            } else {
-                print("❌ Error: 'Empty man PP' image not found in asset catalog")
-                return UIImage(systemName: "person.fill") ?? UIImage()
-            }
-        } else {
-            if let image = UIImage(named: "Empty woman PP") {
-                return image
-            } else {
-                print("❌ Error: 'Empty woman PP' image not found in asset catalog")
-                return UIImage(systemName: "person.fill") ?? UIImage()
-            }
+        if let image = defaultPictureAsset.uiImage {
+            return image
         }
+        print("❌ Error: '\(defaultPictureAsset.name)' image not found in asset catalog")
+        return UIImage(systemName: "person.fill") ?? UIImage()
     }
     
     private var effectiveUserProfile: UserProfile? {
@@ -119,12 +108,7 @@ struct ProgressPictureView: View {
         return progressPictures.last?.weight ?? 0 > 0 ? "\(progressPictures.last!.weight) \(effectiveUserProfile?.useMetric ?? false ? "kg" : "lbs")" : ""
     }
     
-    private var simulatedCurrentDate: Date {
-        if let savedDate = UserDefaults.standard.object(forKey: "simulatedCurrentDate") as? Date {
-            return Calendar.current.startOfDay(for: savedDate)
-        }
-        return Calendar.current.startOfDay(for: Date())
-    }
+    @ObservedObject private var clock = AppClock.shared
     
     var body: some View {
         VStack(spacing: 0) {
@@ -140,7 +124,13 @@ struct ProgressPictureView: View {
                                 .font(.title2)
                                 .foregroundColor(Styles.primaryText)
                         }
-                        Button(action: { showShareSheet = true }) {
+                        Button(action: { showTimelapseExport = true }) {
+                            Image(systemName: "film")
+                                .font(.title2)
+                                .foregroundColor(Styles.primaryText)
+                        }
+                        .disabled(effectiveUserProfile?.startPicture == nil)
+                        Button(action: presentShareCard) {
                             Image(systemName: "square.and.arrow.up")
                                 .font(.title2)
                                 .foregroundColor(Styles.primaryText)
@@ -201,7 +191,7 @@ struct ProgressPictureView: View {
                 .frame(height: 200)
                 .clipped()
                 .onTapGesture {
-                    if startPicture != nil || !progressPictures.isEmpty {
+                    if startPhotoID != nil || !progressPictures.isEmpty {
                         withAnimation {
                             isExpanded.toggle()
                             if !isExpanded { showDeleteOptions = false }
@@ -209,45 +199,51 @@ struct ProgressPictureView: View {
                     }
                 }
                 
-                if isExpanded && (startPicture != nil || !progressPictures.isEmpty) {
+                if isExpanded && (startPhotoID != nil || !progressPictures.isEmpty) {
+                    // Lazy so only visible cells exist; each cell loads its own thumbnail and drops the load when it scrolls away
                     ScrollView(.horizontal, showsIndicators: false) {
-                        HStack(spacing: 10) {
-                            if let startImage = startPicture {
+                        LazyHStack(spacing: 10) {
+                            if let profile = effectiveUserProfile, profile.startPicture != nil {
                                 ProgressPictureItem(
-                                    image: startImage,
-                                    date: effectiveUserProfile?.startDate ?? Date(),
-                                    weight: effectiveUserProfile?.startWeight ?? 0.0,
-                                    useMetric: effectiveUserProfile?.useMetric ?? false,
+                                    photoID: profile.objectID,
+                                    date: profile.startDate ?? Date(),
+                                    weight: profile.startWeight,
+                                    useMetric: profile.useMetric,
                                     showDelete: showDeleteOptions,
                                     onTap: {
-                                        let tempPicture = ProgressPicture(context: viewContext)
-                                        tempPicture.imageData = effectiveUserProfile?.startPicture
-                                        tempPicture.date = effectiveUserProfile?.startDate ?? Date()
-                                        tempPicture.weight = effectiveUserProfile?.startWeight ?? 0.0
-                                        tempPicture.userProfile = effectiveUserProfile
+                                        // Unmanaged stand-in, so selecting the start picture never inserts a row
+                                        let tempPicture = ProgressPicture(entity: ProgressPicture.entity(), insertInto: nil)
+                                        tempPicture.imageData = profile.startPicture
+                                        tempPicture.displayData = profile.startPictureDisplay
+                                        tempPicture.date = profile.startDate ?? Date()
+                                        tempPicture.weight = profile.startWeight
                                         temporaryLatestPicture = tempPicture
                                     },
                                     onDelete: { /* Start picture can't be deleted */ }
                                 )
                             }
-                            ForEach(progressPictures) { picture in
-                                if let imageData = picture.imageData, let image = UIImage(data: imageData) {
-                                    ProgressPictureItem(
-                                        image: image,
-                                        date: picture.date ?? Date(),
-                                        weight: picture.weight,
-                                        useMetric: effectiveUserProfile?.useMetric ?? false,
-                                        showDelete: showDeleteOptions,
-                                        onTap: { temporaryLatestPicture = picture },
-                                        onDelete: {
-                                            print("🔍 Deleting picture: \(picture.date?.description ?? "nil")")
-                                            temporaryLatestPicture = nil
-                                            onDeletePicture(picture)
-                                        }
-                                    )
-                                    .onLongPressGesture {
-                                        withAnimation { showDeleteOptions.toggle() }
+                            ForEach(Array(galleryPhotos.enumerated()), id: \.element.id) { index, photo in
+                                ProgressPictureItem(
+                                    photoID: photo.id,
+                                    date: photo.date ?? Date(),
+                                    weight: photo.weight,
+                                    useMetric: effectiveUserProfile?.useMetric ?? false,
+                                    showDelete: showDeleteOptions,
+                                    onTap: { temporaryLatestPicture = viewContext.object(with: photo.id) as? ProgressPicture },
+                                    onDelete: {
+                                        guard let picture = viewContext.object(with: photo.id) as? ProgressPicture else { return }
+                                        AppLog.debug("Deleting picture from \(picture.date?.description ?? "nil")", category: .images)
+                                        temporaryLatestPicture = nil
+                                        ThumbnailLoader.shared.invalidate(photo.id)
+                                        ShareCardRenderer.shared.invalidate(photoID: photo.id)
+                                        onDeletePicture(picture)
                                     }
+                                )
+                                .onLongPressGesture {
+                                    withAnimation { showDeleteOptions.toggle() }
+                                }
+                                .onAppear {
+                                    prefetchThumbnails(after: index)
                                 }
                             }
                         }
@@ -276,29 +272,72 @@ struct ProgressPictureView: View {
             } else {
                 progressPictures.nsPredicate = NSPredicate(value: false)
             }
+            Task { await loadGallery() }
+        }
+        .task(id: progressPictures.count) {
+            await loadGallery()
+        }
+        .task(id: startPhotoID) {
+            startPicture = await Self.loadComparisonPicture(startPhotoID)
+        }
+        .task(id: latestPhotoID) {
+            latestPicture = await Self.loadComparisonPicture(latestPhotoID)
         }
         .sheet(isPresented: $showShareSheet) {
-            ShareSheet(activityItems: [generateShareImage()])
+            ShareSheet(activityItems: shareImage.map { [$0] } ?? [])
+        }
+        .sheet(isPresented: $showTimelapseExport) {
+            if let profile = effectiveUserProfile {
+                TimelapseExportSheet(profileID: profile.objectID, startDate: profile.startDate, startWeight: profile.startWeight, useMetric: profile.useMetric)
+            }
         }
     }
     
     private func fetchLocalUserProfile() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
+        if let profile = ProfileStore.shared.managedProfile {
+            localUserProfile = profile
+            userProfile = profile
+            print("✅ Loaded local user profile: \(profile.name ?? "Unknown")")
+        } else {
+            print("⚠️ No UserProfile found in Core Data")
+        }
+    }
+    
+    // Dates and weights only; thumbnails are fetched per visible cell by ThumbnailLoader
+    private func loadGallery() async {
+        guard let profileID = effectiveUserProfile?.objectID, !profileID.isTemporaryID else {
+            galleryPhotos = []
+            return
+        }
         do {
-            let profiles = try viewContext.fetch(fetchRequest)
-            if let profile = profiles.first {
-                localUserProfile = profile
-                userProfile = profile
-                print("✅ Fetched local user profile: \(profile.name ?? "Unknown")")
-            } else {
-                print("⚠️ No UserProfile found in Core Data")
-            }
+            galleryPhotos = try await DataRepository.shared.progressPhotos(for: profileID)
+        } catch {
+            AppLog.error("Failed to load progress gallery: \(error.localizedDescription)", category: .images)
+        }
+    }
+    
+    // The display rendition, downsampled off the main thread to the size the comparison row draws
+    private static func loadComparisonPicture(_ objectID: NSManagedObjectID?) async -> UIImage? {
+        guard let objectID = objectID, !objectID.isTemporaryID else { return nil }
+        do {
+            guard let data = try await DataRepository.shared.photoData(objectID, size: .display) else { return nil }
+            try Task.checkCancellation()
+            return await Task.detached(priority: .userInitiated) {
+                PhotoIngest.thumbnailImage(from: data, maxPixelSize: Self.comparisonPixelSize)
+            }.value
+        } catch is CancellationError {
+            return nil
         } catch {
-            print("❌ Error fetching local user profile: \(error.localizedDescription)")
+            AppLog.error("Failed to load comparison picture: \(error.localizedDescription)", category: .images)
+            return nil
         }
     }
     
+    private func prefetchThumbnails(after index: Int) {
+        let window = galleryPhotos.indices.dropFirst(index + 1).prefix(Self.prefetchCount)
+        ThumbnailLoader.shared.prefetch(window.map { galleryPhotos[$0].id })
+    }
+    
     private func saveProgressPicture(from photoItem: PhotosPickerItem?) {
         guard let photoItem = photoItem, let profile = effectiveUserProfile else {
             print("❌ No photo item or effective user profile available")
@@ -306,18 +345,19 @@ struct ProgressPictureView: View {
         }
         Task {
             do {
-                if let data = try await photoItem.loadTransferable(type: Data.self),
-                   let _ = UIImage(data: data) {
-                    let currentDate = simulatedCurrentDate
+                // The picker hands back the original file; only the transcoded renditions are kept
+                if let data = try await photoItem.loadTransferable(type: Data.self) {
+                    let renditions = try await PhotoIngest.renditions(from: data)
+                    let currentDate = clock.today
                     let currentWeight = profile.currentWeight
                     if profile.startPicture == nil {
-                        profile.startPicture = data
+                        profile.storeStartPicture(renditions)
                         profile.startDate = currentDate
                         profile.startWeight = currentWeight
                         print("✅ Saved start picture for \(profile.name ?? "Unknown")")
                     } else {
                         let newPicture = ProgressPicture(context: viewContext)
-                        newPicture.imageData = data
+                        newPicture.store(renditions)
                         newPicture.date = currentDate
                         newPicture.weight = currentWeight
                         newPicture.userProfile = profile
@@ -332,142 +372,40 @@ struct ProgressPictureView: View {
         }
     }
     
-    // Helper function to crop an image to a square
-    private func cropToSquare(_ image: UIImage, size: CGFloat) -> UIImage {
-        let originalSize = image.size
-        let shortestSide = min(originalSize.width, originalSize.height)
-        let scaleFactor = size / shortestSide
-        
-        let newWidth = originalSize.width * scaleFactor
-        let newHeight = originalSize.height * scaleFactor
-        let cropSize = min(newWidth, newHeight)
-        
-        let xOffset = (newWidth - cropSize) / 2
-        let yOffset = (newHeight - cropSize) / 2
+    // Everything the share card shows; the photos themselves are loaded by the renderer
+    private var shareCardInput: ShareCardInput {
+        let profile = effectiveUserProfile
+        let startDate = profile?.startDate ?? clock.now
+        let latestDate = temporaryLatestPicture?.date ?? progressPictures.last?.date ?? clock.now
+        let daysBetween = clock.calendar.dateComponents([.day], from: startDate, to: latestDate).day ?? 0
         
-        let cropRect = CGRect(x: xOffset, y: yOffset, width: cropSize, height: cropSize)
+        let startWeight = profile?.startWeight ?? 0.0
+        let latestWeight = temporaryLatestPicture?.weight ?? progressPictures.last?.weight ?? profile?.currentWeight ?? 0.0
+        let weightDifference = latestWeight - startWeight
+        let isLoseGoal = (profile?.weekGoal ?? 0 < 0) || (profile?.goalWeight ?? 0 < startWeight)
+        let trend: ShareCardInput.WeightTrend = weightDifference == 0 ? .unchanged : ((weightDifference < 0) == isLoseGoal ? .towardGoal : .awayFromGoal)
         
-        // Use UIGraphicsImageRenderer for modern cropping
-        let renderer = UIGraphicsImageRenderer(size: CGSize(width: size, height: size))
-        let croppedImage = renderer.image { _ in
-            image.draw(in: CGRect(x: -xOffset, y: -yOffset, width: newWidth, height: newHeight))
-        }
-        
-        return croppedImage
+        return ShareCardInput(
+            startPhotoID: startPhotoID,
+            latestPhotoID: latestPhotoID,
+            placeholder: defaultPictureAsset,
+            days: daysBetween,
+            weightText: String(format: "%@%.1f %@", weightDifference > 0 ? "+" : "", weightDifference, profile?.useMetric ?? false ? "kg" : "lbs"),
+            weightTrend: trend,
+            background: PixelColor(UIColor(Styles.primaryBackground))
+        )
     }
-
-    private func generateShareImage() -> UIImage {
-        let canvasSize: CGFloat = 600
-        let imageSize: CGFloat = 300 // Square size for images (half canvas width)
-        let padding: CGFloat = 20
-        let logoHeight: CGFloat = 80 // Increased logo section height
-        let renderer = UIGraphicsImageRenderer(size: CGSize(width: canvasSize, height: canvasSize))
-        
-        let image = renderer.image { context in
-            // Background (Convert Styles.primaryBackground to UIColor)
-            UIColor(Styles.primaryBackground).setFill()
-            context.fill(CGRect(x: 0, y: 0, width: canvasSize, height: canvasSize))
-            
-            // Logo and Title (Centered Above Images, Dynamic Width)
-            let logoWidth: CGFloat = 60 // Larger logo
-            let titleText = "Calorie Counter"
-            let titleAttributes: [NSAttributedString.Key: Any] = [
-                .font: UIFont.systemFont(ofSize: 20, weight: .medium),
-                .foregroundColor: UIColor.white
-            ]
-            let titleSize = titleText.size(withAttributes: titleAttributes)
-            let overlayWidth = logoWidth + 10 + titleSize.width + 20 // Icon + spacing + title + padding
-            let overlayRect = CGRect(
-                x: (canvasSize - overlayWidth) / 2,
-                y: padding,
-                width: overlayWidth,
-                height: logoHeight
-            )
-            UIColor.black.withAlphaComponent(0.6).setFill()
-            context.fill(overlayRect) // Standard fill without rounded corners
-            
-            if let appIcon = UIImage(named: "AppIcon")?.withRenderingMode(.alwaysOriginal) {
-                let iconRect = CGRect(
-                    x: (canvasSize - overlayWidth) / 2 + 10,
-                    y: padding + 10,
-                    width: logoWidth,
-                    height: logoWidth
-                )
-                appIcon.draw(in: iconRect)
-            }
-            
-            let titleRect = CGRect(
-                x: (canvasSize - overlayWidth) / 2 + logoWidth + 20,
-                y: padding + (logoHeight - titleSize.height) / 2,
-                width: titleSize.width,
-                height: titleSize.height
-            )
-            titleText.draw(in: titleRect, withAttributes: titleAttributes)
-            
-            // Images (Shifted Down, Cropped to Square, No Space Between)
-            let imageYPosition = padding + logoHeight + padding // Top of images after logo
-            let leftImage = cropToSquare(startPicture ?? defaultPicture, size: imageSize)
-            let leftRect = CGRect(
-                x: 0,
-                y: imageYPosition,
-                width: imageSize,
-                height: imageSize
-            )
-            leftImage.draw(in: leftRect, blendMode: .normal, alpha: 1.0)
-            
-            let rightImage = cropToSquare(latestPicture ?? defaultPicture, size: imageSize)
-            let rightRect = CGRect(
-                x: imageSize, // Directly adjacent to left image
-                y: imageYPosition,
-                width: imageSize,
-                height: imageSize
-            )
-            rightImage.draw(in: rightRect, blendMode: .normal, alpha: 1.0)
-            
-            // Calculate Days Between (Left Below Images)
-            let startDate = effectiveUserProfile?.startDate ?? Date()
-            let latestDate = temporaryLatestPicture?.date ?? progressPictures.last?.date ?? Date()
-            let daysBetween = Calendar.current.dateComponents([.day], from: startDate, to: latestDate).day ?? 0
-            let daysText = "\(daysBetween) Days"
-            let daysAttributes: [NSAttributedString.Key: Any] = [
-                .font: UIFont.systemFont(ofSize: 48, weight: .regular),
-                .foregroundColor: UIColor.black
-            ]
-            let daysSize = daysText.size(withAttributes: daysAttributes)
-            let daysRect = CGRect(
-                x: padding,
-                y: imageYPosition + imageSize + padding,
-                width: daysSize.width,
-                height: daysSize.height
-            )
-            daysText.draw(in: daysRect, withAttributes: daysAttributes)
-            
-            // Calculate Weight Difference (Right Below Images)
-            let startWeight = effectiveUserProfile?.startWeight ?? 0.0
-            let latestWeight = temporaryLatestPicture?.weight ?? progressPictures.last?.weight ?? effectiveUserProfile?.currentWeight ?? 0.0
-            let weightDifference = latestWeight - startWeight
-            let isLoseGoal = (effectiveUserProfile?.weekGoal ?? 0 < 0) || (effectiveUserProfile?.goalWeight ?? 0 < startWeight)
-            let weightColor: UIColor = weightDifference == 0 ? .gray : (isLoseGoal ? (weightDifference > 0 ? .red : .green) : (weightDifference > 0 ? .green : .red))
-            let weightText = String(format: "%@%.1f %@", weightDifference > 0 ? "+" : "", weightDifference, effectiveUserProfile?.useMetric ?? false ? "kg" : "lbs")
-            let weightAttributes: [NSAttributedString.Key: Any] = [
-                .font: UIFont.systemFont(ofSize: 48, weight: .bold),
-                .foregroundColor: weightColor
-            ]
-            let weightSize = weightText.size(withAttributes: weightAttributes)
-            let weightRect = CGRect(
-                x: canvasSize - padding - weightSize.width,
-                y: imageYPosition + imageSize + padding,
-                width: weightSize.width,
-                height: weightSize.height
-            )
-            weightText.draw(in: weightRect, withAttributes: weightAttributes)
+    
+    private func presentShareCard() {
+        let input = shareCardInput
+        Task {
+            shareImage = await ShareCardRenderer.shared.card(for: input)
+            showShareSheet = true
         }
-        
-        return image
     }
     
     struct ProgressPictureItem: View {
-        let image: UIImage
+        let photoID: NSManagedObjectID // A ProgressPicture, or the UserProfile for the start picture
         let date: Date
         let weight: Double
         let useMetric: Bool
@@ -475,18 +413,26 @@ struct ProgressPictureView: View {
         let onTap: () -> Void
         let onDelete: () -> Void
         
+        @State private var image: UIImage?
+        
         private var formattedDate: String { DateFormatter.mediumDate.string(from: date) }
         private var formattedWeight: String { weight > 0 ? "\(weight) \(useMetric ? "kg" : "lbs")" : "N/A" }
         
         var body: some View {
             VStack(spacing: 5) {
                 ZStack {
-                    Image(uiImage: image)
-                        .resizable()
-                        .scaledToFill()
-                        .frame(width: 100, height: 100)
-                        .clipped()
-                        .onTapGesture(perform: onTap)
+                    Group {
+                        if let image = image {
+                            Image(uiImage: image)
+                                .resizable()
+                                .scaledToFill()
+                        } else {
+                            Styles.tertiaryBackground
+                        }
+                    }
+                    .frame(width: 100, height: 100)
+                    .clipped()
+                    .onTapGesture(perform: onTap)
                     
                     if showDelete {
                         Color.black.opacity(0.5)
@@ -506,6 +452,84 @@ struct ProgressPictureView: View {
                     .font(.caption)
                     .foregroundColor(Styles.primaryText)
             }
+            .task(id: photoID) {
+                image = await ThumbnailLoader.shared.image(for: photoID)
+            }
+        }
+    }
+    
+    // Format choice, then a cancellable export with progress; the finished file goes to the share sheet
+    struct TimelapseExportSheet: View {
+        let profileID: NSManagedObjectID
+        let startDate: Date?
+        let startWeight: Double
+        let useMetric: Bool
+        
+        @Environment(\.dismiss) private var dismiss
+        @State private var format: TimelapseFormat = .gif
+        @State private var progress: Double = 0
+        @State private var exportTask: Task<Void, Never>?
+        @State private var exportedURL: URL?
+        @State private var errorMessage: String?
+        
+        var body: some View {
+            VStack(spacing: 20) {
+                Text("Progress Timelapse")
+                    .font(.headline)
+                    .foregroundColor(Styles.primaryText)
+                Picker("Format", selection: $format) {
+                    ForEach(TimelapseFormat.allCases) { format in
+                        Text(format.rawValue).tag(format)
+                    }
+                }
+                .pickerStyle(.segmented)
+                .disabled(exportTask != nil)
+                
+                if exportTask != nil {
+                    SwiftUI.ProgressView(value: progress)
+                    Button("Cancel", role: .cancel) {
+                        exportTask?.cancel()
+                    }
+                } else {
+                    Button("Create Timelapse", action: startExport)
+                        .buttonStyle(.borderedProminent)
+                }
+                if let errorMessage = errorMessage {
+                    Text(errorMessage)
+                        .font(.caption)
+                        .foregroundColor(.red)
+                        .multilineTextAlignment(.center)
+                }
+            }
+            .padding()
+            .frame(maxWidth: .infinity, maxHeight: .infinity)
+            .background(Styles.secondaryBackground)
+            .sheet(isPresented: Binding(get: { exportedURL != nil }, set: { if !$0 { exportedURL = nil } })) {
+                ShareSheet(activityItems: exportedURL.map { [$0] } ?? [])
+            }
+            .onDisappear {
+                exportTask?.cancel()
+            }
+        }
+        
+        private func startExport() {
+            errorMessage = nil
+            progress = 0
+            let request = TimelapseRequest(profileID: profileID, startDate: startDate, startWeight: startWeight, useMetric: useMetric, format: format)
+            exportTask = Task {
+                do {
+                    exportedURL = try await TimelapseExporter.shared.export(request) { fraction in
+                        DispatchQueue.main.async { progress = fraction }
+                    }
+                    AppLog.info("Exported progress timelapse", category: .images)
+                } catch is CancellationError {
+                    AppLog.debug("Timelapse export cancelled", category: .images)
+                } catch {
+                    errorMessage = error.localizedDescription
+                    AppLog.error("Timelapse export failed: \(error.localizedDescription)", category: .images)
+                }
+                exportTask = nil
+            }
         }
     }
     
@@ -12,7 +12,7 @@ import Charts
 
 struct WeightProgressView: View {
     @Binding var userProfile: UserProfile?
-    @Binding var dailyRecords: [DailyRecord]
+    @Binding var dailyWeights: [WeighInSample]
     
     // Weight Section Computed Properties
     private var goalMessage: String {
@@ -22,10 +22,9 @@ struct WeightProgressView: View {
     
     private var weightData: [(date: Date, weight: Double)] {
         var data = [(date: userProfile?.startDate ?? Date(), weight: userProfile?.startWeight ?? 0.0)]
-        data.append(contentsOf: dailyRecords.compactMap { record in
-            guard let date = record.date else { return nil }
-            let weight = record.weighIn > 0 ? record.weighIn : (userProfile?.currentWeight ?? 0.0)
-            return (date: date, weight: weight)
+        data.append(contentsOf: dailyWeights.map { sample in
+            let weight = sample.weight > 0 ? sample.weight : (userProfile?.currentWeight ?? 0.0)
+            return (date: sample.timestamp, weight: weight)
         }.sorted { $0.date < $1.date })
         return data
     }
@@ -146,8 +145,8 @@ struct WeightProgressView: View {
         let adjustedMinWeight = minWeight - 5
         let adjustedMaxWeight = maxWeight + 5
         
-        let today = Date()
-        let futureDates = (0...5).map { Calendar.current.date(byAdding: .day, value: $0, to: today)! }
+        let today = AppClock.shared.now
+        let futureDates = (0...5).map { AppClock.shared.calendar.date(byAdding: .day, value: $0, to: today)! }
         
         var displayData: [(date: Date, weight: Double)]
         if hasData && weightData.count >= 5 {
@@ -250,6 +249,6 @@ struct WeightProgressView: View {
 
 struct WeightProgressView_Previews: PreviewProvider {
     static var previews: some View {
-        WeightProgressView(userProfile: .constant(nil), dailyRecords: .constant([]))
+        WeightProgressView(userProfile: .constant(nil), dailyWeights: .constant([]))
     }
 }
@@ -6,21 +6,217 @@
 //
 
 import SwiftUI
+import UniformTypeIdentifiers
 
 struct SettingsView: View {
+    @State private var transferTask: Task<Void, Never>?
+    @State private var progress: Double = 0
+    @State private var exportedURLs: [URL] = []
+    @State private var showImporter = false
+    @State private var statusMessage: String?
+    @State private var errorMessage: String?
+    @State private var lastBackup: Date?
+    @State private var showRestoreConfirmation = false
+
     var body: some View {
-        VStack {
+        VStack(spacing: 20) {
             Text("Settings")
                 .font(.largeTitle)
                 .fontWeight(.bold)
                 .foregroundColor(Styles.primaryText)
                 .padding()
 
+            VStack(alignment: .leading, spacing: 12) {
+                Text("Your Data")
+                    .font(.headline)
+                    .foregroundColor(Styles.primaryText)
+                Text("Export your whole history, or import a food diary from another app as CSV.")
+                    .font(.caption)
+                    .foregroundColor(Styles.secondaryText)
+
+                if transferTask != nil {
+                    SwiftUI.ProgressView(value: progress)
+                } else {
+                    HStack {
+                        ForEach(DataExporter.Format.allCases) { format in
+                            Button("Export \(format.rawValue)") {
+                                startExport(format)
+                            }
+                            .buttonStyle(.bordered)
+                        }
+                    }
+                    Button("Import Food Diary") {
+                        showImporter = true
+                    }
+                    .buttonStyle(.borderedProminent)
+                }
+
+                Divider()
+                Text(lastBackup.map { "Last backup: \(DateFormatter.mediumDate.string(from: $0))" } ?? "No backups yet")
+                    .font(.caption)
+                    .foregroundColor(Styles.secondaryText)
+                if transferTask == nil {
+                    HStack {
+                        Button("Back Up Now", action: startBackup)
+                            .buttonStyle(.bordered)
+                        Button("Restore Backup", role: .destructive) {
+                            showRestoreConfirmation = true
+                        }
+                        .buttonStyle(.bordered)
+                        .disabled(lastBackup == nil)
+                    }
+                    Button("Tidy Up Storage", action: startMaintenance)
+                        .buttonStyle(.bordered)
+                }
+
+                if let statusMessage = statusMessage {
+                    Text(statusMessage)
+                        .font(.caption)
+                        .foregroundColor(Styles.secondaryText)
+                }
+                if let errorMessage = errorMessage {
+                    Text(errorMessage)
+                        .font(.caption)
+                        .foregroundColor(.red)
+                }
+            }
+            .padding()
+            .frame(maxWidth: .infinity, alignment: .leading)
+            .background(Styles.secondaryBackground)
+            .cornerRadius(12)
+            .padding(.horizontal)
+
             Spacer()
         }
         .frame(maxWidth: .infinity, maxHeight: .infinity)
         .background(Styles.primaryBackground)
         .ignoresSafeArea()
+        .fileImporter(isPresented: $showImporter, allowedContentTypes: [.commaSeparatedText, .plainText]) { result in
+            switch result {
+            case .success(let url):
+                startImport(url)
+            case .failure(let error):
+                errorMessage = error.localizedDescription
+            }
+        }
+        .sheet(isPresented: Binding(get: { !exportedURLs.isEmpty }, set: { if !$0 { exportedURLs = [] } })) {
+            ProgressPictureView.ShareSheet(activityItems: exportedURLs)
+        }
+        .alert("Restore Backup?", isPresented: $showRestoreConfirmation) {
+            Button("Restore", role: .destructive, action: startRestore)
+            Button("Cancel", role: .cancel) {}
+        } message: {
+            Text("Everything logged since the last backup will be replaced.")
+        }
+        .onAppear {
+            lastBackup = StoreBackup.shared.latestBackupDate
+        }
+    }
+
+    private func startBackup() {
+        errorMessage = nil
+        statusMessage = nil
+        transferTask = Task {
+            do {
+                let stats = try await StoreBackup.shared.backUp()
+                lastBackup = StoreBackup.shared.latestBackupDate
+                statusMessage = "Backed up \(ByteCountFormatter.string(fromByteCount: Int64(stats.bytesWritten), countStyle: .file)) of changes."
+                AppLog.info("Backed up store, \(stats.newChunks) new chunk(s)", category: .persistence)
+            } catch {
+                errorMessage = error.localizedDescription
+                AppLog.error("Store backup failed: \(error.localizedDescription)", category: .persistence)
+            }
+            transferTask = nil
+        }
     }
-}
 
+    private func startRestore() {
+        errorMessage = nil
+        statusMessage = nil
+        transferTask = Task {
+            do {
+                let date = try await StoreBackup.shared.restoreLatest()
+                // Roll the restored store forward to today and rebuild the history archive
+                await RolloverProcessor.shared.catchUp()
+                await RolloverProcessor.shared.archiveClosedDays()
+                // The caches below were filled from the store the restore replaced
+                await MainActor.run {
+                    ProfileStore.shared.reload()
+                    WorkoutStatsIndex.shared.reload()
+                    ActivityRegistry.shared.reload()
+                    DiaryFeed.shared.reload()
+                }
+                statusMessage = "Restored the backup from \(DateFormatter.mediumDate.string(from: date))."
+                AppLog.info("Restored store from backup", category: .persistence)
+            } catch {
+                errorMessage = error.localizedDescription
+                AppLog.error("Backup restore failed: \(error.localizedDescription)", category: .persistence)
+            }
+            transferTask = nil
+        }
+    }
+
+    private func startMaintenance() {
+        errorMessage = nil
+        statusMessage = nil
+        transferTask = Task {
+            do {
+                let report = try await StoreMaintenance.shared.run()
+                var message = "Merged \(report.duplicateDaysMerged) duplicate days and removed \(report.orphansRemoved) stray entries, freeing \(ByteCountFormatter.string(fromByteCount: report.bytesReclaimed, countStyle: .file))."
+                if report.compactionScheduled {
+                    message += " \(ByteCountFormatter.string(fromByteCount: report.freeBytes, countStyle: .file)) more will be reclaimed the next time the app starts."
+                }
+                statusMessage = message
+                AppLog.info(message, category: .persistence)
+            } catch {
+                errorMessage = error.localizedDescription
+                AppLog.error("Storage tidy-up failed: \(error.localizedDescription)", category: .persistence)
+            }
+            transferTask = nil
+        }
+    }
+
+    private func startExport(_ format: DataExporter.Format) {
+        errorMessage = nil
+        statusMessage = nil
+        progress = 0
+        transferTask = Task {
+            do {
+                exportedURLs = try await DataExporter.shared.export(format) { fraction in
+                    DispatchQueue.main.async { progress = fraction }
+                }
+                AppLog.info("Exported history as \(format.rawValue)", category: .persistence)
+            } catch {
+                errorMessage = error.localizedDescription
+                AppLog.error("History export failed: \(error.localizedDescription)", category: .persistence)
+            }
+            transferTask = nil
+        }
+    }
+
+    private func startImport(_ url: URL) {
+        errorMessage = nil
+        statusMessage = nil
+        progress = 0
+        transferTask = Task {
+            do {
+                let summary = try await DiaryImporter.shared.importDiary(from: url) { fraction in
+                    DispatchQueue.main.async { progress = fraction }
+                }
+                var message = "Imported \(summary.foods) foods over \(summary.days) days from \(summary.source.rawValue)."
+                if summary.duplicates > 0 {
+                    message += " \(summary.duplicates) already in your diary."
+                }
+                if summary.skippedRows > 0 {
+                    message += " \(summary.skippedRows) rows couldn't be read."
+                }
+                statusMessage = message
+                AppLog.info(message, category: .persistence)
+            } catch {
+                errorMessage = error.localizedDescription
+                AppLog.error("Diary import failed: \(error.localizedDescription)", category: .persistence)
+            }
+            transferTask = nil
+        }
+    }
+}
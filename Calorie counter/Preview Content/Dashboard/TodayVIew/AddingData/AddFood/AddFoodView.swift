@@ -137,6 +137,7 @@ struct AddFoodView: View {
             .background(Styles.secondaryBackground)
             .edgesIgnoringSafeArea(.all)
         }
+        .profilingScreen("Add Food")
     }
     
     private func tabButton(title: String, selected: Bool, action: @escaping () -> Void) -> some View {
@@ -153,62 +154,46 @@ struct AddFoodView: View {
     }
     
     private func searchFood(query: String) {
-        guard let encodedQuery = query.addingPercentEncoding(withAllowedCharacters: .urlQueryAllowed) else {
-            print("Failed to encode query: \(query)")
+        guard let url = FoodSearch.url(for: query) else {
+            AppLog.warning("Failed to build search URL for query: \(query)", category: .network)
             return
         }
         
-        // Use V1 search endpoint for better full-text search support
-        let urlString = "https://world.openfoodfacts.org/cgi/search.pl?search_terms=\(encodedQuery)&search_simple=1&action=process&json=1&page_size=5"
-        guard let url = URL(string: urlString) else {
-            print("Invalid URL: \(urlString)")
-            return
-        }
-        
-        print("Searching with URL: \(urlString)")
+        AppLog.debug("Searching with URL: \(url.absoluteString)", category: .network)
+        let request = AppLog.beginInterval("Food search", category: .network, counter: .networkRequests, detail: query)
         
         URLSession.shared.dataTask(with: url) { data, response, error in
+            request.end()
             if let error = error {
-                print("Network error: \(error.localizedDescription)")
+                AppLog.error("Network error: \(error.localizedDescription)", category: .network)
                 return
             }
             
             guard let data = data else {
-                print("No data received")
+                AppLog.warning("No data received", category: .network)
                 return
             }
             
-            // Log raw response
-            if let jsonString = String(data: data, encoding: .utf8) {
-                print("Raw response: \(jsonString)")
-            }
+            AppLog.debug("Search response: \(data.count) bytes", category: .network)
             
             do {
-                if let json = try JSONSerialization.jsonObject(with: data, options: []) as? [String: Any],
-                   let products = json["products"] as? [[String: Any]] {
-                    let results = products.compactMap { product -> FoodItem? in
-                        guard let name = product["product_name"] as? String,
-                              let barcode = product["code"] as? String,
-                              !name.isEmpty, !barcode.isEmpty else {
-                            return nil
-                        }
-                        return FoodItem(name: name, barcode: barcode)
-                    }
+                if let products = try FoodSearch.results(from: data) {
+                    let results = products.map { FoodItem(name: $0.name, barcode: $0.barcode) }
                     
                     DispatchQueue.main.async {
                         withAnimation {
                             searchResults = results
-                            print("Updated results: \(results.map { $0.name })")
+                            AppLog.debug("Updated results: \(results.map { $0.name })", category: .network)
                         }
                     }
                 } else {
-                    print("No valid products found in response")
+                    AppLog.debug("No valid products found in response", category: .network)
                     DispatchQueue.main.async {
                         searchResults = []
                     }
                 }
             } catch {
-                print("JSON parsing error: \(error.localizedDescription)")
+                AppLog.error("JSON parsing error: \(error.localizedDescription)", category: .network)
                 DispatchQueue.main.async {
                     searchResults = []
                 }
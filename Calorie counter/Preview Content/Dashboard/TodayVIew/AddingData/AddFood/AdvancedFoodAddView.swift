@@ -13,7 +13,7 @@ struct AdvancedFoodAddView: View {
     var closeAction: () -> Void
     var initialBarcode: String? // New parameter for barcode from search
 
-    @State private var foodImage: UIImage? = UIImage(named: "DefaultFood")
+    @State private var foodImage: UIImage? = AppAsset.defaultFood.uiImage
     @State private var foodName: String = ""
     @State private var servingSizeAmount: String = ""
     @State private var servingSizeUnit: String = "g"
@@ -57,9 +57,9 @@ struct AdvancedFoodAddView: View {
     @State private var baseIron: Double = 0
     @State private var baseSodium: Double = 0
 
-    @State private var selectedHour: Int = Calendar.current.component(.hour, from: Date()) % 12
-    @State private var selectedMinute: Int = Calendar.current.component(.minute, from: Date())
-    @State private var selectedPeriod: String = Calendar.current.component(.hour, from: Date()) >= 12 ? "PM" : "AM"
+    @State private var selectedHour: Int = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) % 12
+    @State private var selectedMinute: Int = AppClock.shared.calendar.component(.minute, from: AppClock.shared.now)
+    @State private var selectedPeriod: String = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) >= 12 ? "PM" : "AM"
     @State private var showTimePicker: Bool = false
 
     @State private var showImagePicker: Bool = false
@@ -111,10 +111,10 @@ struct AdvancedFoodAddView: View {
             HStack(spacing: 20) {
                 ZStack {
                     RoundedRectangle(cornerRadius: 10)
-                        .stroke(foodImage != UIImage(named: "DefaultFood") ? Color.green : Styles.primaryText, lineWidth: 3)
+                        .stroke(foodImage != AppAsset.defaultFood.uiImage ? Color.green : Styles.primaryText, lineWidth: 3)
                         .frame(width: 100, height: 100)
 
-                    Image(uiImage: foodImage ?? UIImage(named: "DefaultFood")!)
+                    Image(uiImage: foodImage ?? AppAsset.defaultFood.uiImage!)
                         .resizable()
                         .scaledToFill()
                         .frame(width: 100, height: 100)
@@ -141,7 +141,7 @@ struct AdvancedFoodAddView: View {
                                     showImagePicker = true
                                 },
                                 .destructive(Text("Remove Image")) {
-                                    foodImage = UIImage(named: "DefaultFood")
+                                    foodImage = AppAsset.defaultFood.uiImage
                                 },
                                 .cancel()
                             ]
@@ -1020,7 +1020,7 @@ struct AdvancedFoodAddView: View {
     private func loadImage(from urlString: String) {
         guard let url = URL(string: urlString) else { return }
         URLSession.shared.dataTask(with: url) { data, response, error in
-            guard let data = data, error == nil, let image = UIImage(data: data) else {
+            guard let data = data, error == nil, let image = UIImage.decoded(from: data) else {
                 print("Error loading image: \(error?.localizedDescription ?? "Unknown error")")
                 return
             }
@@ -1128,13 +1128,13 @@ struct AdvancedFoodAddView: View {
         }
         
         let newEntry = DiaryEntry(
-            time: formattedTime,
-            iconName: foodImage != UIImage(named: "DefaultFood") ? "CustomFood" : "DefaultFood",
+            timestamp: entryTimestamp(hour: selectedHour, minute: selectedMinute, period: selectedPeriod),
+            iconName: foodImage != AppAsset.defaultFood.uiImage ? "CustomFood" : AppAsset.defaultFood.name,
             description: foodName,
             detail: "\(servingConsumedAmount) \(servingSizeUnit)",
             calories: Int(calories),
             type: "Food",
-            imageName: "DefaultFood",
+            imageName: AppAsset.defaultFood.name,
             imageData: foodImage?.jpegData(compressionQuality: 0.8),
             fats: fats,
             carbs: carbohydrates,
@@ -1213,7 +1213,7 @@ struct AdvancedFoodAddView: View {
                         .frame(width: 80, height: 80)
                         .shadow(radius: 5)
 
-                    Image("BarCode")
+                    AppAsset.barCode.image
                         .resizable()
                         .scaledToFit()
                         .frame(width: 40, height: 40)
@@ -18,14 +18,14 @@ struct QuickFoodAddView: View {
     @Binding var diaryEntries: [DiaryEntry] // ✅ Binding to update the diary
     var closeAction: () -> Void // ✅ Function to close the view
 
-    @State private var foodImage: UIImage? = UIImage(named: "DefaultFood") // ✅ Default image
+    @State private var foodImage: UIImage? = AppAsset.defaultFood.uiImage // ✅ Default image
     @State private var foodName: String = ""
     @State private var servingSize: String = ""
     @State private var calories: String = ""
 
-    @State private var selectedHour: Int = Calendar.current.component(.hour, from: Date()) % 12
-    @State private var selectedMinute: Int = Calendar.current.component(.minute, from: Date())
-    @State private var selectedPeriod: String = Calendar.current.component(.hour, from: Date()) >= 12 ? "PM" : "AM"
+    @State private var selectedHour: Int = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) % 12
+    @State private var selectedMinute: Int = AppClock.shared.calendar.component(.minute, from: AppClock.shared.now)
+    @State private var selectedPeriod: String = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) >= 12 ? "PM" : "AM"
     @State private var showTimePicker: Bool = false // ✅ Toggles picker visibility
 
     @State private var showImagePicker: Bool = false
@@ -38,10 +38,10 @@ struct QuickFoodAddView: View {
             HStack(spacing: 20) {
                 ZStack {
                     RoundedRectangle(cornerRadius: 10)
-                        .stroke(foodImage != UIImage(named: "DefaultFood") ? Color.green : Styles.primaryText, lineWidth: 3)
+                        .stroke(foodImage != AppAsset.defaultFood.uiImage ? Color.green : Styles.primaryText, lineWidth: 3)
                         .frame(width: 100, height: 100)
 
-                    Image(uiImage: foodImage ?? UIImage(named: "DefaultFood")!)
+                    Image(uiImage: foodImage ?? AppAsset.defaultFood.uiImage!)
                         .resizable()
                         .scaledToFill()
                         .frame(width: 100, height: 100)
@@ -72,7 +72,7 @@ struct QuickFoodAddView: View {
                                     }
                                 },
                                 .destructive(Text("Remove Image")) {
-                                    foodImage = UIImage(named: "DefaultFood") // ✅ Reset to default
+                                    foodImage = AppAsset.defaultFood.uiImage // ✅ Reset to default
                                 },
                                 .cancel()
                             ]
@@ -128,13 +128,13 @@ struct QuickFoodAddView: View {
         let caloriesValue = Int(calories) ?? 0
         
         let newEntry = DiaryEntry(
-            time: formattedTime,
-            iconName: foodImage != UIImage(named: "DefaultFood") ? "CustomFood" : "DefaultFood",
+            timestamp: entryTimestamp(hour: selectedHour, minute: selectedMinute, period: selectedPeriod),
+            iconName: foodImage != AppAsset.defaultFood.uiImage ? "CustomFood" : AppAsset.defaultFood.name,
             description: foodName,
             detail: servingSize,
             calories: caloriesValue,
             type: "Food",
-            imageName: "DefaultFood",
+            imageName: AppAsset.defaultFood.name,
             imageData: foodImage?.jpegData(compressionQuality: 0.8)
         )
         
@@ -148,9 +148,9 @@ struct QuickFoodAddView: View {
 
     // ✅ Automatically sets the current time
     private func setCurrentTime() {
-        let currentHour = Calendar.current.component(.hour, from: Date())
+        let currentHour = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now)
         selectedHour = currentHour % 12 == 0 ? 12 : currentHour % 12
-        selectedMinute = Calendar.current.component(.minute, from: Date())
+        selectedMinute = AppClock.shared.calendar.component(.minute, from: AppClock.shared.now)
         selectedPeriod = currentHour >= 12 ? "PM" : "AM"
     }
 
@@ -228,7 +228,7 @@ struct QuickFoodAddView: View {
                         .frame(width: 80, height: 80)
                         .shadow(radius: 5)
 
-                    Image("BarCode")
+                    AppAsset.barCode.image
                         .resizable()
                         .scaledToFit()
                         .frame(width: 40, height: 40)
@@ -51,7 +51,7 @@ struct AddWaterView: View {
 
                         // Unit Picker
                         Picker("Unit", selection: $selectedUnit) {
-                            ForEach(["Gallons", "Liters", "Milliliters", "fl oz"], id: \.self) { unit in
+                            ForEach(WaterUnit.allCases.map(\.rawValue), id: \.self) { unit in
                                 Text(unit)
                                     .foregroundColor(Styles.primaryText)
                                     .font(.system(size: 36, weight: .medium))
@@ -70,7 +70,7 @@ struct AddWaterView: View {
                     }
 
                     // ✅ Added WaterInput Image Below Picker
-                    Image("WaterInput")
+                    AppAsset.waterInput.image
                         .resizable()
                         .scaledToFit()
                         .frame(width: geometry.size.width * 0.8)
@@ -131,15 +131,18 @@ struct AddWaterView: View {
 
     // ✅ Function to Save Water Entry
     private func saveWaterEntry() {
+        let unit = WaterUnit(label: selectedUnit) ?? .flOz
+        let amountMl = unit.toMilliliters(WaterUnit.parseAmount(selectedAmount) ?? 0)
         let newEntry = DiaryEntry(
-            time: formattedCurrentTime(),
+            timestamp: currentEntryTimestamp(),
             iconName: "water", // ✅ Always use the "water" image
             description: "Water",
             detail: "\(selectedAmount) \(selectedUnit)", // ✅ Correctly formatted detail
             calories: 0,
             type: "Water",
-            imageName: "water", // ✅ **FIXED**: Added missing argument
-            imageData: nil // ✅ Water entries don't need a custom image
+            imageName: AppAsset.water.name, // ✅ **FIXED**: Added missing argument
+            imageData: nil, // ✅ Water entries don't need a custom image
+            waterAmountMl: amountMl
         )
 
         DispatchQueue.main.async {
@@ -166,11 +169,4 @@ struct AddWaterView: View {
             return []
         }
     }
-
-    // ✅ Function to get the current time in "h:mm a" format
-    private func formattedCurrentTime() -> String {
-        let formatter = DateFormatter()
-        formatter.dateFormat = "h:mm a"
-        return formatter.string(from: Date())
-    }
 }
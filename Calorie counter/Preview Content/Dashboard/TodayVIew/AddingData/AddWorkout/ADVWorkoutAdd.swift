@@ -6,27 +6,24 @@ struct ADVWorkoutAddView: View {
     @Binding var diaryEntries: [DiaryEntry]
     var closeAction: () -> Void
     
-    @State private var selectedWorkout: ActivityModel? = nil
+    @State private var selectedWorkout: ActivitySnapshot? = nil
     @State private var showingFavorites: Bool = false
     @State private var showCustomPopup: Bool = false
     
     @State private var customName: String = "Activity Name"
     @State private var customMET: Double = 5.0
     @State private var metInput: String = "5.0"
-    @State private var selectedImageName: String = "CustomActivity"
+    @State private var selectedImage: AppAsset = .customActivity
     @State private var showingImagePicker: Bool = false
     
-    @FetchRequest(
-        entity: ActivityModel.entity(),
-        sortDescriptors: [NSSortDescriptor(keyPath: \ActivityModel.name, ascending: true)]
-    ) private var activities: FetchedResults<ActivityModel>
+    @ObservedObject private var registry = ActivityRegistry.shared
     
     var body: some View {
         VStack(spacing: 0) {
             if let workout = selectedWorkout {
                 ActivityStatsView(
-                    activityName: workout.name ?? "Unknown",
-                    activityImage: workout.imageName ?? "default_image",
+                    activityName: workout.name,
+                    activityImage: AppAsset.resolving(workout.imageName, fallback: .defaultWorkout).name,
                     closeAction: { selectedWorkout = nil },
                     fullCloseAction: closeAction,
                     diaryEntries: $diaryEntries
@@ -185,7 +182,7 @@ struct ADVWorkoutAddView: View {
                                 
                                 ScrollView {
                                     LazyVGrid(columns: Array(repeating: GridItem(.flexible(), spacing: 15), count: 4), spacing: 15) {
-                                        ForEach(activities.filter { !$0.isCustom }, id: \.id) { activity in
+                                        ForEach(BuiltInActivityCatalog.all, id: \.id) { activity in
                                             imageButton(activity: activity)
                                         }
                                     }
@@ -201,10 +198,7 @@ struct ADVWorkoutAddView: View {
                             }
                         } else {
                             HStack(spacing: 10) {
-                                Image(selectedImageName)
-                                    .resizable()
-                                    .scaledToFit()
-                                    .frame(width: 50, height: 50)
+                                AssetIcon(asset: selectedImage, side: 50)
                                     .padding(8)
                                     .background(Styles.secondaryBackground)
                                     .shadow(radius: 2)
@@ -301,17 +295,15 @@ struct ADVWorkoutAddView: View {
         }
     }
     
-    private func filteredWorkouts() -> [ActivityModel] {
-        showingFavorites ? activities.filter { $0.isFavorite } : Array(activities)
+    private func filteredWorkouts() -> [ActivitySnapshot] {
+        let activities = registry.allActivities
+        return showingFavorites ? activities.filter { $0.isFavorite } : activities
     }
     
-    private func workoutButton(activity: ActivityModel, backgroundColor: Color) -> some View {
+    private func workoutButton(activity: ActivitySnapshot, backgroundColor: Color) -> some View {
         VStack {
-            Image(activity.imageName ?? "default_image")
-                .resizable()
-                .scaledToFit()
-                .frame(width: 50, height: 50)
-            Text(activity.name ?? "Unknown")
+            AssetIcon(asset: .resolving(activity.imageName, fallback: .defaultWorkout), side: 50)
+            Text(activity.name)
                 .font(.caption)
                 .foregroundColor(Styles.primaryText)
                 .multilineTextAlignment(.center)
@@ -332,12 +324,12 @@ struct ADVWorkoutAddView: View {
                 selectedWorkout = activity
             }
         }
-        .accessibilityLabel("Workout: \(activity.name ?? "Unknown")")
+        .accessibilityLabel("Workout: \(activity.name)")
     }
     
     private func addCustomActivityButton() -> some View {
         VStack {
-            Image("AddCustom")
+            AppAsset.addCustom.image
                 .resizable()
                 .scaledToFit()
                 .frame(width: 50, height: 50)
@@ -360,34 +352,31 @@ struct ADVWorkoutAddView: View {
             customName = "Activity Name"
             customMET = 5.0
             metInput = "5.0"
-            selectedImageName = "CustomActivity"
+            selectedImage = .customActivity
             showingImagePicker = false
         }
         .accessibilityLabel("Add Custom Activity")
     }
     
-    private func recentWorkouts() -> [ActivityModel] {
-        return activities
+    private func recentWorkouts() -> [ActivitySnapshot] {
+        return registry.allActivities
             .filter { $0.lastUsed != nil }
             .sorted { $0.lastUsed! > $1.lastUsed! }
             .prefix(4)
             .map { $0 }
     }
     
-    private func imageButton(activity: ActivityModel) -> some View {
-        Image(activity.imageName ?? "default_image")
-            .resizable()
-            .scaledToFit()
-            .frame(width: 50, height: 50)
+    private func imageButton(activity: BuiltInActivity) -> some View {
+        AssetIcon(asset: activity.asset, side: 50)
             .padding(8)
             .background(Styles.primaryBackground)
             .clipShape(RoundedRectangle(cornerRadius: 8))
             .shadow(radius: 2)
             .onTapGesture {
-                selectedImageName = activity.imageName ?? "CustomActivity"
+                selectedImage = activity.asset
                 showingImagePicker = false
             }
-            .accessibilityLabel("Select \(activity.name ?? "unknown") image")
+            .accessibilityLabel("Select \(activity.name) image")
     }
     
     private func metExample(for met: Double) -> String {
@@ -431,7 +420,7 @@ struct ADVWorkoutAddView: View {
         let newActivity = ActivityModel(context: viewContext)
         newActivity.id = UUID()
         newActivity.name = customName
-        newActivity.imageName = selectedImageName
+        newActivity.imageName = selectedImage.name
         newActivity.isFavorite = false
         newActivity.lastUsed = nil
         newActivity.isCustom = true
@@ -439,8 +428,9 @@ struct ADVWorkoutAddView: View {
         
         do {
             try viewContext.save()
-            selectedWorkout = newActivity
-            print("✅ Saved custom activity: \(customName) with MET: \(metValue) and image: \(selectedImageName)")
+            // The registry picks up the insert from the save notification
+            selectedWorkout = newActivity.id.flatMap { registry.activity(id: $0) }
+            print("✅ Saved custom activity: \(customName) with MET: \(metValue) and image: \(selectedImage.name)")
         } catch {
             print("❌ Error saving custom activity: \(error)")
         }
@@ -11,14 +11,14 @@ struct ActivityStatsView: View {
     @Binding var diaryEntries: [DiaryEntry]
 
     @State private var duration: String = "20"
-    @State private var userWeight: Double = 70.0
+    @ObservedObject private var profileStore = ProfileStore.shared
     @State private var isFavorite: Bool = false
-    @State private var useMetric: Bool = false
     @State private var isCustom: Bool = false
+    @State private var metValue: Double = 1.0 // Cached from ActivityRegistry on appear
 
-    @State private var selectedHour: Int = Calendar.current.component(.hour, from: Date()) % 12 == 0 ? 12 : Calendar.current.component(.hour, from: Date()) % 12
-    @State private var selectedMinute: Int = Calendar.current.component(.minute, from: Date())
-    @State private var selectedPeriod: String = Calendar.current.component(.hour, from: Date()) >= 12 ? "PM" : "AM"
+    @State private var selectedHour: Int = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) % 12 == 0 ? 12 : AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) % 12
+    @State private var selectedMinute: Int = AppClock.shared.calendar.component(.minute, from: AppClock.shared.now)
+    @State private var selectedPeriod: String = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) >= 12 ? "PM" : "AM"
     @State private var showTimePicker: Bool = false
 
     @State private var selectedIntensity: IntensityLevel = .moderate
@@ -62,12 +62,14 @@ struct ActivityStatsView: View {
     }
 
     private var calculatedCalories: Int {
-        let metValue = fetchMETValue(for: activityName)
         let weightInKg = useMetric ? userWeight : userWeight * 0.453592
-        let durationHours = (Double(duration) ?? 0) / 60.0
-        let multiplier = selectedIntensity.metMultiplier
-        let calories = metValue * weightInKg * durationHours * multiplier
-        return max(0, Int(calories))
+        let calories = ActivityRegistry.caloriesBurned(
+            metValue: metValue,
+            weightKg: weightInKg,
+            durationMinutes: Double(duration) ?? 0,
+            intensityMultiplier: selectedIntensity.metMultiplier
+        )
+        return Int(calories)
     }
 
     private var caloriesBurned: Int {
@@ -270,9 +272,7 @@ struct ActivityStatsView: View {
         }
         .background(Styles.primaryBackground)
         .onAppear {
-            fetchUserWeight()
-            fetchFavoriteStatus()
-            fetchCustomStatus()
+            loadActivityDetails()
             setupKeyboardObserver()
             customCalories = String(calculatedCalories)
         }
@@ -307,52 +307,18 @@ struct ActivityStatsView: View {
         }
     }
 
-    private func fetchUserWeight() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                userWeight = Double(userProfile.currentWeight)
-                useMetric = userProfile.useMetric
-            }
-        } catch {
-            print("⚠️ ERROR: Failed to fetch user weight: \(error.localizedDescription)")
-        }
-    }
-
-    private func fetchMETValue(for activity: String) -> Double {
-        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "name == %@", activity)
-        do {
-            let activities = try viewContext.fetch(fetchRequest)
-            return activities.first?.metValue ?? 1.0
-        } catch {
-            print("⚠️ ERROR: Failed to fetch MET value: \(error.localizedDescription)")
-            return 1.0
-        }
-    }
+    private var userWeight: Double { profileStore.profile?.currentWeight ?? 70.0 }
+    private var useMetric: Bool { profileStore.profile?.useMetric ?? false }
 
-    private func fetchFavoriteStatus() {
-        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "name == %@", activityName)
-        do {
-            if let activity = try viewContext.fetch(fetchRequest).first {
-                isFavorite = activity.isFavorite
-            }
-        } catch {
-            print("⚠️ ERROR: Failed to fetch favorite status: \(error.localizedDescription)")
-        }
-    }
-    
-    private func fetchCustomStatus() {
-        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "name == %@", activityName)
-        do {
-            if let activity = try viewContext.fetch(fetchRequest).first {
-                isCustom = activity.isCustom
-            }
-        } catch {
-            print("⚠️ ERROR: Failed to fetch custom status: \(error.localizedDescription)")
+    // One registry lookup on appear; typing a duration only recomputes from this cached state
+    private func loadActivityDetails() {
+        guard let activity = ActivityRegistry.shared.activity(named: activityName) else {
+            print("⚠️ Activity not found in registry: \(activityName)")
+            return
         }
+        metValue = activity.metValue
+        isFavorite = activity.isFavorite
+        isCustom = activity.isCustom
     }
 
     private func bottomNavBar() -> some View {
@@ -400,31 +366,12 @@ struct ActivityStatsView: View {
 
     private func toggleFavorite() {
         isFavorite.toggle()
-        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "name == %@", activityName)
-        do {
-            if let activity = try viewContext.fetch(fetchRequest).first {
-                activity.isFavorite = isFavorite
-                try viewContext.save()
-                print("✅ Favorite status updated for \(activityName): \(isFavorite)")
-            }
-        } catch {
-            print("❌ ERROR: Failed to update favorite status: \(error.localizedDescription)")
-        }
+        ActivityRegistry.shared.setFavorite(isFavorite, forActivityNamed: activityName)
     }
 
     private func deleteCustomActivity() {
-        let fetchRequest: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "name == %@", activityName)
-        do {
-            if let activity = try viewContext.fetch(fetchRequest).first, activity.isCustom {
-                viewContext.delete(activity)
-                try viewContext.save()
-                print("✅ Deleted custom activity: \(activityName)")
-                closeAction()
-            }
-        } catch {
-            print("❌ ERROR: Failed to delete custom activity: \(error.localizedDescription)")
+        if ActivityRegistry.shared.deleteCustomActivity(named: activityName) {
+            closeAction()
         }
     }
 
@@ -440,23 +387,42 @@ struct ActivityStatsView: View {
             return
         }
 
+        let timestamp = entryTimestamp(hour: selectedHour, minute: selectedMinute, period: selectedPeriod)
+
         let workoutEntry = WorkoutEntry(context: viewContext)
         workoutEntry.name = activityName
         workoutEntry.duration = durationValue
         workoutEntry.caloriesBurned = Double(caloriesValue)
-        workoutEntry.time = formattedTime
+        workoutEntry.timestamp = timestamp
         workoutEntry.imageName = activityImage
 
+        let newDiaryEntry = DiaryEntry(
+            timestamp: timestamp,
+            iconName: activityImage,
+            description: activityName,
+            detail: formatDuration(durationValue),
+            calories: caloriesValue,
+            type: "Workout",
+            imageName: activityImage,
+            imageData: nil,
+            fats: 0,
+            carbs: 0,
+            protein: 0
+        )
+
+        // Mirrors newDiaryEntry under the same id so the diary upsert and feed treat them as one row
         let diaryEntry = CoreDiaryEntry(context: viewContext)
+        diaryEntry.id = newDiaryEntry.id
         diaryEntry.type = "Workout"
-        diaryEntry.detail = activityName
-        diaryEntry.entryDescription = formatDuration(durationValue)
+        diaryEntry.entryDescription = activityName
+        diaryEntry.detail = formatDuration(durationValue)
         diaryEntry.calories = Int32(caloriesValue)
-        diaryEntry.time = formattedTime
+        diaryEntry.timestamp = timestamp
         diaryEntry.iconName = activityImage
+        diaryEntry.imageName = activityImage
 
         let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: Date()) as NSDate)
+        fetchRequest.predicate = NSPredicate(format: "date == %@", AppClock.shared.today as NSDate)
         fetchRequest.fetchLimit = 1
 
         do {
@@ -465,7 +431,7 @@ struct ActivityStatsView: View {
                 dailyRecord.addToDiaryEntries(diaryEntry)
             } else {
                 let newDailyRecord = DailyRecord(context: viewContext)
-                newDailyRecord.date = Calendar.current.startOfDay(for: Date())
+                newDailyRecord.date = AppClock.shared.today
                 newDailyRecord.calorieGoal = 2000
                 newDailyRecord.calorieIntake = 0
                 newDailyRecord.waterGoal = 8
@@ -478,28 +444,10 @@ struct ActivityStatsView: View {
             }
             try viewContext.save()
 
-            let activityFetch: NSFetchRequest<ActivityModel> = ActivityModel.fetchRequest()
-            activityFetch.predicate = NSPredicate(format: "name == %@", activityName)
-            if let activity = try viewContext.fetch(activityFetch).first {
-                activity.lastUsed = Date()
-                try viewContext.save()
-            }
+            ActivityRegistry.shared.markUsed(activityName, at: AppClock.shared.now)
             print("✅ Workout saved to Core Data successfully")
 
-            let newDiaryEntry = DiaryEntry(
-                time: formattedTime,
-                iconName: activityImage,
-                description: activityName,
-                detail: formatDuration(durationValue),
-                calories: caloriesValue,
-                type: "Workout",
-                imageName: activityImage,
-                imageData: nil,
-                fats: 0,
-                carbs: 0,
-                protein: 0
-            )
-            diaryEntries.append(newDiaryEntry)
+            diaryEntries.upsert(newDiaryEntry) // The diary feed may already have delivered this row
             print("✅ Added workout to diaryEntries")
 
             fullCloseAction()
@@ -6,27 +6,22 @@ struct QuickWKAddView: View {
     var closeAction: () -> Void
     @Environment(\.managedObjectContext) private var viewContext
 
-    @State private var workoutImageName: String = "DefaultWorkout"
+    @State private var workoutImage: AppAsset = .defaultWorkout
     @State private var workoutName: String = "" // Variable name remains the same for consistency
     @State private var duration: String = ""
     @State private var calories: String = ""
 
-    @State private var selectedHour: Int = Calendar.current.component(.hour, from: Date()) % 12 == 0 ? 12 : Calendar.current.component(.hour, from: Date()) % 12
-    @State private var selectedMinute: Int = Calendar.current.component(.minute, from: Date())
-    @State private var selectedPeriod: String = Calendar.current.component(.hour, from: Date()) >= 12 ? "PM" : "AM"
+    @State private var selectedHour: Int = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) % 12 == 0 ? 12 : AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) % 12
+    @State private var selectedMinute: Int = AppClock.shared.calendar.component(.minute, from: AppClock.shared.now)
+    @State private var selectedPeriod: String = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now) >= 12 ? "PM" : "AM"
     @State private var showTimePicker: Bool = false
 
     @State private var showImagePickerPopup: Bool = false
 
-    @FetchRequest(
-        entity: ActivityModel.entity(),
-        sortDescriptors: [NSSortDescriptor(keyPath: \ActivityModel.name, ascending: true)]
-    ) private var activities: FetchedResults<ActivityModel>
-
     var body: some View {
         VStack(spacing: 20) {
             HStack(spacing: 15) {
-                Image(workoutImageName)
+                workoutImage.image
                     .resizable()
                     .scaledToFit()
                     .frame(width: 100, height: 100)
@@ -157,9 +152,9 @@ struct QuickWKAddView: View {
     }
 
     private func setCurrentTime() {
-        let currentHour = Calendar.current.component(.hour, from: Date())
+        let currentHour = AppClock.shared.calendar.component(.hour, from: AppClock.shared.now)
         selectedHour = currentHour % 12 == 0 ? 12 : currentHour % 12
-        selectedMinute = Calendar.current.component(.minute, from: Date())
+        selectedMinute = AppClock.shared.calendar.component(.minute, from: AppClock.shared.now)
         selectedPeriod = currentHour >= 12 ? "PM" : "AM"
     }
 
@@ -184,20 +179,17 @@ struct QuickWKAddView: View {
                     
                     ScrollView {
                         LazyVGrid(columns: Array(repeating: GridItem(.flexible(), spacing: 15), count: 4), spacing: 15) {
-                            ForEach(activities.filter { !$0.isCustom }, id: \.id) { activity in
-                                Image(activity.imageName ?? "DefaultWorkout")
-                                    .resizable()
-                                    .scaledToFit()
-                                    .frame(width: 50, height: 50)
+                            ForEach(BuiltInActivityCatalog.all, id: \.id) { activity in
+                                AssetIcon(asset: activity.asset, side: 50)
                                     .padding(8)
                                     .background(Styles.primaryBackground)
                                     .clipShape(RoundedRectangle(cornerRadius: 8))
                                     .shadow(radius: 2)
                                     .onTapGesture {
-                                        workoutImageName = activity.imageName ?? "DefaultWorkout"
+                                        workoutImage = activity.asset
                                         showImagePickerPopup = false
                                     }
-                                    .accessibilityLabel("Select \(activity.name ?? "unknown") image")
+                                    .accessibilityLabel("Select \(activity.name) image")
                             }
                         }
                         .padding(.horizontal)
@@ -232,23 +224,42 @@ struct QuickWKAddView: View {
         let durationValue = Double(trimmedDuration) ?? 0
         let caloriesValue = Int(trimmedCalories) ?? 0
 
+        let timestamp = entryTimestamp(hour: selectedHour, minute: selectedMinute, period: selectedPeriod)
+
         let workoutEntry = WorkoutEntry(context: viewContext)
         workoutEntry.name = trimmedName
         workoutEntry.duration = durationValue
         workoutEntry.caloriesBurned = Double(caloriesValue)
-        workoutEntry.time = formattedTime
-        workoutEntry.imageName = workoutImageName
+        workoutEntry.timestamp = timestamp
+        workoutEntry.imageName = workoutImage.name
+
+        let newDiaryEntry = DiaryEntry(
+            timestamp: timestamp,
+            iconName: workoutImage.name,
+            description: trimmedName,
+            detail: formatDuration(trimmedDuration),
+            calories: caloriesValue,
+            type: "Workout",
+            imageName: workoutImage.name,
+            imageData: nil,
+            fats: 0,
+            carbs: 0,
+            protein: 0
+        )
 
+        // Mirrors newDiaryEntry under the same id so the diary upsert and feed treat them as one row
         let diaryEntry = CoreDiaryEntry(context: viewContext)
+        diaryEntry.id = newDiaryEntry.id
         diaryEntry.type = "Workout"
-        diaryEntry.detail = trimmedName
-        diaryEntry.entryDescription = formatDuration(trimmedDuration)
+        diaryEntry.entryDescription = trimmedName
+        diaryEntry.detail = formatDuration(trimmedDuration)
         diaryEntry.calories = Int32(caloriesValue)
-        diaryEntry.time = formattedTime
-        diaryEntry.iconName = workoutImageName
+        diaryEntry.timestamp = timestamp
+        diaryEntry.iconName = workoutImage.name
+        diaryEntry.imageName = workoutImage.name
 
         let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: Date()) as NSDate)
+        fetchRequest.predicate = NSPredicate(format: "date == %@", AppClock.shared.today as NSDate)
         fetchRequest.fetchLimit = 1
 
         do {
@@ -257,7 +268,7 @@ struct QuickWKAddView: View {
                 dailyRecord.addToDiaryEntries(diaryEntry)
             } else {
                 let newDailyRecord = DailyRecord(context: viewContext)
-                newDailyRecord.date = Calendar.current.startOfDay(for: Date())
+                newDailyRecord.date = AppClock.shared.today
                 newDailyRecord.calorieGoal = 2000
                 newDailyRecord.calorieIntake = 0
                 newDailyRecord.waterGoal = 8
@@ -271,20 +282,7 @@ struct QuickWKAddView: View {
             try viewContext.save()
             print("✅ Workout saved to Core Data (both workoutEntries and diaryEntries)")
 
-            let newDiaryEntry = DiaryEntry(
-                time: formattedTime,
-                iconName: workoutImageName,
-                description: trimmedName,
-                detail: formatDuration(trimmedDuration),
-                calories: caloriesValue,
-                type: "Workout",
-                imageName: workoutImageName,
-                imageData: nil,
-                fats: 0,
-                carbs: 0,
-                protein: 0
-            )
-            diaryEntries.append(newDiaryEntry)
+            diaryEntries.upsert(newDiaryEntry) // The diary feed may already have delivered this row
             print("✅ Added workout to diaryEntries array")
         } catch {
             print("❌ Error saving workout to Core Data: \(error.localizedDescription)")
@@ -13,17 +13,14 @@ struct WorkoutView: View {
     @State private var selectedTab: WorkoutTab = .quickAdd
     @Binding var diaryEntries: [DiaryEntry]
     @State private var isClosing: Bool = false
-    @State private var selectedActivity: ActivityModel? = nil
+    @State private var selectedActivity: ActivitySnapshot? = nil
     @FocusState private var isSearchFocused: Bool
 
     enum WorkoutTab {
         case quickAdd, advancedAdd
     }
 
-    @FetchRequest(
-        entity: ActivityModel.entity(),
-        sortDescriptors: [NSSortDescriptor(keyPath: \ActivityModel.name, ascending: true)]
-    ) private var activities: FetchedResults<ActivityModel>
+    @ObservedObject private var registry = ActivityRegistry.shared
 
     var body: some View {
         GeometryReader { geometry in
@@ -130,8 +127,8 @@ struct WorkoutView: View {
                 VStack {
                     if let activity = selectedActivity {
                         ActivityStatsView(
-                            activityName: activity.name ?? "Unknown",
-                            activityImage: activity.imageName ?? "default_image",
+                            activityName: activity.name,
+                            activityImage: AppAsset.resolving(activity.imageName, fallback: .defaultWorkout).name,
                             closeAction: { selectedActivity = nil },
                             fullCloseAction: triggerClose,
                             diaryEntries: $diaryEntries
@@ -173,13 +170,10 @@ struct WorkoutView: View {
             }
     }
 
-    private func workoutButton(activity: ActivityModel) -> some View {
+    private func workoutButton(activity: ActivitySnapshot) -> some View {
         VStack {
-            Image(activity.imageName ?? "default_image")
-                .resizable()
-                .scaledToFit()
-                .frame(width: 50, height: 50)
-            Text(activity.name ?? "Unknown")
+            AssetIcon(asset: .resolving(activity.imageName, fallback: .defaultWorkout), side: 50)
+            Text(activity.name)
                 .font(.caption)
                 .foregroundColor(Styles.primaryText)
                 .multilineTextAlignment(.center)
@@ -200,15 +194,16 @@ struct WorkoutView: View {
                 isSearchFocused = false
             }
         }
-        .accessibilityLabel("Workout: \(activity.name ?? "Unknown")")
+        .accessibilityLabel("Workout: \(activity.name)")
     }
 
-    private func filteredActivities() -> [ActivityModel] {
+    private func filteredActivities() -> [ActivitySnapshot] {
         if searchText.isEmpty {
             return []
         } else {
-            return activities.filter { activity in
-                activity.name?.lowercased().contains(searchText.lowercased()) ?? false
+            let query = searchText.lowercased()
+            return registry.allActivities.filter { activity in
+                activity.name.lowercased().contains(query)
             }
         }
     }
@@ -2,7 +2,7 @@ import SwiftUI
 
 struct WeighInView: View {
     var closeAction: () -> Void
-        var saveWeighIn: (String, String) -> Void // Type remains the same, but matches DashboardView
+        var saveWeighIn: (Date, String) -> Void // Matches DashboardView.saveWeighIn(timestamp:weight:)
         @Binding var fadeOut: Bool
 
     @State private var weight: String
@@ -15,7 +15,7 @@ struct WeighInView: View {
 
     init(
         closeAction: @escaping () -> Void,
-        saveWeighIn: @escaping (String, String) -> Void,
+        saveWeighIn: @escaping (Date, String) -> Void,
         fadeOut: Binding<Bool>,
         userWeight: Double = 200.0
     ) {
@@ -113,14 +113,14 @@ struct WeighInView: View {
 
                 // ✅ Foot Images
                 HStack(spacing: 50) {
-                    Image("LeftFoot")
+                    AppAsset.leftFoot.image
                         .renderingMode(.template)
                         .resizable()
                         .scaledToFit()
                         .frame(width: 100, height: 250)
                         .foregroundColor(Styles.primaryText)
 
-                    Image("RightFoot")
+                    AppAsset.rightFoot.image
                         .renderingMode(.template)
                         .resizable()
                         .scaledToFit()
@@ -227,7 +227,7 @@ struct WeighInView: View {
         }
 
         DispatchQueue.main.asyncAfter(deadline: .now() + 1.5) {
-            saveWeighIn(formattedCurrentTime(), weight)
+            saveWeighIn(currentEntryTimestamp(), weight)
             resetView()
             closeAction()
         }
@@ -241,13 +241,6 @@ struct WeighInView: View {
         }
     }
 
-    // ✅ Returns formatted time (8:00 AM/PM)
-    private func formattedCurrentTime() -> String {
-        let formatter = DateFormatter()
-        formatter.dateFormat = "h:mm a"
-        return formatter.string(from: Date())
-    }
-
     // ✅ Limits input to 3 digits before decimal and 1 digit after
     private func validateWeightInput() {
         // Allow only numbers and a single decimal point
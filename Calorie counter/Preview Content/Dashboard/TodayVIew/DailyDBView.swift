@@ -20,13 +20,15 @@ struct DailyDBView: View {
     @State private var selectedUnit: String = "fl oz"
     @State private var isWeighInExpanded: Bool = false
     
-    @State private var simulatedCurrentDate: Date = {
-        if let savedDate = UserDefaults.standard.object(forKey: "simulatedCurrentDate") as? Date {
-            return Calendar.current.startOfDay(for: savedDate)
-        }
-        return Calendar.current.startOfDay(for: Date())
-    }()
+    @ObservedObject private var clock = AppClock.shared
     @State private var simulateDayTrigger: Bool = false
+    @State private var isGeneratingHistory: Bool = false
+    // Header values loaded through DataRepository so rendering never fetches
+    @State private var dayHeader = DayHeaderSnapshot()
+    @ObservedObject private var profileStore = ProfileStore.shared
+    private let diaryFeed = DiaryFeed.shared
+    // What the last load found for the selected day; saves look the record up by ID instead of fetching
+    @State private var loadedDay: LoadedDay?
 
     private var totalCalories: Double {
         let foodCalories = diaryEntries.filter { $0.type == "Food" }.reduce(0) { $0 + Double($1.calories) }
@@ -55,203 +57,132 @@ struct DailyDBView: View {
     }
 
     private var totalDailyWater: CGFloat {
-        var totalIntake: CGFloat = 0
-        for entry in diaryEntries where entry.type == "Water" {
-            let (amount, unit) = extractWaterAmountAndUnit(entry.detail)
-            let convertedAmount = convertWaterUnit(amount: amount, from: unit, to: selectedUnit)
-            totalIntake += convertedAmount
-        }
-        return totalIntake
+        CGFloat(WaterUnit.displayAmount(milliliters: diaryEntries.totalWaterMilliliters, in: selectedUnit))
     }
 
-    private func extractWaterAmountAndUnit(_ detail: String) -> (CGFloat, String) {
-        let fractionMap: [String: CGFloat] = ["1/4": 0.25, "1/2": 0.5, "3/4": 0.75, "1": 1.0]
-        let components = detail.split(separator: " ")
-        if components.count == 2 {
-            let amountString = String(components[0])
-            let unit = String(components[1])
-            if let fractionValue = fractionMap[amountString] {
-                return (fractionValue, unit)
-            } else if let amount = Double(amountString) {
-                return (CGFloat(amount), unit)
-            }
-        } else if detail.contains("fl oz") {
-            let numberString = detail.replacingOccurrences(of: "fl oz", with: "").trimmingCharacters(in: .whitespaces)
-            if let amount = Double(numberString) {
-                return (CGFloat(amount), "fl oz")
-            }
-        }
-        return (0, "ml")
+    private var isCurrentDay: Bool {
+        clock.isToday(selectedDate)
     }
 
-    private func convertWaterUnit(amount: CGFloat, from fromUnit: String, to toUnit: String) -> CGFloat {
-        let mlPerFlOz: CGFloat = 29.5735
-        let mlPerGallon: CGFloat = 3785.41
-        let mlPerLiter: CGFloat = 1000
-
-        var amountInMl: CGFloat
-        switch fromUnit.lowercased() {
-        case "milliliters", "ml": amountInMl = amount
-        case "liters", "l": amountInMl = amount * mlPerLiter
-        case "gallons", "gal": amountInMl = amount * mlPerGallon
-        case "fl", "fl oz": amountInMl = amount * mlPerFlOz
-        default: return amount
-        }
+    // The day before the selected one, once the selected day's load has landed
+    private var previousDay: DaySummary? {
+        guard let loaded = loadedDay, loaded.day == clock.calendar.startOfDay(for: selectedDate) else { return nil }
+        return loaded.previous
+    }
 
-        switch toUnit.lowercased() {
-        case "milliliters", "ml": return amountInMl
-        case "liters", "l": return amountInMl / mlPerLiter
-        case "gallons", "gal": return amountInMl / mlPerGallon
-        case "fl", "fl oz": return amountInMl / mlPerFlOz
-        default: return amount
-        }
+    private var previousDayWeighIn: Double? {
+        previousDay.flatMap { $0.weighIn > 0 ? $0.weighIn : nil }
     }
 
-    private var isCurrentDay: Bool {
-        Calendar.current.isDate(selectedDate, inSameDayAs: simulatedCurrentDate)
+    private var previousDayWaterGoal: CGFloat? {
+        previousDay.flatMap { $0.waterGoal > 0 ? CGFloat($0.waterGoal) : nil }
     }
 
     private var canGoBack: Bool {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first, let startDate = userProfile.startDate {
-                let startOfStartDate = Calendar.current.startOfDay(for: startDate)
-                let startOfSelectedDate = Calendar.current.startOfDay(for: selectedDate)
-                return startOfSelectedDate > startOfStartDate
-            }
-        } catch {
-            print("❌ Error fetching startDate: \(error.localizedDescription)")
-            return false
-        }
-        return false
+        guard let startDate = profileStore.profile?.startDate else { return false }
+        let startOfStartDate = clock.calendar.startOfDay(for: startDate)
+        let startOfSelectedDate = clock.calendar.startOfDay(for: selectedDate)
+        return startOfSelectedDate > startOfStartDate
     }
 
     private var canGoForward: Bool {
-        let startOfSimulatedCurrent = Calendar.current.startOfDay(for: simulatedCurrentDate)
-        let startOfSelectedDate = Calendar.current.startOfDay(for: selectedDate)
+        let startOfSimulatedCurrent = clock.today
+        let startOfSelectedDate = clock.calendar.startOfDay(for: selectedDate)
         return startOfSelectedDate < startOfSimulatedCurrent
     }
 
     private func saveOrUpdateDailyRecord() {
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: selectedDate) as NSDate)
-        fetchRequest.fetchLimit = 1
-        
-        let dailyRecord: DailyRecord
-        var isNewRecord = false
-        do {
-            if let existingRecord = try viewContext.fetch(fetchRequest).first {
-                dailyRecord = existingRecord
-                print("DEBUG: Updating existing DailyRecord for \(formattedDate(selectedDate))")
-            } else {
-                dailyRecord = DailyRecord(context: viewContext)
-                dailyRecord.date = Calendar.current.startOfDay(for: selectedDate)
-                dailyRecord.weighIn = 0
-                isNewRecord = true
-                // Set waterGoal from previous day for new records
-                if isCurrentDay, let previousWaterGoal = fetchPreviousDayWaterGoal() {
-                    dailyRecord.waterGoal = Double(previousWaterGoal)
-                    waterGoal = previousWaterGoal // Update state for UI
-                    print("DEBUG: Set waterGoal to \(previousWaterGoal) from previous day for new record")
-                }
-                print("DEBUG: Created new DailyRecord for \(formattedDate(selectedDate)) with weighIn = 0")
-            }
-        } catch {
-            print("❌ Error fetching DailyRecord: \(error.localizedDescription)")
+        // Checked before a record is inserted, so bailing out never leaves a half-built one in the context
+        guard profileStore.profile != nil else {
+            AppLog.error("No UserProfile found", category: .diary)
             return
         }
 
-        // Fetch UserProfile
-        let userFetch: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        userFetch.fetchLimit = 1
-        guard let userProfile = try? viewContext.fetch(userFetch).first else {
-            print("❌ Error: No UserProfile found")
+        // Until the day's load lands there is nothing to save into; the load saves once it has
+        let day = clock.calendar.startOfDay(for: selectedDate)
+        guard let loaded = loadedDay, loaded.day == day else {
+            AppLog.debug("Deferring save for \(formattedDate(selectedDate)) until its record has loaded", category: .diary)
             return
         }
 
-        // Only calculate calorie goal for new records on the current day
-        if isCurrentDay && isNewRecord {
-            // Check if it's the user's birthday and update age
-            if let birthdate = userProfile.birthdate {
-                let calendar = Calendar.current
-                let todayComponents = calendar.dateComponents([.month, .day], from: selectedDate)
-                let birthComponents = calendar.dateComponents([.month, .day], from: birthdate)
-                if todayComponents.month == birthComponents.month && todayComponents.day == birthComponents.day {
-                    let ageComponents = calendar.dateComponents([.year], from: birthdate, to: selectedDate)
-                    let newAge = Int32(ageComponents.year ?? 0)
-                    if newAge != userProfile.age {
-                        userProfile.age = newAge
-                        print("DEBUG: Updated user age to \(newAge) on birthday")
-                    }
-                }
+        let dailyRecord: DailyRecord
+        var isNewRecord = false
+        if let recordID = loaded.recordID {
+            guard let existingRecord = try? viewContext.existingObject(with: recordID) as? DailyRecord, !existingRecord.isDeleted else {
+                // The row went away underneath the screen (history tools, a restore); load the day again
+                AppLog.warning("DailyRecord for \(formattedDate(selectedDate)) is gone, reloading", category: .diary)
+                loadDailyRecord(for: selectedDate, saveAfterLoad: true)
+                return
+            }
+            dailyRecord = existingRecord
+            AppLog.debug("Updating existing DailyRecord for \(formattedDate(selectedDate))", category: .diary)
+        } else {
+            dailyRecord = DailyRecord(context: viewContext)
+            dailyRecord.date = day
+            dailyRecord.weighIn = 0
+            isNewRecord = true
+            // Set waterGoal from previous day for new records
+            if isCurrentDay, let previousWaterGoal = previousDayWaterGoal {
+                dailyRecord.waterGoal = Double(previousWaterGoal)
+                waterGoal = previousWaterGoal // Update state for UI
+                AppLog.debug("Set waterGoal to \(previousWaterGoal) from previous day for new record", category: .diary)
             }
+            AppLog.debug("Created new DailyRecord for \(formattedDate(selectedDate)) with weighIn = 0", category: .diary)
+        }
 
-            // Use previous day's weigh-in to set currentWeight for BMR calculation
-            let previousDay = Calendar.current.date(byAdding: .day, value: -1, to: selectedDate)!
-            let prevFetch: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-            prevFetch.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: previousDay) as NSDate)
-            prevFetch.fetchLimit = 1
-            if let prevRecord = try? viewContext.fetch(prevFetch).first, prevRecord.weighIn > 0 {
-                if prevRecord.weighIn != userProfile.currentWeight {
-                    userProfile.currentWeight = prevRecord.weighIn
-                    print("DEBUG: Set UserProfile.currentWeight to \(prevRecord.weighIn) from previous day's weigh-in for new day")
-                }
+        // Profile changes are staged in the view context and saved with the record below, as one transaction
+        let isNewCurrentDay = isCurrentDay && isNewRecord
+        let previousWeighIn = isNewCurrentDay ? previousDayWeighIn : nil
+        let averageWeighIn = isCurrentDay && !weighIns.isEmpty ? Double(averageWeight()) : nil
+        let currentStreak = Int32(dayHeader.passStreak)
+        profileStore.stage { userProfile in
+            // Only calculate calorie goal for new records on the current day
+            if isNewCurrentDay {
+                DayRollover.beginDay(selectedDate, profile: userProfile, previousWeighIn: previousWeighIn, calendar: clock.calendar)
             }
 
-            // Recalculate BMR with updated weight and age
-            let newBMR = calculateBMR(
-                weight: userProfile.currentWeight,
-                heightCm: userProfile.heightCm,
-                heightFt: userProfile.heightFt,
-                heightIn: userProfile.heightIn,
-                age: userProfile.age,
-                gender: userProfile.gender ?? "",
-                activityInt: userProfile.activityInt,
-                useMetric: userProfile.useMetric
-            )
-            if newBMR != userProfile.userBMR {
-                userProfile.userBMR = newBMR
-                print("DEBUG: Recalculated BMR to \(newBMR) for new day")
+            // Average weigh-in becomes currentWeight, affects next day (calorie goal unchanged)
+            if let averageWeighIn = averageWeighIn {
+                userProfile.currentWeight = averageWeighIn
+                AppLog.debug("Updated UserProfile.currentWeight to \(averageWeighIn) for current day", category: .diary)
             }
 
-            // Update weightDifference based on currentWeight and goalWeight
-            if userProfile.goalWeight > 0 {
-                userProfile.weightDifference = abs(userProfile.currentWeight - userProfile.goalWeight)
-                print("DEBUG: Updated weightDifference to \(userProfile.weightDifference) for new day")
+            if isCurrentDay && currentStreak > userProfile.highStreak {
+                userProfile.highStreak = currentStreak
+                AppLog.debug("Updated highStreak to \(currentStreak)", category: .diary)
             }
+        }
 
-            // Set calorie goal for the new day
-            updateDailyCalorieGoal(userProfile: userProfile)
-            dailyRecord.calorieGoal = Double(userProfile.dailyCalorieGoal)
-            print("DEBUG: Locked in DailyRecord.calorieGoal to \(dailyRecord.calorieGoal) for new day")
+        if isNewCurrentDay, let profile = profileStore.profile {
+            dailyRecord.calorieGoal = Double(profile.dailyCalorieGoal)
+            AppLog.debug("Locked in DailyRecord.calorieGoal to \(dailyRecord.calorieGoal) for new day", category: .diary)
         }
 
         // Update weighIns for current day
         if isCurrentDay {
-            // Clear existing weighIns to avoid duplicates
-            if let existingWeighIns = dailyRecord.weighIns as? Set<WeighInEntry> {
-                existingWeighIns.forEach { viewContext.delete($0) }
-            }
-            
-            // Save new weighIns
+            // Match rows by time and weight; only added and removed weigh-ins touch the store
+            var existingWeighIns = ((dailyRecord.weighIns as? Set<WeighInEntry>) ?? [])
+                .reduce(into: [WeighInKey: [WeighInEntry]]()) { byKey, entity in
+                    byKey[WeighInKey(timestamp: entity.timestamp, weight: entity.weight), default: []].append(entity)
+                }
             for weighIn in weighIns {
+                let key = WeighInKey(timestamp: weighIn.timestamp, weight: Double(weighIn.weight) ?? 0.0)
+                if existingWeighIns[key]?.popLast() != nil {
+                    continue
+                }
                 let weighInEntry = WeighInEntry(context: viewContext)
-                weighInEntry.time = weighIn.time
+                weighInEntry.timestamp = weighIn.timestamp
                 weighInEntry.weight = Double(weighIn.weight) ?? 0.0
                 weighInEntry.dailyRecord = dailyRecord
                 dailyRecord.addToWeighIns(weighInEntry)
-                print("DEBUG: Saved WeighInEntry - Time: \(weighIn.time), Weight: \(weighIn.weight)")
+                AppLog.debug("Saved WeighInEntry - Time: \(weighIn.time), Weight: \(weighIn.weight)", category: .diary)
             }
+            existingWeighIns.values.joined().forEach { viewContext.delete($0) }
 
-            // Update average weighIn and currentWeight
-            if !weighIns.isEmpty {
-                let avgWeightString = averageWeight()
-                if let avgWeight = Double(avgWeightString) {
-                    dailyRecord.weighIn = avgWeight
-                    userProfile.currentWeight = avgWeight // Update currentWeight, affects next day
-                    print("DEBUG: Updated weighIn to \(avgWeight) and UserProfile.currentWeight to \(avgWeight) for current day (calorie goal unchanged)")
-                }
+            // Update average weighIn
+            if let averageWeighIn = averageWeighIn {
+                dailyRecord.weighIn = averageWeighIn
+                AppLog.debug("Updated weighIn to \(averageWeighIn) for current day", category: .diary)
             }
         }
 
@@ -262,20 +193,24 @@ struct DailyDBView: View {
         dailyRecord.waterGoal = Double(waterGoal) // Persist waterGoal
         dailyRecord.passFail = totalCalories <= dailyRecord.calorieGoal
 
+        // Match rows by their stable id; untouched rows are left alone so the diary feed only sees real edits
+        let existingEntries = ((dailyRecord.diaryEntries as? Set<CoreDiaryEntry>) ?? [])
+            .reduce(into: [UUID: CoreDiaryEntry]()) { byID, entity in
+                if let id = entity.id { byID[id] = entity }
+            }
         for entry in diaryEntries {
-            let entryFetch: NSFetchRequest<CoreDiaryEntry> = CoreDiaryEntry.fetchRequest()
-            entryFetch.predicate = NSPredicate(format: "entryDescription == %@ AND time == %@ AND dailyRecord == %@", entry.description, entry.time, dailyRecord)
-            entryFetch.fetchLimit = 1
-            
-            if let existingEntry = try? viewContext.fetch(entryFetch).first {
+            if let existingEntry = existingEntries[entry.id] {
+                guard existingEntry.differs(from: entry) else { continue }
                 existingEntry.detail = entry.detail
                 existingEntry.calories = Int32(entry.calories)
                 existingEntry.fats = entry.fats
                 existingEntry.carbs = entry.carbs
                 existingEntry.protein = entry.protein
+                existingEntry.waterAmountMl = entry.waterAmountMl
             } else {
                 let diaryEntity = CoreDiaryEntry(context: viewContext)
-                diaryEntity.time = entry.time
+                diaryEntity.id = entry.id
+                diaryEntity.timestamp = entry.timestamp
                 diaryEntity.iconName = entry.iconName
                 diaryEntity.entryDescription = entry.description
                 diaryEntity.detail = entry.detail
@@ -286,82 +221,99 @@ struct DailyDBView: View {
                 diaryEntity.fats = entry.fats
                 diaryEntity.carbs = entry.carbs
                 diaryEntity.protein = entry.protein
+                diaryEntity.waterAmountMl = entry.waterAmountMl
                 diaryEntity.dailyRecord = dailyRecord
                 dailyRecord.addToDiaryEntries(diaryEntity)
             }
         }
 
-        if isCurrentDay {
-            let currentStreak = Int32(calculateStreak())
-            if currentStreak > userProfile.highStreak {
-                userProfile.highStreak = currentStreak
-                print("DEBUG: Updated highStreak to \(currentStreak)")
-            }
-        }
-
         do {
-            try viewContext.save()
-            print("✅ Saved/Updated DailyRecord for \(formattedDate(selectedDate)) with waterGoal: \(dailyRecord.waterGoal)")
+            try AppLog.interval("Save daily record", category: .diary) {
+                try viewContext.save()
+            }
+            if isNewRecord {
+                loadedDay?.recordID = dailyRecord.objectID // Permanent now that it's saved
+            }
+            AppLog.info("Saved/Updated DailyRecord for \(formattedDate(selectedDate)) with waterGoal: \(dailyRecord.waterGoal)", category: .diary)
         } catch {
-            print("❌ Error saving DailyRecord: \(error.localizedDescription)")
+            // Drops the staged profile changes along with the record's, so neither half lands on its own
+            viewContext.rollback()
+            AppLog.error("Error saving DailyRecord: \(error.localizedDescription)", category: .diary)
         }
+        refreshDayHeader()
     }
 
-    private func loadDailyRecord(for date: Date) {
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: date) as NSDate)
-        fetchRequest.returnsObjectsAsFaults = false
-        fetchRequest.relationshipKeyPathsForPrefetching = ["diaryEntries", "weighIns"]
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
-        
-        do {
-            let records = try viewContext.fetch(fetchRequest)
-            if let record = records.first(where: { (($0.diaryEntries as? Set<CoreDiaryEntry>)?.count ?? 0) > 0 || (($0.weighIns as? Set<WeighInEntry>)?.count ?? 0) > 0 }) ?? records.first {
-                let loadedEntries = (record.diaryEntries as? Set<CoreDiaryEntry>)?.map { entity in
-                    DiaryEntry(
-                        time: entity.time ?? "",
-                        iconName: entity.iconName ?? "",
-                        description: entity.entryDescription ?? "",
-                        detail: entity.detail ?? "",
-                        calories: Int(entity.calories),
-                        type: entity.type ?? "",
-                        imageName: entity.imageName,
-                        imageData: entity.imageData,
-                        fats: entity.fats,
-                        carbs: entity.carbs,
-                        protein: entity.protein
-                    )
-                } ?? []
-                diaryEntries = loadedEntries
-                
-                // Load weighIns for current day only
-                if isCurrentDay {
-                    let loadedWeighIns = (record.weighIns as? Set<WeighInEntry>)?.map { entity in
-                        WeighIn(time: entity.time ?? formattedCurrentTime(), weight: String(entity.weight))
-                    } ?? []
-                    weighIns = loadedWeighIns
-                    print("DEBUG: Loaded \(loadedWeighIns.count) weighIns for current day")
-                } else {
-                    weighIns = []
-                }
-                
-                waterGoal = CGFloat(record.waterGoal)
-                selectedUnit = record.waterUnit ?? "fl oz"
-                print("DEBUG: Loaded waterGoal: \(waterGoal) and unit: \(selectedUnit) for \(formattedDate(date))")
-            } else {
+    private func loadDailyRecord(for date: Date, saveAfterLoad: Bool = false) {
+        showDiary(for: date)
+        Task {
+            do {
+                async let previous = DataRepository.shared.previousDay(before: date)
+                // The first load on appearing takes the snapshot StartupPipeline prewarmed
+                let snapshot = saveAfterLoad
+                    ? try await DataRepository.shared.dayRecord(prewarmedFor: date)
+                    : try await DataRepository.shared.dayRecord(for: date)
+                let previousDay = try await previous
+                // A newer selection started its own load
+                guard clock.calendar.isDate(date, inSameDayAs: selectedDate) else { return }
+                loadedDay = LoadedDay(day: clock.calendar.startOfDay(for: date), recordID: snapshot?.recordID, previous: previousDay)
+                applyLoadedRecord(snapshot, for: date)
+            } catch {
+                AppLog.error("Error loading DailyRecord: \(error.localizedDescription)", category: .diary)
                 resetDailyData()
-                if isCurrentDay {
-                    if let previousWaterGoal = fetchPreviousDayWaterGoal() {
-                        waterGoal = previousWaterGoal
-                        print("DEBUG: No record found, set waterGoal to \(waterGoal) from previous day")
-                    }
-                    saveOrUpdateDailyRecord() // Save with previous day's waterGoal
-                }
-                print("DEBUG: No record found for \(formattedDate(date)), resetting")
             }
-        } catch {
-            print("❌ Error loading DailyRecord: \(error.localizedDescription)")
+            if saveAfterLoad && isCurrentDay {
+                saveOrUpdateDailyRecord()
+            }
+            refreshDayHeader()
+        }
+    }
+
+    private func applyLoadedRecord(_ snapshot: DayRecordSnapshot?, for date: Date) {
+        guard let snapshot = snapshot else {
             resetDailyData()
+            if isCurrentDay {
+                if let previousWaterGoal = previousDayWaterGoal {
+                    waterGoal = previousWaterGoal
+                    AppLog.debug("No record found, set waterGoal to \(waterGoal) from previous day", category: .diary)
+                }
+                saveOrUpdateDailyRecord() // Save with previous day's waterGoal
+            }
+            AppLog.debug("No record found for \(formattedDate(date)), resetting", category: .diary)
+            return
+        }
+
+        // Load weighIns for current day only
+        if isCurrentDay {
+            weighIns = snapshot.weighIns.map { WeighIn(timestamp: $0.timestamp, weight: String($0.weight)) }
+            AppLog.debug("Loaded \(weighIns.count) weighIns for current day", category: .diary)
+        } else {
+            weighIns = []
+        }
+
+        waterGoal = CGFloat(snapshot.summary.waterGoal)
+        selectedUnit = snapshot.summary.waterUnit ?? "fl oz"
+        AppLog.debug("Loaded waterGoal: \(waterGoal) and unit: \(selectedUnit) for \(formattedDate(date))", category: .diary)
+    }
+
+    // Entries come from the diary feed; after the initial list, saves arrive as per-row diffs
+    private func showDiary(for date: Date) {
+        diaryFeed.show(day: date)
+        if diaryEntries != diaryFeed.entries {
+            diaryEntries = diaryFeed.entries
+        }
+    }
+
+    private func refreshDayHeader() {
+        let date = selectedDate
+        let today = clock.today
+        Task {
+            do {
+                let newHeader = try await DataRepository.shared.dayHeader(for: date, today: today)
+                guard clock.calendar.isDate(date, inSameDayAs: selectedDate) else { return }
+                dayHeader = newHeader
+            } catch {
+                AppLog.error("Error loading day header: \(error.localizedDescription)", category: .diary)
+            }
         }
     }
 
@@ -369,7 +321,7 @@ struct DailyDBView: View {
         weighIns = []
         diaryEntries = []
         if isCurrentDay {
-            if let previousWaterGoal = fetchPreviousDayWaterGoal() {
+            if let previousWaterGoal = previousDayWaterGoal {
                 waterGoal = previousWaterGoal
             } else {
                 waterGoal = 0
@@ -377,145 +329,46 @@ struct DailyDBView: View {
         } else {
             waterGoal = 0
         }
-        print("DEBUG: Reset waterGoal to \(waterGoal) for \(formattedDate(selectedDate))")
+        AppLog.debug("Reset waterGoal to \(waterGoal) for \(formattedDate(selectedDate))", category: .diary)
     }
 
     private func simulateDayPassing() {
         saveOrUpdateDailyRecord()
-        simulatedCurrentDate = Calendar.current.date(byAdding: .day, value: 1, to: simulatedCurrentDate) ?? simulatedCurrentDate
-        UserDefaults.standard.set(simulatedCurrentDate, forKey: "simulatedCurrentDate")
-        selectedDate = simulatedCurrentDate
+        clock.advance()
+        selectedDate = clock.today
         resetDailyData()
-        saveOrUpdateDailyRecord()
-        loadDailyRecord(for: selectedDate)
+        loadDailyRecord(for: selectedDate) // Finds no record and saves the new day
         updateActivityStreaks() // Add this
         simulateDayTrigger.toggle()
     }
 
     private func updateActivityStreaks() {
-        let currentStreak = calculateActivityStreak()
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                if currentStreak > userProfile.highestActivityStreak {
-                    userProfile.highestActivityStreak = Int32(currentStreak)
-                    try viewContext.save()
-                    print("✅ Updated highestActivityStreak to \(currentStreak)")
-                }
-            }
-        } catch {
-            print("❌ Error updating streaks: \(error)")
-        }
-    }
-
-    private func calculateActivityStreak() -> Int {
-        var streak = 0
-        var currentDate = Calendar.current.startOfDay(for: simulatedCurrentDate)
-        
-        while true {
-            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-            fetchRequest.predicate = NSPredicate(format: "date == %@", currentDate as NSDate)
-            fetchRequest.fetchLimit = 1
-            do {
-                if let record = try viewContext.fetch(fetchRequest).first,
-                   let workouts = record.workoutEntries as? Set<WorkoutEntry>,
-                   !workouts.isEmpty {
-                    streak += 1
-                    currentDate = Calendar.current.date(byAdding: .day, value: -1, to: currentDate)!
-                } else {
-                    break
-                }
-            } catch {
-                print("❌ Error calculating streak: \(error)")
-                break
-            }
-        }
-        return streak
-    }
-
-    // New helper to fetch previous day's water goal
-    private func fetchPreviousDayWaterGoal() -> CGFloat? {
-        let previousDay = Calendar.current.date(byAdding: .day, value: -1, to: selectedDate)!
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: previousDay) as NSDate)
-        fetchRequest.fetchLimit = 1
-        do {
-            if let previousRecord = try viewContext.fetch(fetchRequest).first, previousRecord.waterGoal > 0 {
-                return CGFloat(previousRecord.waterGoal)
-            }
-        } catch {
-            print("❌ Error fetching previous day's water goal: \(error.localizedDescription)")
+        // Streak runs through the current day, so count back from tomorrow
+        let tomorrow = clock.day(1, from: clock.today)
+        let currentStreak = Int32(WorkoutStatsIndex.shared.currentStreak(before: tomorrow))
+        guard currentStreak > (profileStore.profile?.highestActivityStreak ?? 0) else { return }
+        if profileStore.update({ $0.highestActivityStreak = currentStreak }) {
+            AppLog.info("Updated highestActivityStreak to \(currentStreak)", category: .diary)
         }
-        return nil
     }
 
     private func dayTitle() -> String {
-        let today = Calendar.current.startOfDay(for: simulatedCurrentDate)
-        if Calendar.current.isDate(selectedDate, inSameDayAs: today) {
+        let today = clock.today
+        if clock.calendar.isDate(selectedDate, inSameDayAs: today) {
             return "Today"
-        } else if Calendar.current.isDate(selectedDate, inSameDayAs: Calendar.current.date(byAdding: .day, value: -1, to: today)!) {
+        } else if clock.calendar.isDate(selectedDate, inSameDayAs: clock.calendar.date(byAdding: .day, value: -1, to: today)!) {
             return "Yesterday"
-        } else {
-            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: true)]
-            do {
-                let records = try viewContext.fetch(fetchRequest)
-                if let index = records.firstIndex(where: { Calendar.current.isDate($0.date ?? Date.distantFuture, inSameDayAs: selectedDate) }) {
-                    return "Day \(index + 1)"
-                }
-            } catch {
-                print("❌ Error fetching records for dayTitle: \(error.localizedDescription)")
-            }
-            return "Day X"
+        } else if let dayNumber = dayHeader.dayNumber {
+            return "Day \(dayNumber)"
         }
+        return "Day X"
     }
 
     private func streakOrPassFail() -> (String, Color) {
         if isCurrentDay {
-            let streak = calculateStreak()
-            return ("Streak: \(streak)", Styles.primaryText)
-        } else {
-            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-            fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: selectedDate) as NSDate)
-            fetchRequest.fetchLimit = 1
-            do {
-                if let record = try viewContext.fetch(fetchRequest).first {
-                    return record.passFail ? ("UNDER", .green) : ("OVER", .red)
-                }
-            } catch {
-                print("❌ Error fetching passFail: \(error.localizedDescription)")
-            }
-            return ("OVER", .red)
+            return ("Streak: \(dayHeader.passStreak)", Styles.primaryText)
         }
-    }
-
-    private func calculateStreak() -> Int {
-        let today = Calendar.current.startOfDay(for: simulatedCurrentDate)
-        var streak = 0
-        var currentDate = Calendar.current.date(byAdding: .day, value: -1, to: today) ?? today
-        
-        while true {
-            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-            fetchRequest.predicate = NSPredicate(format: "date == %@", currentDate as NSDate)
-            fetchRequest.fetchLimit = 1
-            do {
-                if let record = try viewContext.fetch(fetchRequest).first {
-                    if record.passFail {
-                        streak += 1
-                        currentDate = Calendar.current.date(byAdding: .day, value: -1, to: currentDate)!
-                    } else {
-                        break
-                    }
-                } else {
-                    break
-                }
-            } catch {
-                print("❌ Error calculating streak: \(error.localizedDescription)")
-                break
-            }
-        }
-        return streak
+        return dayHeader.passFail == true ? ("UNDER", .green) : ("OVER", .red)
     }
 
     private func averageWeight() -> String {
@@ -523,94 +376,8 @@ struct DailyDBView: View {
             guard !weighIns.isEmpty else { return "0" }
             let totalWeight = weighIns.compactMap { Double($0.weight) }.reduce(0, +)
             return String(format: "%.1f", totalWeight / Double(weighIns.count))
-        } else {
-            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-            fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: selectedDate) as NSDate)
-            fetchRequest.fetchLimit = 1
-            do {
-                if let record = try viewContext.fetch(fetchRequest).first {
-                    return record.weighIn > 0 ? String(format: "%.1f", record.weighIn) : "none"
-                }
-            } catch {
-                print("❌ Error fetching weighIn: \(error.localizedDescription)")
-            }
-            return "none"
-        }
-    }
-
-    // MARK: - Helper Functions
-
-    private func calculateBMR(weight: Double, heightCm: Int32, heightFt: Int32, heightIn: Int32, age: Int32, gender: String, activityInt: Int32, useMetric: Bool) -> Int32 {
-        var bmr: Double = 0.0
-        
-        let weightKg = useMetric ? weight : weight * 0.453592
-        let heightCmDouble: Double
-        if useMetric {
-            heightCmDouble = Double(heightCm)
-        } else {
-            heightCmDouble = Double(heightFt * 12 + heightIn) * 2.54
-        }
-        
-        if gender.lowercased() == "man" {
-            bmr = 88.362 + (13.397 * weightKg) + (4.799 * heightCmDouble) - (5.677 * Double(age))
-        } else if gender.lowercased() == "woman" {
-            bmr = 447.593 + (9.247 * weightKg) + (3.098 * heightCmDouble) - (4.330 * Double(age))
-        } else {
-            bmr = (88.362 + (13.397 * weightKg) + (4.799 * heightCmDouble) - (5.677 * Double(age)) + 447.593 + (9.247 * weightKg) + (3.098 * heightCmDouble) - (4.330 * Double(age))) / 2
-        }
-        
-        let activityMultipliers: [Double] = [1.2, 1.375, 1.55, 1.725, 1.9]
-        let activityIndex = min(max(Int(activityInt), 0), activityMultipliers.count - 1)
-        bmr *= activityMultipliers[activityIndex]
-        
-        return Int32(bmr.rounded())
-    }
-
-    private func updateDailyCalorieGoal(userProfile: UserProfile) {
-        let calorieFactor: Double = useMetric ? 7000.0 : 3500.0
-        userProfile.dailyCalorieDif = Int32((calorieFactor * userProfile.weekGoal) / 7)
-        
-        var newCalorieGoal: Int32 = userProfile.userBMR
-        switch userProfile.goalId {
-        case 1:
-            let absCalorieDif = abs(userProfile.dailyCalorieDif)
-            newCalorieGoal = userProfile.weekGoal < 0 ? userProfile.userBMR - absCalorieDif : userProfile.userBMR + absCalorieDif
-            
-        case 2:
-            if userProfile.goalWeight > 0 {
-                let absCalorieDif = abs(userProfile.dailyCalorieDif)
-                newCalorieGoal = userProfile.weekGoal < 0 ? userProfile.userBMR - absCalorieDif : userProfile.userBMR + absCalorieDif
-            } else {
-                newCalorieGoal = userProfile.userBMR
-            }
-            
-        case 3:
-            if let targetDate = userProfile.targetDate, userProfile.goalWeight > 0 {
-                let daysUntilTarget = Calendar.current.dateComponents([.day], from: selectedDate, to: targetDate).day ?? 0
-                if daysUntilTarget > 0 {
-                    let totalCalorieAdjustment = (userProfile.weightDifference * calorieFactor) / Double(daysUntilTarget)
-                    newCalorieGoal = userProfile.weekGoal < 0 ? userProfile.userBMR - Int32(totalCalorieAdjustment) : userProfile.userBMR + Int32(totalCalorieAdjustment)
-                } else {
-                    newCalorieGoal = userProfile.userBMR
-                }
-            } else {
-                newCalorieGoal = userProfile.userBMR
-            }
-            
-        case 4:
-            newCalorieGoal = userProfile.userBMR
-            
-        case 5:
-            newCalorieGoal = userProfile.customCals
-            
-        default:
-            newCalorieGoal = userProfile.userBMR
-        }
-        
-        if newCalorieGoal != userProfile.dailyCalorieGoal {
-            userProfile.dailyCalorieGoal = newCalorieGoal
-            print("DEBUG: Updated UserProfile.dailyCalorieGoal to \(newCalorieGoal) for new day")
         }
+        return dayHeader.weighIn > 0 ? String(format: "%.1f", dayHeader.weighIn) : "none"
     }
 
     // MARK: - Refactored Body Components
@@ -618,7 +385,7 @@ struct DailyDBView: View {
     private func headerView() -> some View {
         HStack {
             Button(action: {
-                selectedDate = Calendar.current.date(byAdding: .day, value: -1, to: selectedDate) ?? selectedDate
+                selectedDate = clock.calendar.date(byAdding: .day, value: -1, to: selectedDate) ?? selectedDate
                 loadDailyRecord(for: selectedDate)
             }) {
                 Image(systemName: "chevron.left")
@@ -641,7 +408,7 @@ struct DailyDBView: View {
             Spacer()
             
             Button(action: {
-                selectedDate = Calendar.current.date(byAdding: .day, value: 1, to: selectedDate) ?? selectedDate
+                selectedDate = clock.calendar.date(byAdding: .day, value: 1, to: selectedDate) ?? selectedDate
                 loadDailyRecord(for: selectedDate)
             }) {
                 Image(systemName: "chevron.right")
@@ -673,7 +440,7 @@ struct DailyDBView: View {
     private func mainContentView() -> some View {
         VStack(spacing: 15) {
             HStack(spacing: 10) {
-                Image("bolt")
+                AppAsset.bolt.image
                     .resizable()
                     .renderingMode(.template)
                     .foregroundColor(Styles.primaryText)
@@ -744,7 +511,7 @@ struct DailyDBView: View {
             
             VStack(alignment: .leading, spacing: 5) {
                 HStack(spacing: 10) {
-                    Image("CalW")
+                    AppAsset.calW.image
                         .resizable()
                         .renderingMode(.template)
                         .foregroundColor(Styles.primaryText)
@@ -843,6 +610,50 @@ struct DailyDBView: View {
                 .padding(.top, 10)
                 .padding(.trailing, 20)
             }
+            #if DEBUG
+            HStack {
+                Spacer()
+                Button(action: {
+                    PerfCounters.shared.dump()
+                }) {
+                    Image(systemName: "gauge")
+                        .font(.title3)
+                        .foregroundColor(.white)
+                        .padding(8)
+                        .background(Color.gray)
+                        .clipShape(Circle())
+                        .shadow(radius: 5)
+                }
+                .padding(.trailing, 22)
+            }
+            HStack {
+                Spacer()
+                Menu {
+                    Button("Generate 1 year") { generateHistory(SyntheticHistory.Configuration(years: 1)) }
+                    Button("Generate 5 years") { generateHistory(SyntheticHistory.Configuration(years: 5)) }
+                    Button("Generate 10 years") { generateHistory(SyntheticHistory.Configuration(years: 10)) }
+                    Button("Generate 100k entries") { generateHistory(.entries(100_000)) }
+                    Button("Remove past days", role: .destructive) { removeGeneratedHistory() }
+                    Divider()
+                    Button("Travel 30 days") { travel(days: 30) }
+                    Button("Travel 1 year") { travel(days: 365) }
+                    Button("Back to today") {
+                        clock.returnToWallClock()
+                        selectedDate = clock.today
+                    }
+                } label: {
+                    Image(systemName: isGeneratingHistory ? "hourglass" : "wand.and.stars")
+                        .font(.title3)
+                        .foregroundColor(.white)
+                        .padding(8)
+                        .background(Color.gray)
+                        .clipShape(Circle())
+                        .shadow(radius: 5)
+                }
+                .disabled(isGeneratingHistory)
+                .padding(.trailing, 22)
+            }
+            #endif
             Spacer()
         }
         .zIndex(2)
@@ -866,22 +677,11 @@ struct DailyDBView: View {
     }
 
     private func getCalorieGoalForSelectedDate() -> Double {
-        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
-        fetchRequest.predicate = NSPredicate(format: "date == %@", Calendar.current.startOfDay(for: selectedDate) as NSDate)
-        fetchRequest.fetchLimit = 1
-        do {
-            if let record = try viewContext.fetch(fetchRequest).first {
-                return record.calorieGoal
-            }
-        } catch {
-            print("❌ Error fetching calorieGoal for \(formattedDate(selectedDate)): \(error.localizedDescription)")
+        if let recordGoal = dayHeader.calorieGoal {
+            return recordGoal
         }
-        if isCurrentDay {
-            let userFetch: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-            userFetch.fetchLimit = 1
-            if let userProfile = try? viewContext.fetch(userFetch).first {
-                return Double(userProfile.dailyCalorieGoal)
-            }
+        if isCurrentDay, let profileGoal = profileStore.profile?.dailyCalorieGoal {
+            return Double(profileGoal)
         }
         return Double(calorieGoal)
     }
@@ -899,18 +699,15 @@ struct DailyDBView: View {
         .overlay(overlayView())
         .animation(nil, value: isWaterPickerPresented)
         .onAppear {
-            if let savedDate = UserDefaults.standard.object(forKey: "simulatedCurrentDate") as? Date {
-                simulatedCurrentDate = Calendar.current.startOfDay(for: savedDate)
-            }
-            selectedDate = simulatedCurrentDate
-            loadDailyRecord(for: selectedDate)
-            if isCurrentDay {
-                saveOrUpdateDailyRecord()
-            }
+            selectedDate = clock.today
+            loadDailyRecord(for: selectedDate, saveAfterLoad: true)
         }
         .onChange(of: selectedDate) { newDate in
             loadDailyRecord(for: newDate)
         }
+        .onReceive(diaryFeed.changes) { changes in
+            diaryEntries.merge(changes)
+        }
         .onChange(of: diaryEntries) { _ in
             if isCurrentDay {
                 saveOrUpdateDailyRecord()
@@ -943,39 +740,123 @@ struct DailyDBView: View {
         }
     }
 
-    private func formattedCurrentTime() -> String {
-        let formatter = DateFormatter()
-        formatter.dateFormat = "h:mm a"
-        return formatter.string(from: Date())
+    #if DEBUG
+    // Load testing: replaces the days before today with a seeded history; today's diary is kept
+    private func generateHistory(_ configuration: SyntheticHistory.Configuration) {
+        isGeneratingHistory = true
+        let today = clock.today
+        Task {
+            let generator = SyntheticDataGenerator()
+            do {
+                try await generator.removeDays(before: today)
+                try await generator.generate(SyntheticHistory(configuration, today: today))
+            } catch {
+                AppLog.error("Failed to generate history: \(error.localizedDescription)", category: .persistence)
+            }
+            await Self.rebuildArchive()
+            await MainActor.run { finishHistoryChange() }
+        }
     }
 
+    private func removeGeneratedHistory() {
+        isGeneratingHistory = true
+        let today = clock.today
+        Task {
+            do {
+                try await SyntheticDataGenerator().removeDays(before: today)
+            } catch {
+                AppLog.error("Failed to remove history: \(error.localizedDescription)", category: .persistence)
+            }
+            await Self.rebuildArchive()
+            await MainActor.run { finishHistoryChange() }
+        }
+    }
+
+    // Runs the day rollover for every day in between, like tapping the clock button `days` times
+    private func travel(days: Int) {
+        isGeneratingHistory = true
+        saveOrUpdateDailyRecord()
+        Task {
+            do {
+                try await TimeTravelEngine().advance(days: days)
+            } catch {
+                AppLog.error("Failed to time travel: \(error.localizedDescription)", category: .persistence)
+            }
+            await MainActor.run {
+                selectedDate = clock.today
+                finishHistoryChange()
+            }
+        }
+    }
+
+    // Every day before today was rewritten, so the archived columns are stale; rebuild them as DiaryImporter does
+    private static func rebuildArchive() async {
+        HistoryArchiver.shared.discard()
+        await RolloverProcessor.shared.catchUp()
+        await RolloverProcessor.shared.archiveClosedDays()
+    }
+
+    private func finishHistoryChange() {
+        WorkoutStatsIndex.shared.reload()
+        loadDailyRecord(for: selectedDate)
+        isGeneratingHistory = false
+    }
+    #endif
+
     private func debugDumpCoreData() {
+        #if DEBUG
         let dailyFetch: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
         let diaryFetch: NSFetchRequest<CoreDiaryEntry> = CoreDiaryEntry.fetchRequest()
         let weighInFetch: NSFetchRequest<WeighInEntry> = WeighInEntry.fetchRequest()
         do {
-            let dailyRecords = try viewContext.fetch(dailyFetch)
-            print("DEBUG: Total DailyRecords: \(dailyRecords.count)")
+            let dailyRecords = try viewContext.loggedFetch(dailyFetch)
+            AppLog.debug("Total DailyRecords: \(dailyRecords.count)", category: .diary)
             dailyRecords.forEach { record in
                 let entryCount = (record.diaryEntries as? Set<CoreDiaryEntry>)?.count ?? 0
                 let weighInCount = (record.weighIns as? Set<WeighInEntry>)?.count ?? 0
-                print("DailyRecord - Date: \(record.date ?? Date()), Entries: \(entryCount), WeighIns: \(weighInCount), Calorie Goal: \(record.calorieGoal), WeighIn: \(record.weighIn)")
+                AppLog.debug("DailyRecord - Date: \(record.date ?? Date()), Entries: \(entryCount), WeighIns: \(weighInCount), Calorie Goal: \(record.calorieGoal), WeighIn: \(record.weighIn)", category: .diary)
             }
-            let diaryEntries = try viewContext.fetch(diaryFetch)
-            print("DEBUG: Total CoreDiaryEntries: \(diaryEntries.count)")
+            let diaryEntries = try viewContext.loggedFetch(diaryFetch)
+            AppLog.debug("Total CoreDiaryEntries: \(diaryEntries.count)", category: .diary)
             diaryEntries.forEach { entry in
-                print("CoreDiaryEntry - Description: \(entry.entryDescription ?? "nil"), DailyRecord: \(entry.dailyRecord?.date ?? Date())")
+                AppLog.debug("CoreDiaryEntry - Description: \(entry.entryDescription ?? "nil"), DailyRecord: \(entry.dailyRecord?.date ?? Date())", category: .diary)
             }
-            let weighIns = try viewContext.fetch(weighInFetch)
-            print("DEBUG: Total WeighInEntries: \(weighIns.count)")
+            let weighIns = try viewContext.loggedFetch(weighInFetch)
+            AppLog.debug("Total WeighInEntries: \(weighIns.count)", category: .diary)
             weighIns.forEach { weighIn in
-                print("WeighInEntry - Time: \(weighIn.time ?? "nil"), Weight: \(weighIn.weight), DailyRecord: \(weighIn.dailyRecord?.date ?? Date())")
+                AppLog.debug("WeighInEntry - Time: \(weighIn.timestamp?.description ?? "nil"), Weight: \(weighIn.weight), DailyRecord: \(weighIn.dailyRecord?.date ?? Date())", category: .diary)
             }
         } catch {
-            print("❌ Error dumping Core Data: \(error)")
+            AppLog.error("Error dumping Core Data: \(error)", category: .diary)
         }
+        #endif
+    }
+
+    private struct LoadedDay {
+        let day: Date
+        var recordID: NSManagedObjectID? // nil until the day's first save creates the record
+        let previous: DaySummary?
+    }
+
+    // Weigh-ins carry no stable id in the store, so saved rows are matched on what the user entered
+    private struct WeighInKey: Hashable {
+        let timestamp: Date?
+        let weight: Double
     }
 }
 
 // Preview (optional, for development)
 
+// MARK: - Dirty Check
+private extension CoreDiaryEntry {
+    // Only the fields a save writes back. The image columns never change here, and comparing them
+    // would read the stored bytes and flag every row whose image was deferred as edited
+    func differs(from entry: DiaryEntry) -> Bool {
+        detail != entry.detail ||
+            calories != Int32(entry.calories) ||
+            fats != entry.fats ||
+            carbs != entry.carbs ||
+            protein != entry.protein ||
+            waterAmountMl != entry.waterAmountMl
+    }
+}
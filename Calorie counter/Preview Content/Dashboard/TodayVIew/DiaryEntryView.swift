@@ -7,8 +7,14 @@
 
 import SwiftUI
 
-struct DiaryEntryRow: View {
+// Equatable so the diary list can skip rows whose entry did not change
+struct DiaryEntryRow: View, Equatable {
     var entry: DiaryEntry
+    @State private var deferredImage: UIImage? // Loaded on appear when the entry's image was not fetched with it
+
+    static func == (lhs: DiaryEntryRow, rhs: DiaryEntryRow) -> Bool {
+        lhs.entry == rhs.entry
+    }
 
     var body: some View {
         HStack(spacing: 10) {
@@ -51,33 +57,32 @@ struct DiaryEntryRow: View {
                 .frame(width: 60, alignment: .trailing)
         }
         .padding(.vertical, 5)
+        .task(id: entry.id) {
+            await loadDeferredImage()
+        }
+    }
+
+    private func loadDeferredImage() async {
+        guard entry.imageDeferred, deferredImage == nil else { return }
+        do {
+            let data = try await DataRepository.shared.entryImage(id: entry.id)
+            deferredImage = data.flatMap(UIImage.decoded(from:))
+        } catch {
+            AppLog.error("Failed to load image for diary entry \(entry.id): \(error.localizedDescription)", category: .images)
+        }
     }
 
     // ✅ Function to Retrieve the Correct Image
     private func getImage(for entry: DiaryEntry) -> Image {
         if entry.type == "Water" {
-            return Image("water") // ✅ Always use "water" for water entries
-        } else if let imageData = entry.imageData, let uiImage = UIImage(data: imageData) {
+            return AppAsset.water.image // ✅ Always use "water" for water entries
+        } else if let deferredImage = deferredImage {
+            return Image(uiImage: deferredImage)
+        } else if let imageData = entry.imageData, let uiImage = UIImage.decoded(from: imageData) {
             return Image(uiImage: uiImage) // ✅ Use user-selected image if available
-        } else if let imageName = entry.imageName, isADVWorkoutImage(imageName) {
-            return Image(imageName) // ✅ Handles ADVWorkout images correctly
-        } else if entry.type == "Food" {
-            return Image("DefaultFood") // ✅ Default food image
         }
-        return Image("DefaultWorkout") // ✅ Default workout image
-    }
-
-    // ✅ Checks if the image comes from ADVWorkoutAddView
-    private func isADVWorkoutImage(_ imageName: String) -> Bool {
-        let workoutImages = [
-            "ABS", "ShuttleCock", "Baseball", "Basketball", "Boxing", "calisthenics",
-            "XSkiing", "Bikeing", "Eliptical", "Golf", "Hiking", "Hockey",
-            "Running", "MountainBike", "Paddle", "Pickle", "Pilates",
-            "racquetball", "Rockclimbing", "Rowing", "Running", "scuba",
-            "Skiing", "Snowboarding", "Soccer", "Spining", "Squash", "Swiming",
-            "tennis", "volley", "Walking", "Weights", "Yoga", "Zumba"
-        ]
-        return workoutImages.contains(imageName)
+        // ✅ Stored catalog name (workout icons), or the default for the entry type
+        return AppAsset.resolving(entry.imageName, fallback: entry.type == "Food" ? .defaultFood : .defaultWorkout).image
     }
 
     // ✅ Function to Shorten Unit Names Inside Water Entries
@@ -93,17 +98,20 @@ import Foundation
 
 struct WeighIn: Equatable, Identifiable {
     let id = UUID()
-    let time: String
+    let timestamp: Date
     let weight: String
     
+    // Display string derived at render time
+    var time: String { DateFormatter.entryTime.string(from: timestamp) }
+    
     static func == (lhs: WeighIn, rhs: WeighIn) -> Bool {
-        return lhs.time == rhs.time && lhs.weight == rhs.weight
+        return lhs.timestamp == rhs.timestamp && lhs.weight == rhs.weight
     }
 }
 
 struct DiaryEntry: Identifiable, Equatable {
-    let id = UUID()
-    let time: String
+    let id: UUID // Persisted as CoreDiaryEntry.id so rows keep their identity across reloads
+    let timestamp: Date
     let iconName: String
     let description: String
     let detail: String
@@ -114,9 +122,15 @@ struct DiaryEntry: Identifiable, Equatable {
     let fats: Double
     let carbs: Double
     let protein: Double
+    let waterAmountMl: Double // Canonical water amount, detail is display only
+    let imageDeferred: Bool // Has a stored image that was left out of the fetch; see DataRepository.entryImage(id:)
+    
+    // Display string derived at render time
+    var time: String { DateFormatter.entryTime.string(from: timestamp) }
     
-    init(time: String, iconName: String, description: String, detail: String, calories: Int, type: String, imageName: String?, imageData: Data?, fats: Double = 0, carbs: Double = 0, protein: Double = 0) {
-        self.time = time
+    init(id: UUID = UUID(), timestamp: Date, iconName: String, description: String, detail: String, calories: Int, type: String, imageName: String?, imageData: Data?, fats: Double = 0, carbs: Double = 0, protein: Double = 0, waterAmountMl: Double = 0, imageDeferred: Bool = false) {
+        self.id = id
+        self.timestamp = timestamp
         self.iconName = iconName
         self.description = description
         self.detail = detail
@@ -127,11 +141,13 @@ struct DiaryEntry: Identifiable, Equatable {
         self.fats = fats
         self.carbs = carbs
         self.protein = protein
+        self.waterAmountMl = waterAmountMl
+        self.imageDeferred = imageDeferred
     }
     
     static func == (lhs: DiaryEntry, rhs: DiaryEntry) -> Bool {
         return lhs.id == rhs.id &&
-               lhs.time == rhs.time &&
+               lhs.timestamp == rhs.timestamp &&
                lhs.iconName == rhs.iconName &&
                lhs.description == rhs.description &&
                lhs.detail == rhs.detail &&
@@ -141,7 +157,9 @@ struct DiaryEntry: Identifiable, Equatable {
                lhs.imageData == rhs.imageData &&
                lhs.fats == rhs.fats &&
                lhs.carbs == rhs.carbs &&
-               lhs.protein == rhs.protein
+               lhs.protein == rhs.protein &&
+               lhs.waterAmountMl == rhs.waterAmountMl &&
+               lhs.imageDeferred == rhs.imageDeferred
     }
 }
 
@@ -44,6 +44,7 @@ struct DiaryView: View {
                     } else {
                         ForEach(Array(diaryEntries.enumerated()), id: \.element.id) { index, entry in
                             DiaryEntryRow(entry: entry)
+                                .equatable()
                                 .frame(maxWidth: .infinity)
                                 .padding(.horizontal, 15)
                                 .background(index.isMultiple(of: 2) ? Styles.tertiaryBackground : Styles.secondaryBackground)
@@ -9,12 +9,9 @@ import CoreData
 
 struct TodayView: View {
     @Environment(\.managedObjectContext) private var viewContext
-    @State private var userName: String = "User"
-    @State private var profilePicture: UIImage? = nil
-    @State private var goalText: String = "No Goal Set" // Changed from goalMessage to goalText
-    @State private var highestStreak: Int32 = 1
-    @State private var selectedDate: Date = Date()
-    @State private var dailyCalorieGoal: Int = 2000
+    @ObservedObject private var profileStore = ProfileStore.shared
+    @State private var profilePicture: UIImage? = nil // Decoded once per picture change, not per render
+    @State private var selectedDate: Date = AppClock.shared.today
     @State private var isWaterPickerPresented: Bool = false
     @State private var selectedUnit: String = "fl oz"
     @Binding var weighIns: [WeighIn]
@@ -117,63 +114,39 @@ struct TodayView: View {
         .frame(maxWidth: .infinity, maxHeight: .infinity, alignment: .top)
         .background(Styles.primaryBackground)
         .ignoresSafeArea()
+        .profilingScreen("Today")
         .onAppear {
-            fetchUserData()
+            decodeProfilePicture(profileStore.profile?.profilePicture)
+        }
+        .onChange(of: profileStore.profile?.profilePicture) { imageData in
+            decodeProfilePicture(imageData)
         }
     }
 
-    private func fetchUserData() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "lastSavedDate", ascending: false)]
-        
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                self.userName = userProfile.name ?? "User"
-                
-                if let imageData = userProfile.profilePicture, let uiImage = UIImage(data: imageData) {
-                    self.profilePicture = uiImage
-                }
-                
-                self.goalText = userProfile.goalText ?? "No Goal Set" // Fetch static goalText
-                self.highestStreak = userProfile.highStreak
-                self.dailyCalorieGoal = Int(userProfile.dailyCalorieGoal)
-            }
-        } catch {
-            print("⚠️ ERROR: Failed to fetch user profile: \(error.localizedDescription)")
-        }
+    private var profile: ProfileSnapshot? { profileStore.profile }
+    private var userName: String { profile?.name ?? "User" }
+    private var goalText: String { profile?.goalText ?? "No Goal Set" }
+    private var highestStreak: Int32 { profile?.highStreak ?? 1 }
+    private var dailyCalorieGoal: Int { profile?.dailyCalorieGoal ?? 2000 }
+
+    private func decodeProfilePicture(_ imageData: Data?) {
+        profilePicture = imageData.flatMap(UIImage.decoded(from:))
     }
 
     private func formattedCurrentWeight() -> String {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                return String(format: "%.1f %@", userProfile.currentWeight, useMetric ? "kg" : "lbs")
-            }
-        } catch {
-            print("❌ Error fetching current weight: \(error.localizedDescription)")
-        }
-        return "N/A"
+        guard let profile = profile else { return "N/A" }
+        return String(format: "%.1f %@", profile.currentWeight, useMetric ? "kg" : "lbs")
     }
 
     private func weightDifference() -> (difference: Double, weekGoal: Double)? {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                let difference = userProfile.currentWeight - userProfile.startWeight
-                return (difference, userProfile.weekGoal)
-            }
-        } catch {
-            print("❌ Error fetching weight difference: \(error.localizedDescription)")
-        }
-        return nil
+        guard let profile = profile else { return nil }
+        return (profile.currentWeight - profile.startWeight, profile.weekGoal)
     }
 
     private static func formattedCurrentDate() -> String {
         let formatter = DateFormatter()
         formatter.dateStyle = .long
-        return formatter.string(from: Date())
+        return formatter.string(from: AppClock.shared.now)
     }
 }
 
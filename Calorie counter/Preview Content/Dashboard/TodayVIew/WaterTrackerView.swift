@@ -19,7 +19,7 @@ struct WaterTrackerView: View {
     
     var body: some View {
         HStack(spacing: 10) {
-            Image("drop")
+            AppAsset.drop.image
                 .resizable()
                 .renderingMode(.template) // Ensure it's a template image
                 .foregroundColor(Styles.primaryText) // Tint with primaryText
@@ -71,41 +71,7 @@ struct WaterTrackerView: View {
     }
 
     private func totalWaterIntake() -> CGFloat {
-        var totalIntake: CGFloat = 0
-        for entry in diaryEntries where entry.type == "Water" {
-            let (amount, unit) = extractWaterAmountAndUnit(entry.detail)
-            let convertedAmount = convertWaterUnit(amount: amount, from: unit, to: selectedUnit)
-            totalIntake += convertedAmount
-        }
-        return totalIntake
-    }
-    
-    private func extractWaterAmountAndUnit(_ detail: String) -> (CGFloat, String) {
-        let fractionMap: [String: CGFloat] = [
-            "1/4": 0.25,
-            "1/2": 0.5,
-            "3/4": 0.75,
-            "1": 1.0
-        ]
-        
-        let components = detail.split(separator: " ")
-        if components.count == 2 {
-            let amountString = String(components[0])
-            let unit = String(components[1])
-
-            if let fractionValue = fractionMap[amountString] {
-                return (fractionValue, unit)
-            } else if let amount = Double(amountString) {
-                return (CGFloat(amount), unit)
-            }
-        } else if detail.contains("fl oz") {
-            let numberString = detail.replacingOccurrences(of: "fl oz", with: "").trimmingCharacters(in: .whitespaces)
-            if let amount = Double(numberString) {
-                return (CGFloat(amount), "fl oz")
-            }
-        }
-
-        return (0, "ml")
+        CGFloat(WaterUnit.displayAmount(milliliters: diaryEntries.totalWaterMilliliters, in: selectedUnit))
     }
 
     private func formattedAmount(_ amount: CGFloat) -> String {
@@ -113,12 +79,7 @@ struct WaterTrackerView: View {
     }
 
     private func shortenUnit(_ unit: String) -> String {
-        switch unit {
-        case "Gallons": return "gal"
-        case "Liters": return "L"
-        case "Milliliters": return "ml"
-        default: return unit
-        }
+        WaterUnit(label: unit)?.shortLabel ?? unit
     }
 
     private func displayWaterText() -> String {
@@ -129,27 +90,4 @@ struct WaterTrackerView: View {
             ? "\(formattedAmount(totalDailyWater)) \(shortenUnit(selectedUnit))"
             : "\(formattedAmount(totalDailyWater)) / \(formattedAmount(waterGoal)) \(shortenUnit(selectedUnit))"
     }
-
-    private func convertWaterUnit(amount: CGFloat, from fromUnit: String, to toUnit: String) -> CGFloat {
-        let mlPerFlOz: CGFloat = 29.5735
-        let mlPerGallon: CGFloat = 3785.41
-        let mlPerLiter: CGFloat = 1000
-
-        var amountInMl: CGFloat
-        switch fromUnit.lowercased() {
-        case "milliliters", "ml": amountInMl = amount
-        case "liters", "l": amountInMl = amount * mlPerLiter
-        case "gallons", "gal": amountInMl = amount * mlPerGallon
-        case "fl", "fl oz": amountInMl = amount * mlPerFlOz
-        default: return amount
-        }
-
-        switch toUnit.lowercased() {
-        case "milliliters", "ml": return amountInMl
-        case "liters", "l": return amountInMl / mlPerLiter
-        case "gallons", "gal": return amountInMl / mlPerGallon
-        case "fl", "fl oz": return amountInMl / mlPerFlOz
-        default: return amount
-        }
-    }
 }
@@ -131,7 +131,7 @@ struct PersonalDetailsView: View {
                                     .frame(width: 100, height: 100)
                                     .clipShape(Circle())
                             } else {
-                                Image("Empty man PP")
+                                AppAsset.emptyManPP.image
                                     .resizable()
                                     .scaledToFill()
                                     .frame(width: 100, height: 100)
@@ -237,7 +237,7 @@ struct PersonalGoalsView: View {
     }
 
     private var minSelectableDate: Date {
-        Calendar.current.date(byAdding: .day, value: 7, to: Date()) ?? Date()
+        AppClock.shared.calendar.date(byAdding: .day, value: 7, to: AppClock.shared.now) ?? AppClock.shared.now
     }
 
     private func resetCalorieGoal() {
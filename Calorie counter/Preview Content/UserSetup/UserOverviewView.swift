@@ -72,7 +72,7 @@ struct UserOverviewView: View {
                                     .frame(width: 100, height: 100)
                                     .clipShape(Circle())
                             } else {
-                                Image("Empty man PP")
+                                AppAsset.emptyManPP.image
                                     .resizable()
                                     .scaledToFill()
                                     .frame(width: 100, height: 100)
@@ -160,18 +160,9 @@ struct UserOverviewView: View {
         }
     }
 
-    // MARK: - Fetch Static Goal Text
+    // MARK: - Static Goal Text
     private func fetchGoalText() -> String {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                return userProfile.goalText ?? "No Goal Set"
-            }
-        } catch {
-            print("❌ Error fetching goal text: \(error.localizedDescription)")
-        }
-        return "No Goal Set" // Fallback if no profile exists
+        ProfileStore.shared.profile?.goalText ?? "No Goal Set" // Fallback if no profile exists
     }
 }
 
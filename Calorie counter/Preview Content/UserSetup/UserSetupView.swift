@@ -79,7 +79,7 @@ struct UserSetupView: View {
                 // HEADER
                 HStack {
                     Spacer()
-                    Image("logo")
+                    AppAsset.logo.image
                         .resizable()
                         .scaledToFit()
                         .frame(width: 50, height: 50)
@@ -292,8 +292,8 @@ struct UserSetupView: View {
         userProfile.heightIn = Int32(heightInches)
         
         if let birthDate = userProfile.birthdate {
-            let calendar = Calendar.current
-            let ageComponents = calendar.dateComponents([.year], from: birthDate, to: Date())
+            let calendar = AppClock.shared.calendar
+            let ageComponents = calendar.dateComponents([.year], from: birthDate, to: AppClock.shared.now)
             userProfile.age = Int32(ageComponents.year ?? 0)
         } else {
             userProfile.age = 0
@@ -335,7 +335,7 @@ struct UserSetupView: View {
             userProfile.goalId = 5
         }
         
-        userProfile.lastSavedDate = Date()
+        userProfile.lastSavedDate = AppClock.shared.now
         
         // Set static goal text
         userProfile.goalText = generateGoalText(
@@ -66,66 +66,50 @@ struct WelcomeSequenceView: View {
         .ignoresSafeArea()
     }
 
-    /// Fetch user profile from Core Data and calculate necessary values
+    /// Read the goal inputs from the profile store and store the daily calorie difference
     private func fetchUserProfile() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "lastSavedDate", ascending: false)]
-
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                viewContext.refresh(userProfile, mergeChanges: true)
-
-                self.weekGoal = userProfile.weekGoal
-                self.userBMR = userProfile.userBMR // Int32
-                self.goalId = userProfile.goalId
-                self.useMetric = userProfile.useMetric
-                self.weightDifference = userProfile.weightDifference // Now Double
-                self.customCals = userProfile.customCals // Int32
-                self.goalDate = userProfile.targetDate
-
-                let calorieFactor: Double = self.useMetric ? 7000.0 : 3500.0
-                self.dailyCalorieDif = Int32((calorieFactor * self.weekGoal) / 7)
-                userProfile.dailyCalorieDif = self.dailyCalorieDif
-
-                try viewContext.save()
-
-                print("---- FETCHED FROM CORE DATA ----")
-                print("Week Goal: \(self.weekGoal)")
-                print("User BMR: \(self.userBMR)")
-                print("Goal ID: \(self.goalId)")
-                print("Use Metric: \(self.useMetric)")
-                print("Daily Calorie Difference: \(self.dailyCalorieDif)")
-                print("Weight Difference: \(self.weightDifference)")
-                print("Custom Calories: \(self.customCals)")
-                print("Goal Date: \(self.goalDate?.description ?? "nil")")
-                print("-------------------------------")
-
-                self.startMessageSequence()
-            } else {
-                print("⚠️ ERROR: No UserProfile found in CoreData")
-            }
-        } catch {
-            print("⚠️ ERROR: Failed to fetch user profile: \(error.localizedDescription)")
+        let didUpdate = ProfileStore.shared.update { userProfile in
+            self.weekGoal = userProfile.weekGoal
+            self.userBMR = userProfile.userBMR // Int32
+            self.goalId = userProfile.goalId
+            self.useMetric = userProfile.useMetric
+            self.weightDifference = userProfile.weightDifference // Now Double
+            self.customCals = userProfile.customCals // Int32
+            self.goalDate = userProfile.targetDate
+
+            let calorieFactor: Double = self.useMetric ? 7000.0 : 3500.0
+            self.dailyCalorieDif = Int32((calorieFactor * self.weekGoal) / 7)
+            userProfile.dailyCalorieDif = self.dailyCalorieDif
+        }
+        guard didUpdate else {
+            print("⚠️ ERROR: No UserProfile found in CoreData")
+            return
         }
+
+        print("---- FETCHED FROM CORE DATA ----")
+        print("Week Goal: \(self.weekGoal)")
+        print("User BMR: \(self.userBMR)")
+        print("Goal ID: \(self.goalId)")
+        print("Use Metric: \(self.useMetric)")
+        print("Daily Calorie Difference: \(self.dailyCalorieDif)")
+        print("Weight Difference: \(self.weightDifference)")
+        print("Custom Calories: \(self.customCals)")
+        print("Goal Date: \(self.goalDate?.description ?? "nil")")
+        print("-------------------------------")
+
+        self.startMessageSequence()
     }
 
     /// Set UserProfile.startDate to current date
     private func setStartDate() {
-        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-        fetchRequest.fetchLimit = 1
-        do {
-            if let userProfile = try viewContext.fetch(fetchRequest).first {
-                userProfile.startDate = Calendar.current.startOfDay(for: Date())
-                try viewContext.save()
-                print("✅ Set UserProfile.startDate to \(userProfile.startDate!)")
-            } else {
-                let newProfile = UserProfile(context: viewContext)
-                newProfile.startDate = Calendar.current.startOfDay(for: Date())
-                try viewContext.save()
-                print("✅ Created new UserProfile with startDate: \(newProfile.startDate!)")
+        let startDate = AppClock.shared.today
+        let profileStore = ProfileStore.shared
+        if profileStore.profile != nil {
+            if profileStore.update({ $0.startDate = startDate }) {
+                print("✅ Set UserProfile.startDate to \(startDate)")
             }
-        } catch {
-            print("❌ Error setting startDate: \(error.localizedDescription)")
+        } else if profileStore.createProfileIfNeeded({ $0.startDate = startDate }) {
+            print("✅ Created new UserProfile with startDate: \(startDate)")
         }
     }
 
@@ -203,9 +187,9 @@ struct WelcomeSequenceView: View {
         guard weekGoal > 0 else { return "Unknown" }
 
         let totalDaysNeeded = (weightDifference / weekGoal) * 7
-        let calendar = Calendar.current
+        let calendar = AppClock.shared.calendar
 
-        if let estimatedDate = calendar.date(byAdding: .day, value: Int(ceil(totalDaysNeeded)), to: Date()) {
+        if let estimatedDate = calendar.date(byAdding: .day, value: Int(ceil(totalDaysNeeded)), to: AppClock.shared.now) {
             let formatter = DateFormatter()
             formatter.dateStyle = .medium
             return formatter.string(from: estimatedDate)
@@ -219,7 +203,7 @@ struct WelcomeSequenceView: View {
         guard let targetDate = targetDate else { return userBMR }
 
         let calorieFactor: Double = useMetric ? 7000.0 : 3500.0
-        let daysUntilTarget = Calendar.current.dateComponents([.day], from: Date(), to: targetDate).day ?? 0
+        let daysUntilTarget = AppClock.shared.calendar.dateComponents([.day], from: AppClock.shared.now, to: targetDate).day ?? 0
 
         guard daysUntilTarget > 0 else { return userBMR }
 
@@ -258,17 +242,8 @@ struct WelcomeSequenceView: View {
 
     private func updateDailyCalorieGoal(_ calories: Int32) {
         DispatchQueue.main.async {
-            let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
-            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "lastSavedDate", ascending: false)]
-            
-            do {
-                if let userProfile = try viewContext.fetch(fetchRequest).first {
-                    userProfile.dailyCalorieGoal = calories
-                    try viewContext.save()
-                    print("✅ DailyCalorieGoal Updated: \(calories)")
-                }
-            } catch {
-                print("⚠️ ERROR: Failed to save dailyCalorieGoal to Core Data: \(error.localizedDescription)")
+            if ProfileStore.shared.update({ $0.dailyCalorieGoal = calories }) {
+                print("✅ DailyCalorieGoal Updated: \(calories)")
             }
         }
     }
@@ -0,0 +1,166 @@
+//
+//  ProfileStore.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+import Combine
+
+// MARK: - Profile Store
+// The one place the UserProfile is fetched. Loads it once, publishes ProfileSnapshot values,
+// and stays current through the view context's change notifications.
+final class ProfileStore: ObservableObject {
+    static let shared = ProfileStore(context: PersistenceController.shared.context)
+
+    @Published private(set) var profile: ProfileSnapshot?
+
+    private let context: NSManagedObjectContext
+    private var profileID: NSManagedObjectID?
+    private var changeObserver: AnyCancellable?
+    private var isLoaded = false
+
+    init(context: NSManagedObjectContext) {
+        self.context = context
+        changeObserver = NotificationCenter.default
+            .publisher(for: .NSManagedObjectContextObjectsDidChange, object: context)
+            .merge(with: NotificationCenter.default.publisher(for: .NSManagedObjectContextDidSave, object: context))
+            .sink { [weak self] notification in
+                self?.applyChanges(notification)
+            }
+    }
+
+    // Called once by StartupPipeline, which reads the profile on the repository's background context;
+    // later calls are no-ops
+    @MainActor
+    func load(from repository: DataRepository) async {
+        guard !isLoaded else { return }
+        isLoaded = true
+        do {
+            let stored = try await repository.storedProfile()
+            profileID = stored?.objectID
+            profile = stored?.snapshot
+        } catch {
+            AppLog.error("Failed to load user profile: \(error.localizedDescription)", category: .profile)
+        }
+    }
+
+    func reload() {
+        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "lastSavedDate", ascending: false)]
+        fetchRequest.fetchLimit = 1
+        do {
+            let userProfile = try context.loggedFetch(fetchRequest).first
+            profileID = userProfile?.objectID
+            profile = userProfile.map(ProfileSnapshot.init)
+        } catch {
+            AppLog.error("Failed to load user profile: \(error.localizedDescription)", category: .profile)
+        }
+    }
+
+    // For screens that still need the object itself (relationships); a registered-object lookup, not a fetch
+    var managedProfile: UserProfile? {
+        profileID.flatMap { try? context.existingObject(with: $0) as? UserProfile }
+    }
+
+    // MARK: Mutations
+    // Changes run on a child context and are pushed to the view context in one save,
+    // so a failed closure or save leaves the published profile untouched
+    @discardableResult
+    func update(_ changes: (UserProfile) throws -> Void) -> Bool {
+        guard let profileID = profileID else {
+            AppLog.warning("No UserProfile to update", category: .profile)
+            return false
+        }
+        return performTransaction { transaction in
+            guard let userProfile = try transaction.existingObject(with: profileID) as? UserProfile else { return }
+            try changes(userProfile)
+        }
+    }
+
+    // Like update, but the changes are left in the view context for the caller's next save, so they
+    // commit together with the caller's own edits (the Today screen's record) in one transaction
+    @discardableResult
+    func stage(_ changes: (UserProfile) throws -> Void) -> Bool {
+        guard let profileID = profileID else {
+            AppLog.warning("No UserProfile to update", category: .profile)
+            return false
+        }
+        return performTransaction(saving: false) { transaction in
+            guard let userProfile = try transaction.existingObject(with: profileID) as? UserProfile else { return }
+            try changes(userProfile)
+        }
+    }
+
+    // Runs `configure` only when no profile exists yet
+    @discardableResult
+    func createProfileIfNeeded(_ configure: (UserProfile) -> Void) -> Bool {
+        guard profileID == nil else { return true }
+        return performTransaction { transaction in
+            configure(UserProfile(context: transaction))
+        }
+    }
+
+    private func performTransaction(saving: Bool = true, _ body: (NSManagedObjectContext) throws -> Void) -> Bool {
+        let transaction = NSManagedObjectContext(concurrencyType: .mainQueueConcurrencyType)
+        transaction.parent = context
+        transaction.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        do {
+            try body(transaction)
+            guard transaction.hasChanges else { return true }
+            try transaction.obtainPermanentIDs(for: Array(transaction.insertedObjects))
+            try transaction.save()
+        } catch {
+            AppLog.error("Profile update rolled back: \(error.localizedDescription)", category: .profile)
+            return false
+        }
+        guard saving else {
+            // Publishes the new snapshot now rather than at the end of the run loop
+            context.processPendingChanges()
+            return true
+        }
+        do {
+            try AppLog.interval("Save profile", category: .profile) {
+                try context.save()
+            }
+            return true
+        } catch {
+            // Undo only the profile's pending changes, other unsaved work in the view context stays
+            if let userProfile = managedProfile {
+                context.refresh(userProfile, mergeChanges: false)
+            }
+            AppLog.error("Failed to save user profile: \(error.localizedDescription)", category: .profile)
+            return false
+        }
+    }
+
+    // MARK: Sync
+    private func applyChanges(_ notification: Notification) {
+        guard let userInfo = notification.userInfo else { return }
+        if userInfo[NSInvalidatedAllObjectsKey] != nil {
+            reload()
+            return
+        }
+
+        let removed = ((userInfo[NSDeletedObjectsKey] as? Set<NSManagedObject>) ?? [])
+            .union((userInfo[NSInvalidatedObjectsKey] as? Set<NSManagedObject>) ?? [])
+        if let profileID = profileID, removed.contains(where: { $0.objectID == profileID }) {
+            self.profileID = nil
+            profile = nil
+        }
+
+        for key in [NSInsertedObjectsKey, NSUpdatedObjectsKey, NSRefreshedObjectsKey] {
+            for case let userProfile as UserProfile in (userInfo[key] as? Set<NSManagedObject>) ?? [] where !userProfile.isDeleted {
+                // Adopt a newly created profile (setup flow) once it has a permanent ID
+                if profileID == nil || profileID!.isTemporaryID, !userProfile.objectID.isTemporaryID {
+                    profileID = userProfile.objectID
+                }
+                guard userProfile.objectID == profileID else { continue }
+                let snapshot = ProfileSnapshot(userProfile)
+                if snapshot != profile {
+                    profile = snapshot
+                }
+            }
+        }
+    }
+}
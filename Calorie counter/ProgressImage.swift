@@ -14,7 +14,7 @@ struct ProgressImage: View {
 
     var body: some View {
         GeometryReader { geometry in
-            if let data = imageData, let image = UIImage(data: data) {
+            if let data = imageData, let image = UIImage.decoded(from: data) {
                 Image(uiImage: image)
                     .resizable()
                     .aspectRatio(contentMode: .fill) // Fills the space while retaining aspect ratio
@@ -19,18 +19,18 @@ struct ProgressPicsView: View {
 
     private var emptyProfilePlaceholder: UIImage {
         if let gender = userProfile.gender, gender.lowercased() == "woman" {
-            return UIImage(named: "Empty woman PP") ?? UIImage()
+            return AppAsset.emptyWomanPP.uiImage ?? UIImage()
         } else {
-            return UIImage(named: "Empty man PP") ?? UIImage()
+            return AppAsset.emptyManPP.uiImage ?? UIImage()
         }
     }
 
     private var mostRecentSetupPicture: Data? {
-        userProfile.startPicture
+        userProfile.startPictureDisplay ?? userProfile.startPicture
     }
 
     private var mostRecentProgressPicture: Data? {
-        progressPictures.first?.imageData
+        progressPictures.first.flatMap { $0.displayData ?? $0.imageData }
     }
 
     var body: some View {
@@ -56,7 +56,7 @@ struct ProgressPicsView: View {
                             selectedPicture = picture
                         } label: {
                             HStack {
-                                if let data = picture.imageData, let image = UIImage(data: data) {
+                                if let data = picture.thumbnailData ?? picture.imageData, let image = UIImage.decoded(from: data) {
                                     Image(uiImage: image)
                                         .resizable()
                                         .scaledToFit()
@@ -12,7 +12,7 @@ struct ProgressPictureDetailView: View {
     
     var body: some View {
         VStack {
-            if let data = progressPicture.imageData, let image = UIImage(data: data) {
+            if let data = progressPicture.displayData ?? progressPicture.imageData, let image = UIImage.decoded(from: data) {
                 Image(uiImage: image)
                     .resizable()
                     .scaledToFit()
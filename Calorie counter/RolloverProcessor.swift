@@ -0,0 +1,130 @@
+//
+//  RolloverProcessor.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Rollover Processor
+// Catches up on days the app was not opened. At launch and on every return to the foreground it closes
+// the last day the user saw, creates and closes each missing day with the same rules as the Today screen,
+// and opens today, all in one transaction on a private-queue context. Appending closed days to the history
+// archive is a separate step, started once the UI is up since the first one backfills the whole history.
+final class RolloverProcessor {
+    static let shared = RolloverProcessor(persistence: .shared, clock: .shared, archiver: .shared)
+
+    private let persistence: PersistenceController
+    private let clock: AppClock
+    private let archiver: HistoryArchiver?
+    private let lock = NSLock()
+    private var running: Task<TimeTravelEngine.Report?, Never>?
+    private var archiving: Task<Void, Never>?
+
+    init(persistence: PersistenceController, clock: AppClock, archiver: HistoryArchiver? = nil) {
+        self.persistence = persistence
+        self.clock = clock
+        self.archiver = archiver
+    }
+
+    // Overlapping calls (launch and the first foreground event) join the run already in flight.
+    // Returns once the roll is saved; nil when there was nothing to catch up on.
+    @discardableResult
+    func catchUp() async -> TimeTravelEngine.Report? {
+        lock.lock()
+        if let running = running {
+            lock.unlock()
+            return await running.value
+        }
+        let task = Task { await run() }
+        running = task
+        lock.unlock()
+
+        let report = await task.value
+        lock.lock()
+        running = nil
+        lock.unlock()
+        return report
+    }
+
+    private func run() async -> TimeTravelEngine.Report? {
+        let calendar = clock.calendar
+        let today = clock.today
+        let context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+        do {
+            try await persistence.waitForStores()
+            let report = try await AppLog.interval("Day rollover", category: .persistence) {
+                try await context.perform { () -> TimeTravelEngine.Report? in
+                    guard let profileID = try SyntheticDataGenerator.profileID(in: context),
+                          let userProfile = try context.existingObject(with: profileID) as? UserProfile,
+                          let lastDay = try Self.lastOpenedDay(for: userProfile, through: today, calendar: calendar, in: context),
+                          lastDay < today else {
+                        return nil
+                    }
+                    let report = try TimeTravelEngine.roll(from: lastDay, to: today, profileID: profileID, calendar: calendar, in: context)
+                    AppLog.info("Rolled over \(report.days) day(s) since \(lastDay)", category: .persistence)
+                    return report
+                }
+            }
+            return report
+        } catch {
+            context.rollback()
+            AppLog.error("Day rollover failed: \(error.localizedDescription)", category: .persistence)
+            return nil
+        }
+    }
+
+    // MARK: Archiving
+    // Appends every closed day the archive doesn't have, after a catch-up or once it's been discarded.
+    // Overlapping calls join the append in flight. A failed append leaves the archive as it was;
+    // the same days are tried again next time.
+    func archiveClosedDays() async {
+        lock.lock()
+        if let archiving = archiving {
+            lock.unlock()
+            return await archiving.value
+        }
+        let task = Task(priority: .utility) { await archive() }
+        archiving = task
+        lock.unlock()
+
+        await task.value
+        lock.lock()
+        archiving = nil
+        lock.unlock()
+    }
+
+    private func archive() async {
+        guard let archiver = archiver else { return }
+        let today = clock.today
+        let context = persistence.container.newBackgroundContext()
+        context.undoManager = nil
+        do {
+            try await persistence.waitForStores()
+            try await AppLog.interval("History archive append", category: .persistence) {
+                try await context.perform {
+                    try archiver.archiveClosedDays(before: today, in: context)
+                }
+            }
+        } catch {
+            AppLog.error("History archive append failed: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // The later of the profile's lastSavedDate and the newest record up to today. The newest record
+    // covers installs from before lastSavedDate was kept current; nil for a profile with no days yet.
+    private static func lastOpenedDay(for userProfile: UserProfile, through today: Date, calendar: Calendar, in context: NSManagedObjectContext) throws -> Date? {
+        let fetchRequest = NSFetchRequest<NSDictionary>(entityName: "DailyRecord")
+        fetchRequest.resultType = .dictionaryResultType
+        fetchRequest.propertiesToFetch = ["date"]
+        fetchRequest.predicate = NSPredicate(format: "date <= %@", today as NSDate)
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "date", ascending: false)]
+        fetchRequest.fetchLimit = 1
+        let newestRecord = try context.fetch(fetchRequest).first?["date"] as? Date
+
+        let candidates = [userProfile.lastSavedDate, newestRecord].compactMap { $0 }.map { calendar.startOfDay(for: $0) }
+        return candidates.filter { $0 <= today }.max()
+    }
+}
@@ -0,0 +1,192 @@
+//
+//  ShareCardCompositor.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Pixel Buffer
+// Premultiplied RGBA, 8 bits per channel, rows packed with no padding; the same layout as a
+// CGContext with premultipliedLast | byteOrder32Big. Foundation only, so compositing runs headless.
+struct PixelColor: Hashable {
+    var red: UInt8
+    var green: UInt8
+    var blue: UInt8
+    var alpha: UInt8
+
+    static let black = PixelColor(red: 0, green: 0, blue: 0, alpha: 255)
+    static let clear = PixelColor(red: 0, green: 0, blue: 0, alpha: 0)
+
+    // From straight (non-premultiplied) components in 0...1
+    init(red: Double, green: Double, blue: Double, opacity: Double = 1) {
+        func channel(_ value: Double) -> UInt8 { UInt8((min(max(value, 0), 1) * 255).rounded()) }
+        self.init(red: channel(red * opacity), green: channel(green * opacity), blue: channel(blue * opacity), alpha: channel(opacity))
+    }
+
+    init(red: UInt8, green: UInt8, blue: UInt8, alpha: UInt8) {
+        self.red = red
+        self.green = green
+        self.blue = blue
+        self.alpha = alpha
+    }
+}
+
+struct PixelRect: Equatable {
+    var x: Int
+    var y: Int
+    var width: Int
+    var height: Int
+
+    var isEmpty: Bool { width <= 0 || height <= 0 }
+
+    func clipped(width bufferWidth: Int, height bufferHeight: Int) -> PixelRect {
+        let minX = max(x, 0), minY = max(y, 0)
+        let maxX = min(x + width, bufferWidth), maxY = min(y + height, bufferHeight)
+        return PixelRect(x: minX, y: minY, width: max(0, maxX - minX), height: max(0, maxY - minY))
+    }
+}
+
+struct PixelBuffer: Equatable {
+    let width: Int
+    let height: Int
+    var bytes: [UInt8] // width * height * 4
+
+    init(width: Int, height: Int, fill color: PixelColor = .clear) {
+        self.width = width
+        self.height = height
+        self.bytes = [UInt8](repeating: 0, count: width * height * 4)
+        if color != .clear {
+            fill(PixelRect(x: 0, y: 0, width: width, height: height), with: color)
+        }
+    }
+
+    init?(width: Int, height: Int, bytes: [UInt8]) {
+        guard width > 0, height > 0, bytes.count == width * height * 4 else { return nil }
+        self.width = width
+        self.height = height
+        self.bytes = bytes
+    }
+
+    subscript(x: Int, y: Int) -> PixelColor {
+        let offset = (y * width + x) * 4
+        return PixelColor(red: bytes[offset], green: bytes[offset + 1], blue: bytes[offset + 2], alpha: bytes[offset + 3])
+    }
+
+    // Source-over; an opaque color simply replaces what is there
+    mutating func fill(_ rect: PixelRect, with color: PixelColor) {
+        let rect = rect.clipped(width: width, height: height)
+        guard !rect.isEmpty, color.alpha > 0 else { return }
+        let inverse = 255 - UInt32(color.alpha)
+        let width = self.width
+        bytes.withUnsafeMutableBufferPointer { bytes in
+            for y in rect.y..<(rect.y + rect.height) {
+                var offset = (y * width + rect.x) * 4
+                for _ in 0..<rect.width {
+                    if inverse == 0 {
+                        bytes[offset] = color.red
+                        bytes[offset + 1] = color.green
+                        bytes[offset + 2] = color.blue
+                        bytes[offset + 3] = 255
+                    } else {
+                        bytes[offset] = color.red &+ Self.scale(bytes[offset], by: inverse)
+                        bytes[offset + 1] = color.green &+ Self.scale(bytes[offset + 1], by: inverse)
+                        bytes[offset + 2] = color.blue &+ Self.scale(bytes[offset + 2], by: inverse)
+                        bytes[offset + 3] = color.alpha &+ Self.scale(bytes[offset + 3], by: inverse)
+                    }
+                    offset += 4
+                }
+            }
+        }
+    }
+
+    // Scales `source` to cover `rect` and crops the overflow evenly from both sides, like a centred
+    // aspect-fill. Each destination pixel averages the source block it covers, so downscaling doesn't alias.
+    mutating func drawAspectFill(_ source: PixelBuffer, in rect: PixelRect) {
+        guard !rect.isEmpty, source.width > 0, source.height > 0 else { return }
+        let scale = max(Double(rect.width) / Double(source.width), Double(rect.height) / Double(source.height))
+        let cropWidth = Double(rect.width) / scale
+        let cropHeight = Double(rect.height) / scale
+        let cropX = (Double(source.width) - cropWidth) / 2
+        let cropY = (Double(source.height) - cropHeight) / 2
+        let step = 1 / scale
+
+        let clipped = rect.clipped(width: width, height: height)
+        guard !clipped.isEmpty else { return }
+        let sourceWidth = source.width
+        let sourceHeight = source.height
+        let destinationWidth = width
+        source.bytes.withUnsafeBufferPointer { sourceBytes in
+            bytes.withUnsafeMutableBufferPointer { bytes in
+                for y in clipped.y..<(clipped.y + clipped.height) {
+                    let top = cropY + Double(y - rect.y) * step
+                    let y0 = min(Int(top), sourceHeight - 1)
+                    let y1 = min(max(y0 + 1, Int((top + step).rounded(.up))), sourceHeight)
+                    for x in clipped.x..<(clipped.x + clipped.width) {
+                        let left = cropX + Double(x - rect.x) * step
+                        let x0 = min(Int(left), sourceWidth - 1)
+                        let x1 = min(max(x0 + 1, Int((left + step).rounded(.up))), sourceWidth)
+                        var red = 0, green = 0, blue = 0, alpha = 0
+                        for sy in y0..<y1 {
+                            var offset = (sy * sourceWidth + x0) * 4
+                            for _ in x0..<x1 {
+                                red += Int(sourceBytes[offset])
+                                green += Int(sourceBytes[offset + 1])
+                                blue += Int(sourceBytes[offset + 2])
+                                alpha += Int(sourceBytes[offset + 3])
+                                offset += 4
+                            }
+                        }
+                        let count = (y1 - y0) * (x1 - x0)
+                        let offset = (y * destinationWidth + x) * 4
+                        bytes[offset] = UInt8(red / count)
+                        bytes[offset + 1] = UInt8(green / count)
+                        bytes[offset + 2] = UInt8(blue / count)
+                        bytes[offset + 3] = UInt8(alpha / count)
+                    }
+                }
+            }
+        }
+    }
+
+    @inline(__always)
+    private static func scale(_ value: UInt8, by factor: UInt32) -> UInt8 {
+        UInt8((UInt32(value) * factor + 127) / 255)
+    }
+}
+
+// MARK: - Share Card
+// Geometry and the image layer of the before/after card. Text and the app icon are drawn on top
+// by ShareCardRenderer, which has UIKit; everything here is plain pixel arithmetic.
+enum ShareCard {
+    struct Layout: Equatable {
+        static let canvasSize = 600 // Points
+        static let imageSize = 300
+        static let padding = 20
+        static let logoHeight = 80
+        static let imageTop = padding + logoHeight + padding
+
+        let scale: Int // Pixels per point
+        let titleOverlayWidth: Int // Points; measured by the caller, since it depends on the title font
+
+        var canvas: PixelRect { pixels(0, 0, Self.canvasSize, Self.canvasSize) }
+        var titleOverlay: PixelRect { pixels((Self.canvasSize - titleOverlayWidth) / 2, Self.padding, titleOverlayWidth, Self.logoHeight) }
+        var startImage: PixelRect { pixels(0, Self.imageTop, Self.imageSize, Self.imageSize) }
+        var latestImage: PixelRect { pixels(Self.imageSize, Self.imageTop, Self.imageSize, Self.imageSize) }
+        var captionTop: Int { Self.imageTop + Self.imageSize + Self.padding } // Points
+
+        private func pixels(_ x: Int, _ y: Int, _ width: Int, _ height: Int) -> PixelRect {
+            PixelRect(x: x * scale, y: y * scale, width: width * scale, height: height * scale)
+        }
+    }
+
+    static let titleOverlayColor = PixelColor(red: 0.0, green: 0.0, blue: 0.0, opacity: 0.6)
+
+    // Background, the translucent title box and both photos, each centre-cropped to a square
+    static func composite(start: PixelBuffer, latest: PixelBuffer, background: PixelColor, layout: Layout) -> PixelBuffer {
+        var card = PixelBuffer(width: layout.canvas.width, height: layout.canvas.height, fill: background)
+        card.fill(layout.titleOverlay, with: titleOverlayColor)
+        card.drawAspectFill(start, in: layout.startImage)
+        card.drawAspectFill(latest, in: layout.latestImage)
+        return card
+    }
+}
@@ -0,0 +1,196 @@
+//
+//  ShareCardRenderer.swift
+//  Calorie counter
+//
+
+import UIKit
+import CoreData
+
+// MARK: - Share Card Input
+// Everything that changes the card's pixels; equal inputs reuse the cached card
+struct ShareCardInput: Hashable {
+    enum WeightTrend: Hashable {
+        case unchanged, towardGoal, awayFromGoal
+    }
+
+    let startPhotoID: NSManagedObjectID? // The UserProfile, for its start picture
+    let latestPhotoID: NSManagedObjectID? // A ProgressPicture, or the UserProfile when the start picture is selected
+    let placeholder: AppAsset // Drawn in place of a missing photo
+    let days: Int
+    let weightText: String
+    let weightTrend: WeightTrend
+    let background: PixelColor
+}
+
+// MARK: - Share Card Renderer
+// Builds the before/after card off the main thread from the display renditions. The photo layer is
+// composited by ShareCard; the logo and captions are drawn over it here. A few recent cards are kept.
+final class ShareCardRenderer {
+    static let shared = ShareCardRenderer(repository: .shared)
+
+    private static let scale = 2
+    private static let cacheLimit = 4
+    private static let title = "Calorie Counter"
+    private static let titleAttributes: [NSAttributedString.Key: Any] = [
+        .font: UIFont.systemFont(ofSize: 20, weight: .medium),
+        .foregroundColor: UIColor.white
+    ]
+    private static let logoWidth: CGFloat = 60
+
+    private let repository: DataRepository
+    private let lock = NSLock()
+    private var cards: [ShareCardInput: UIImage] = [:]
+    private var rendering: [ShareCardInput: Task<UIImage, Never>] = [:]
+
+    init(repository: DataRepository) {
+        self.repository = repository
+    }
+
+    func card(for input: ShareCardInput) async -> UIImage {
+        lock.lock()
+        if let card = cards[input] {
+            lock.unlock()
+            return card
+        }
+        let task = rendering[input] ?? Task.detached(priority: .userInitiated) { [self] in
+            await render(input)
+        }
+        rendering[input] = task
+        lock.unlock()
+
+        let card = await task.value
+        lock.lock()
+        rendering[input] = nil
+        if cards.count >= Self.cacheLimit {
+            cards.removeAll()
+        }
+        cards[input] = card
+        lock.unlock()
+        return card
+    }
+
+    // Drops cached cards that show this photo, e.g. after it is deleted
+    func invalidate(photoID: NSManagedObjectID) {
+        lock.lock()
+        cards = cards.filter { $0.key.startPhotoID != photoID && $0.key.latestPhotoID != photoID }
+        lock.unlock()
+    }
+
+    // MARK: Rendering
+    private func render(_ input: ShareCardInput) async -> UIImage {
+        await AppLog.interval("Share card", category: .images) {
+            let titleWidth = (Self.title as NSString).size(withAttributes: Self.titleAttributes).width
+            let overlayWidth = Int((Self.logoWidth + 10 + titleWidth + 20).rounded(.up)) // Icon + spacing + title + padding
+            let layout = ShareCard.Layout(scale: Self.scale, titleOverlayWidth: overlayWidth)
+
+            async let start = pixels(for: input.startPhotoID, placeholder: input.placeholder, side: layout.startImage.width)
+            async let latest = pixels(for: input.latestPhotoID, placeholder: input.placeholder, side: layout.latestImage.width)
+            let photoLayer = ShareCard.composite(start: await start, latest: await latest, background: input.background, layout: layout)
+            return annotate(photoLayer, input: input, layout: layout)
+        }
+    }
+
+    // Decoded no larger than the square it fills, plus a margin for non-square crops
+    private func pixels(for objectID: NSManagedObjectID?, placeholder: AppAsset, side: Int) async -> PixelBuffer {
+        var image: CGImage?
+        if let objectID = objectID {
+            do {
+                if let data = try await repository.photoData(objectID, size: .display) {
+                    image = PhotoIngest.thumbnailImage(from: data, maxPixelSize: side * 4 / 3)?.cgImage
+                }
+            } catch {
+                AppLog.error("Failed to load photo for share card: \(error.localizedDescription)", category: .images)
+            }
+        }
+        if image == nil {
+            image = placeholder.uiImage?.cgImage
+        }
+        return image.flatMap(PixelBuffer.init(cgImage:)) ?? PixelBuffer(width: 1, height: 1, fill: .black)
+    }
+
+    private func annotate(_ photoLayer: PixelBuffer, input: ShareCardInput, layout: ShareCard.Layout) -> UIImage {
+        let canvasSize = CGFloat(ShareCard.Layout.canvasSize)
+        let padding = CGFloat(ShareCard.Layout.padding)
+        let logoHeight = CGFloat(ShareCard.Layout.logoHeight)
+        let overlayWidth = CGFloat(layout.titleOverlayWidth)
+        let captionTop = CGFloat(layout.captionTop)
+
+        let format = UIGraphicsImageRendererFormat()
+        format.scale = CGFloat(Self.scale)
+        let renderer = UIGraphicsImageRenderer(size: CGSize(width: canvasSize, height: canvasSize), format: format)
+        return renderer.image { _ in
+            if let cgImage = photoLayer.makeCGImage() {
+                UIImage(cgImage: cgImage).draw(in: CGRect(x: 0, y: 0, width: canvasSize, height: canvasSize))
+            }
+
+            if let appIcon = UIImage(named: "AppIcon")?.withRenderingMode(.alwaysOriginal) {
+                appIcon.draw(in: CGRect(x: (canvasSize - overlayWidth) / 2 + 10, y: padding + 10, width: Self.logoWidth, height: Self.logoWidth))
+            }
+            let titleSize = (Self.title as NSString).size(withAttributes: Self.titleAttributes)
+            (Self.title as NSString).draw(
+                in: CGRect(x: (canvasSize - overlayWidth) / 2 + Self.logoWidth + 20, y: padding + (logoHeight - titleSize.height) / 2, width: titleSize.width, height: titleSize.height),
+                withAttributes: Self.titleAttributes
+            )
+
+            let daysText = "\(input.days) Days" as NSString
+            let daysAttributes: [NSAttributedString.Key: Any] = [
+                .font: UIFont.systemFont(ofSize: 48, weight: .regular),
+                .foregroundColor: UIColor.black
+            ]
+            let daysSize = daysText.size(withAttributes: daysAttributes)
+            daysText.draw(in: CGRect(x: padding, y: captionTop, width: daysSize.width, height: daysSize.height), withAttributes: daysAttributes)
+
+            let weightText = input.weightText as NSString
+            let weightAttributes: [NSAttributedString.Key: Any] = [
+                .font: UIFont.systemFont(ofSize: 48, weight: .bold),
+                .foregroundColor: Self.color(for: input.weightTrend)
+            ]
+            let weightSize = weightText.size(withAttributes: weightAttributes)
+            weightText.draw(in: CGRect(x: canvasSize - padding - weightSize.width, y: captionTop, width: weightSize.width, height: weightSize.height), withAttributes: weightAttributes)
+        }
+    }
+
+    private static func color(for trend: ShareCardInput.WeightTrend) -> UIColor {
+        switch trend {
+        case .unchanged: return .gray
+        case .towardGoal: return .green
+        case .awayFromGoal: return .red
+        }
+    }
+}
+
+// MARK: - Core Graphics Bridging
+extension PixelBuffer {
+    private static let bitmapInfo = CGImageAlphaInfo.premultipliedLast.rawValue | CGBitmapInfo.byteOrder32Big.rawValue
+
+    init?(cgImage: CGImage) {
+        let width = cgImage.width
+        let height = cgImage.height
+        var bytes = [UInt8](repeating: 0, count: width * height * 4)
+        let drawn = bytes.withUnsafeMutableBytes { buffer -> Bool in
+            guard let context = CGContext(data: buffer.baseAddress, width: width, height: height, bitsPerComponent: 8, bytesPerRow: width * 4,
+                                          space: CGColorSpaceCreateDeviceRGB(), bitmapInfo: Self.bitmapInfo) else {
+                return false
+            }
+            context.draw(cgImage, in: CGRect(x: 0, y: 0, width: width, height: height))
+            return true
+        }
+        guard drawn else { return nil }
+        self.init(width: width, height: height, bytes: bytes)
+    }
+
+    func makeCGImage() -> CGImage? {
+        guard let provider = CGDataProvider(data: Data(bytes) as CFData) else { return nil }
+        return CGImage(width: width, height: height, bitsPerComponent: 8, bitsPerPixel: 32, bytesPerRow: width * 4,
+                       space: CGColorSpaceCreateDeviceRGB(), bitmapInfo: CGBitmapInfo(rawValue: Self.bitmapInfo),
+                       provider: provider, decode: nil, shouldInterpolate: false, intent: .defaultIntent)
+    }
+}
+
+extension PixelColor {
+    init(_ color: UIColor) {
+        var red: CGFloat = 0, green: CGFloat = 0, blue: CGFloat = 0, alpha: CGFloat = 0
+        color.getRed(&red, green: &green, blue: &blue, alpha: &alpha)
+        self.init(red: Double(red), green: Double(green), blue: Double(blue), opacity: Double(alpha))
+    }
+}
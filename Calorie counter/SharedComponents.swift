@@ -782,6 +782,38 @@ extension DateFormatter {
         return formatter
     }()
     
+    // Display format for diary, weigh-in and workout timestamps ("8:05 PM")
+    static let entryTime: DateFormatter = {
+        let formatter = DateFormatter()
+        formatter.locale = Locale(identifier: "en_US_POSIX")
+        formatter.dateFormat = "h:mm a"
+        return formatter
+    }()
+}
+
+// MARK: - Entry Timestamps
+// Builds the stored timestamp for an entry from the 12-hour pickers, on the (simulated) current day
+func entryTimestamp(hour: Int, minute: Int, period: String, on day: Date? = nil) -> Date {
+    let baseDay = day ?? AppClock.shared.today
+    let hour24 = (hour % 12) + (period == "PM" ? 12 : 0)
+    let startOfDay = AppClock.shared.calendar.startOfDay(for: baseDay)
+    return AppClock.shared.calendar.date(bySettingHour: hour24, minute: minute, second: 0, of: startOfDay) ?? startOfDay
+}
+
+// Current wall-clock time placed on the (simulated) current day
+func currentEntryTimestamp() -> Date {
+    let now = AppClock.shared.now
+    let hour = AppClock.shared.calendar.component(.hour, from: now)
+    let minute = AppClock.shared.calendar.component(.minute, from: now)
+    return entryTimestamp(hour: hour % 12 == 0 ? 12 : hour % 12, minute: minute, period: hour >= 12 ? "PM" : "AM")
+}
+
+// Converts a legacy "h:mm a" string onto the given day; used by the timestamp migration
+func legacyEntryTimestamp(_ time: String?, on day: Date) -> Date {
+    let startOfDay = AppClock.shared.calendar.startOfDay(for: day)
+    guard let time = time, let parsed = DateFormatter.entryTime.date(from: time) else { return startOfDay }
+    let components = AppClock.shared.calendar.dateComponents([.hour, .minute], from: parsed)
+    return AppClock.shared.calendar.date(bySettingHour: components.hour ?? 0, minute: components.minute ?? 0, second: 0, of: startOfDay) ?? startOfDay
 }
 // MARK: - Time Picker
 struct TimePicker: View {
@@ -0,0 +1,143 @@
+//
+//  StartupPipeline.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Startup Phases
+enum StartupPhase: String, CaseIterable {
+    case loadStore = "Load store"
+    case migrations = "Data migrations"
+    case dayRollover = "Catch up missed days"
+    case todayRecord = "Prewarm today's record"
+    case todayDiary = "Prewarm today's diary"
+    case userProfile = "Load user profile"
+    case activityRegistry = "Prewarm activity registry"
+}
+
+// MARK: - Startup Pipeline
+// Staged cold start: load the store, run migrations, then prewarm what the first screen needs.
+// The splash stays up until `isReady`, so time to interactive tracks real work instead of a fixed delay.
+// If the store can't be loaded the pipeline stops there with `loadError` set and never becomes ready.
+@MainActor
+final class StartupPipeline: ObservableObject {
+    static let shared = StartupPipeline()
+
+    @Published private(set) var isReady = false
+    @Published private(set) var loadError: Error?
+    private(set) var timings: [StartupPhase: TimeInterval] = [:]
+    private(set) var totalDuration: TimeInterval = 0
+
+    private let persistence: PersistenceController
+    private var startTask: Task<Void, Never>?
+
+    init(persistence: PersistenceController = .shared) {
+        self.persistence = persistence
+    }
+
+    // Safe to call more than once; later calls join the running pipeline
+    func start() async {
+        if startTask == nil {
+            startTask = Task { await run() }
+        }
+        await startTask?.value
+    }
+
+    // After the store failed to load: adds it again and runs the whole pipeline from the start
+    func retry() async {
+        guard loadError != nil else { return }
+        loadError = nil
+        timings = [:]
+        startTask = nil
+        persistence.retryStoreLoad()
+        await start()
+    }
+
+    private func run() async {
+        let startedAt = Date()
+
+        do {
+            try await measure(.loadStore) {
+                try await persistence.waitForStores()
+            }
+        } catch {
+            // Nothing after this can work without the store; the splash shows the error and offers retry()
+            loadError = error
+            AppLog.error("Startup aborted, store failed to load: \(error.localizedDescription)", category: .startup)
+            return
+        }
+
+        await measure(.migrations) {
+            await persistence.runDataMigrations()
+        }
+
+        // Before anything reads the profile, so goals and weight already reflect days the app was closed
+        await measure(.dayRollover) {
+            _ = await RolloverProcessor.shared.catchUp()
+        }
+
+        // Today's snapshot and diary, the profile and the activities are loaded into the objects the dashboard
+        // reads them from. The first three are read on the repository's background context side by side; only
+        // the diary's fetched-results controller has to fetch on the view context
+        let today = AppClock.shared.today
+        let repository = DataRepository.shared
+        async let todayRecord = Self.timed { await repository.prewarmDayRecord(for: today) }
+        async let userProfile = Self.timed { await ProfileStore.shared.load(from: repository) }
+        async let activityRegistry = Self.timed { await ActivityRegistry.shared.load(from: repository) }
+        await measure(.todayDiary) {
+            DiaryFeed.shared.show(day: today)
+        }
+        timings[.todayRecord] = await todayRecord
+        timings[.userProfile] = await userProfile
+        timings[.activityRegistry] = await activityRegistry
+
+        finish(startedAt: startedAt)
+
+        // Not needed for the first screen; photos saved before renditions existed are re-encoded in the background
+        let persistence = self.persistence
+        Task.detached(priority: .utility) {
+            await PhotoIngest.backfillLegacyPhotos(in: persistence)
+        }
+        // The first append backfills years of history; until it lands, readers fall back to the store
+        Task.detached(priority: .utility) {
+            await RolloverProcessor.shared.archiveClosedDays()
+        }
+        // The day's backup is incremental, but still reads the whole store, so it waits until the app is up;
+        // the weekly maintenance sweep follows it so anything it removes is in the backup first
+        Task.detached(priority: .background) {
+            await StoreBackup.shared.backUpIfDue()
+            await StoreMaintenance.shared.runIfDue()
+        }
+    }
+
+    private func finish(startedAt: Date) {
+        totalDuration = Date().timeIntervalSince(startedAt)
+        logTimings()
+        isReady = true
+    }
+
+    // MARK: Timing
+    private func measure(_ phase: StartupPhase, _ work: () async throws -> Void) async rethrows {
+        let phaseStart = Date()
+        defer { timings[phase] = Date().timeIntervalSince(phaseStart) }
+        try await AppLog.interval("Startup phase", category: .startup, detail: phase.rawValue) {
+            try await work()
+        }
+    }
+
+    nonisolated private static func timed(_ work: @Sendable () async -> Void) async -> TimeInterval {
+        let phaseStart = Date()
+        await work()
+        return Date().timeIntervalSince(phaseStart)
+    }
+
+    private func logTimings() {
+        for phase in StartupPhase.allCases {
+            if let duration = timings[phase] {
+                AppLog.debug("⏱️ \(phase.rawValue): \(String(format: "%.1f", duration * 1000)) ms", category: .startup)
+            }
+        }
+        AppLog.info("Startup ready in \(String(format: "%.1f", totalDuration * 1000)) ms", category: .startup)
+    }
+}
@@ -0,0 +1,163 @@
+//
+//  StoreBackup.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Store Backup
+// Daily incremental backups of the Core Data store into a BackupRepository. A consistent copy of the live
+// store (its SQLite file and the externally stored photos) is taken with replacePersistentStore, which uses
+// SQLite's online backup and keeps the page layout, so chunks the store didn't touch match the previous
+// backup and only the delta is written. The copy is removed once the repository has it.
+final class StoreBackup {
+    static let shared = StoreBackup(persistence: .shared, clock: .shared, archiver: .shared, directory: defaultDirectory)
+
+    // A local folder; any mounted directory (e.g. an iCloud Drive container) works the same way
+    static var defaultDirectory: URL {
+        FileManager.default.urls(for: .applicationSupportDirectory, in: .userDomainMask)[0]
+            .appendingPathComponent("Backups", isDirectory: true)
+    }
+
+    private static let lastBackupDayKey = "lastStoreBackupDay"
+    private static let keptBackups = 14
+
+    private let persistence: PersistenceController
+    private let clock: AppClock
+    private let archiver: HistoryArchiver?
+    private let directory: URL
+    private let lock = NSLock()
+    private var running: Task<BackupStats, Error>?
+
+    init(persistence: PersistenceController, clock: AppClock, archiver: HistoryArchiver? = nil, directory: URL) {
+        self.persistence = persistence
+        self.clock = clock
+        self.archiver = archiver
+        self.directory = directory
+    }
+
+    var latestBackupDate: Date? {
+        try? BackupRepository(directory: directory).snapshots().last?.createdAt
+    }
+
+    // At most once per day; failures are logged and retried next time
+    func backUpIfDue() async {
+        let today = clock.today
+        if let lastDay = UserDefaults.standard.object(forKey: Self.lastBackupDayKey) as? Date, lastDay >= today {
+            return
+        }
+        do {
+            try await backUp()
+            UserDefaults.standard.set(today, forKey: Self.lastBackupDayKey)
+        } catch {
+            AppLog.error("Store backup failed: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // Overlapping calls join the backup already in flight
+    @discardableResult
+    func backUp() async throws -> BackupStats {
+        lock.lock()
+        if let running = running {
+            lock.unlock()
+            return try await running.value
+        }
+        let task = Task.detached(priority: .utility) { [self] in
+            try await run()
+        }
+        running = task
+        lock.unlock()
+
+        defer {
+            lock.lock()
+            running = nil
+            lock.unlock()
+        }
+        return try await task.value
+    }
+
+    private func run() async throws -> BackupStats {
+        try await persistence.waitForStores()
+        let staging = FileManager.default.temporaryDirectory.appendingPathComponent("StoreBackup-\(UUID().uuidString)", isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: staging) }
+
+        return try AppLog.interval("Store backup", category: .persistence) {
+            try copyStore(to: staging)
+            let repository = try BackupRepository(directory: directory)
+            let (snapshot, stats) = try repository.backUp(staging)
+            let removed = try repository.prune(keeping: Self.keptBackups)
+            AppLog.info("Backed up \(stats.files) file(s), \(snapshot.size) bytes: wrote \(stats.newChunks) of \(stats.chunks) chunk(s), \(stats.bytesWritten) bytes; pruned \(removed) chunk(s)", category: .persistence)
+            return stats
+        }
+    }
+
+    // MARK: Restoring
+    // Replaces the live store with the newest backup after verifying it; returns the backup's date
+    func restoreLatest() async throws -> Date {
+        try await persistence.waitForStores()
+        let repository = try BackupRepository(directory: directory)
+        guard let snapshot = try repository.snapshots().last else { throw BackupError.noSnapshot }
+        let staging = FileManager.default.temporaryDirectory.appendingPathComponent("StoreRestore-\(UUID().uuidString)", isDirectory: true)
+        defer { try? FileManager.default.removeItem(at: staging) }
+
+        try await AppLog.interval("Store restore", category: .persistence, detail: snapshot.id) {
+            try await Task.detached(priority: .userInitiated) {
+                try repository.verify(snapshot)
+                try repository.restore(snapshot, to: staging)
+            }.value
+        }
+        guard let store = persistence.container.persistentStoreCoordinator.persistentStores.first,
+              let storeURL = store.url else {
+            throw CocoaError(.persistentStoreOperation)
+        }
+        let coordinator = persistence.container.persistentStoreCoordinator
+        var replaceError: Error?
+        coordinator.performAndWait {
+            do {
+                try coordinator.replacePersistentStore(at: storeURL, destinationOptions: store.options,
+                                                       withPersistentStoreFrom: staging.appendingPathComponent(storeURL.lastPathComponent),
+                                                       sourceOptions: nil, ofType: NSSQLiteStoreType)
+            } catch {
+                replaceError = error
+            }
+        }
+        if let replaceError = replaceError {
+            throw replaceError
+        }
+
+        // Everything cached from the old store is stale
+        let viewContext = persistence.container.viewContext
+        await MainActor.run {
+            viewContext.reset()
+        }
+        archiver?.discard()
+        AppLog.info("Restored the store from backup \(snapshot.id)", category: .persistence)
+        return snapshot.createdAt
+    }
+
+    // MARK: Snapshotting
+    // A single-file copy (journal_mode DELETE, so no -wal beside it) plus the external binaries
+    private func copyStore(to staging: URL) throws {
+        guard let store = persistence.container.persistentStoreCoordinator.persistentStores.first,
+              let storeURL = store.url else {
+            throw CocoaError(.persistentStoreOperation)
+        }
+        try FileManager.default.createDirectory(at: staging, withIntermediateDirectories: true)
+        let coordinator = persistence.container.persistentStoreCoordinator
+        var copyError: Error?
+        coordinator.performAndWait {
+            do {
+                try coordinator.replacePersistentStore(at: staging.appendingPathComponent(storeURL.lastPathComponent),
+                                                       destinationOptions: [NSSQLitePragmasOption: ["journal_mode": "DELETE"]],
+                                                       withPersistentStoreFrom: storeURL, sourceOptions: store.options,
+                                                       ofType: NSSQLiteStoreType)
+            } catch {
+                copyError = error
+            }
+        }
+        if let copyError = copyError {
+            throw copyError
+        }
+    }
+}
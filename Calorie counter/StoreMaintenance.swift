@@ -0,0 +1,339 @@
+//
+//  StoreMaintenance.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Store Maintenance
+// Weekly housekeeping for the Core Data store, run in the background after the day's backup. Duplicate
+// DailyRecords for one date are folded into the one DataRepository.dayRecord would pick, rows left behind by
+// deletes from before the cascade rules are removed (or relinked where they're still read), and when enough of
+// the SQLite file is free pages, the next launch adds the store with a VACUUM to hand the space back.
+final class StoreMaintenance {
+    struct Report {
+        var duplicateDaysMerged = 0
+        var orphansRemoved = 0
+        var orphansRelinked = 0
+        var bytesBefore: Int64 = 0
+        var bytesAfter: Int64 = 0
+        var freeBytes: Int64 = 0 // Free pages inside the SQLite file, returned by the next compaction
+        var compactionScheduled = false
+        var seconds = 0.0
+
+        var bytesReclaimed: Int64 { max(bytesBefore - bytesAfter, 0) }
+    }
+
+    static let shared = StoreMaintenance(persistence: .shared, clock: .shared, archiver: .shared, rollover: .shared)
+
+    // Read by PersistenceController as the store is added
+    static let compactionDueKey = "storeCompactionDue"
+    static let lastCompactionReclaimedKey = "lastStoreCompactionReclaimed"
+
+    private static let lastRunDayKey = "lastStoreMaintenanceDay"
+    private static let runIntervalDays = 7
+    private static let batchSize = 500
+    // Compacting rewrites the whole file, so only when it gives back at least this much
+    private static let compactionMinimumBytes: Int64 = 4 * 1024 * 1024
+    private static let compactionMinimumFraction = 0.2
+
+    private let persistence: PersistenceController
+    private let clock: AppClock
+    private let archiver: HistoryArchiver?
+    private let rollover: RolloverProcessor?
+    private let lock = NSLock()
+    private var running: Task<Report, Error>?
+
+    init(persistence: PersistenceController, clock: AppClock, archiver: HistoryArchiver? = nil, rollover: RolloverProcessor? = nil) {
+        self.persistence = persistence
+        self.clock = clock
+        self.archiver = archiver
+        self.rollover = rollover
+    }
+
+    // At most once a week; failures are logged and retried on the next launch
+    func runIfDue() async {
+        let today = clock.today
+        if let lastDay = UserDefaults.standard.object(forKey: Self.lastRunDayKey) as? Date,
+           let nextDay = clock.calendar.date(byAdding: .day, value: Self.runIntervalDays, to: lastDay), nextDay > today {
+            return
+        }
+        do {
+            try await run()
+            UserDefaults.standard.set(today, forKey: Self.lastRunDayKey)
+        } catch {
+            AppLog.error("Store maintenance failed: \(error.localizedDescription)", category: .persistence)
+        }
+    }
+
+    // Overlapping calls join the sweep already in flight
+    @discardableResult
+    func run() async throws -> Report {
+        lock.lock()
+        if let running = running {
+            lock.unlock()
+            return try await running.value
+        }
+        let task = Task.detached(priority: .utility) { [self] in
+            try await sweep()
+        }
+        running = task
+        lock.unlock()
+
+        defer {
+            lock.lock()
+            running = nil
+            lock.unlock()
+        }
+        return try await task.value
+    }
+
+    private func sweep() async throws -> Report {
+        try await persistence.waitForStores()
+        guard let storeURL = persistence.container.persistentStoreCoordinator.persistentStores.first?.url else {
+            throw CocoaError(.persistentStoreOperation)
+        }
+        let start = DispatchTime.now().uptimeNanoseconds
+        let calendar = clock.calendar
+        var report = Report()
+        report.bytesBefore = Self.storeSize(at: storeURL)
+
+        let context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+        let (merged, deletedIDs, relinked) = try await AppLog.interval("Store maintenance", category: .persistence) {
+            try await context.perform { () -> (MergedDays, [NSManagedObjectID], Int) in
+                let merged = try Self.mergeDuplicateDays(in: context)
+                var relinked = try Self.relinkWorkouts(calendar: calendar, in: context)
+                relinked += try Self.relinkProfileRows(in: context)
+                let deletedIDs = try Self.deleteOrphans(in: context)
+                return (merged, deletedIDs, relinked)
+            }
+        }
+
+        // Batch deletes bypass the contexts; the merges and relinks reach it through automaticallyMergesChangesFromParent
+        let viewContext = persistence.container.viewContext
+        await MainActor.run {
+            NSManagedObjectContext.mergeChanges(fromRemoteContextSave: [NSDeletedObjectsKey: deletedIDs], into: [viewContext])
+        }
+
+        // Merging changes archived days; rebuild the archive from the store
+        if let archiver = archiver, let firstDay = merged.firstDay,
+           let lastArchived = archiver.snapshot()?.lastDate, firstDay <= lastArchived {
+            archiver.discard()
+            await rollover?.archiveClosedDays()
+        }
+
+        report.duplicateDaysMerged = merged.count
+        report.orphansRemoved = deletedIDs.count
+        report.orphansRelinked = relinked
+        report.bytesAfter = Self.storeSize(at: storeURL)
+        report.freeBytes = Self.freeBytes(in: storeURL)
+        let fileSize = Self.fileSize(at: storeURL)
+        if report.freeBytes >= Self.compactionMinimumBytes,
+           Double(report.freeBytes) >= Double(fileSize) * Self.compactionMinimumFraction {
+            UserDefaults.standard.set(true, forKey: Self.compactionDueKey)
+            report.compactionScheduled = true
+        }
+        report.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        AppLog.info("Store maintenance merged \(report.duplicateDaysMerged) duplicate day(s), removed \(report.orphansRemoved) and relinked \(report.orphansRelinked) orphaned row(s), reclaimed \(report.bytesReclaimed) bytes in \(String(format: "%.1f", report.seconds))s; \(report.freeBytes) bytes free\(report.compactionScheduled ? ", compacting on next launch" : "")", category: .persistence)
+        return report
+    }
+
+    // MARK: Duplicate Days
+    private struct MergedDays {
+        var count = 0
+        var firstDay: Date?
+    }
+
+    // Keeps the record DataRepository.dayRecord reads (the first with entries) and moves every other record's
+    // entries onto it, adding their totals. Must run on the context's queue; it's reset between batches.
+    private static func mergeDuplicateDays(in context: NSManagedObjectContext) throws -> MergedDays {
+        let recordCount = NSExpressionDescription()
+        recordCount.name = "count"
+        recordCount.expression = NSExpression(forFunction: "count:", arguments: [NSExpression(forKeyPath: "date")])
+        recordCount.expressionResultType = .integer64AttributeType
+        let countRequest = NSFetchRequest<NSDictionary>(entityName: "DailyRecord")
+        countRequest.resultType = .dictionaryResultType
+        countRequest.propertiesToFetch = ["date", recordCount]
+        countRequest.propertiesToGroupBy = ["date"]
+        let duplicateDates = try context.loggedFetch(countRequest).compactMap { row -> Date? in
+            guard let date = row["date"] as? Date, let count = row["count"] as? Int, count > 1 else { return nil }
+            return date
+        }.sorted()
+
+        var merged = MergedDays(firstDay: duplicateDates.first)
+        for batchStart in stride(from: 0, to: duplicateDates.count, by: batchSize) {
+            let dates = duplicateDates[batchStart..<min(batchStart + batchSize, duplicateDates.count)]
+            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+            fetchRequest.predicate = NSPredicate(format: "date IN %@", Array(dates))
+            fetchRequest.relationshipKeyPathsForPrefetching = ["diaryEntries", "workoutEntries", "weighIns"]
+            let records = try context.loggedFetch(fetchRequest)
+
+            for (_, duplicates) in Dictionary(grouping: records, by: { $0.date }) where duplicates.count > 1 {
+                let kept = duplicates.first { !$0.isEmptyDay } ?? duplicates[0]
+                for record in duplicates where record !== kept {
+                    merge(record, into: kept)
+                    context.delete(record)
+                    merged.count += 1
+                }
+            }
+            if context.hasChanges {
+                try context.save()
+            }
+            context.reset()
+        }
+        return merged
+    }
+
+    private static func merge(_ record: DailyRecord, into kept: DailyRecord) {
+        let entries = (record.diaryEntries as? Set<CoreDiaryEntry>) ?? []
+        if !entries.isEmpty {
+            // Both totals are kept from the record's own diary, so they only carry over with its entries
+            kept.calorieIntake += record.calorieIntake
+            let milliliters = (WaterUnit(label: record.waterUnit ?? "") ?? .flOz).toMilliliters(record.waterIntake)
+            kept.waterIntake += (WaterUnit(label: kept.waterUnit ?? "") ?? .flOz).fromMilliliters(milliliters)
+            kept.passFail = kept.calorieIntake <= kept.calorieGoal
+            entries.forEach { $0.dailyRecord = kept }
+        }
+        ((record.workoutEntries as? Set<WorkoutEntry>) ?? []).forEach { $0.dailyRecord = kept }
+
+        let weighIns = (record.weighIns as? Set<WeighInEntry>) ?? []
+        if !weighIns.isEmpty {
+            weighIns.forEach { $0.dailyRecord = kept }
+            let weights = ((kept.weighIns as? Set<WeighInEntry>) ?? []).map(\.weight)
+            kept.weighIn = weights.reduce(0, +) / Double(weights.count)
+        }
+    }
+
+    // MARK: Orphans
+    // Workouts from before they were attached to a day still count in the stats by timestamp; they're
+    // moved onto their day's record where one exists and otherwise left alone
+    private static func relinkWorkouts(calendar: Calendar, in context: NSManagedObjectContext) throws -> Int {
+        var relinked = 0
+        var offset = 0
+        while true {
+            let fetchRequest: NSFetchRequest<WorkoutEntry> = WorkoutEntry.fetchRequest()
+            fetchRequest.predicate = NSPredicate(format: "dailyRecord == nil AND timestamp != nil")
+            fetchRequest.sortDescriptors = [NSSortDescriptor(key: "timestamp", ascending: true)]
+            fetchRequest.fetchOffset = offset
+            fetchRequest.fetchLimit = batchSize
+            let workouts = try context.loggedFetch(fetchRequest)
+            guard !workouts.isEmpty else { break }
+
+            let days = Set(workouts.compactMap { $0.timestamp.map { calendar.startOfDay(for: $0) } })
+            let recordRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+            recordRequest.predicate = NSPredicate(format: "date IN %@", Array(days))
+            let recordsByDay = Dictionary(try context.loggedFetch(recordRequest).compactMap { record in
+                record.date.map { ($0, record) }
+            }, uniquingKeysWith: { first, _ in first })
+
+            var unplaced = 0
+            for workout in workouts {
+                if let timestamp = workout.timestamp, let record = recordsByDay[calendar.startOfDay(for: timestamp)] {
+                    workout.dailyRecord = record
+                    relinked += 1
+                } else {
+                    unplaced += 1
+                }
+            }
+            if context.hasChanges {
+                try context.save()
+            }
+            context.reset()
+            // Relinked rows drop out of the predicate; skip past the ones that stay
+            offset += unplaced
+            if workouts.count < batchSize {
+                break
+            }
+        }
+        return relinked
+    }
+
+    // Progress pictures and measurements are listed without going through the profile, so they're kept and reattached
+    private static func relinkProfileRows(in context: NSManagedObjectContext) throws -> Int {
+        guard let profileID = try SyntheticDataGenerator.profileID(in: context) else { return 0 }
+        var relinked = 0
+        for entityName in ["ProgressPicture", "BodyMeasurement"] {
+            while true {
+                guard let userProfile = try context.existingObject(with: profileID) as? UserProfile else { return relinked }
+                let fetchRequest = NSFetchRequest<NSManagedObject>(entityName: entityName)
+                fetchRequest.predicate = NSPredicate(format: "userProfile == nil")
+                fetchRequest.fetchLimit = batchSize
+                let rows = try context.loggedFetch(fetchRequest)
+                guard !rows.isEmpty else { break }
+                rows.forEach { $0.setValue(userProfile, forKey: "userProfile") }
+                try context.save()
+                context.reset()
+                relinked += rows.count
+            }
+        }
+        return relinked
+    }
+
+    // Diary entries and weigh-ins are only ever read through their day, so without one they're unreachable
+    private static func deleteOrphans(in context: NSManagedObjectContext) throws -> [NSManagedObjectID] {
+        let orphans = [
+            ("CoreDiaryEntry", NSPredicate(format: "dailyRecord == nil")),
+            ("WeighInEntry", NSPredicate(format: "dailyRecord == nil")),
+            ("WorkoutEntry", NSPredicate(format: "dailyRecord == nil AND timestamp == nil"))
+        ]
+        var deletedIDs: [NSManagedObjectID] = []
+        for (entityName, predicate) in orphans {
+            while true {
+                let fetchRequest = NSFetchRequest<NSManagedObjectID>(entityName: entityName)
+                fetchRequest.resultType = .managedObjectIDResultType
+                fetchRequest.predicate = predicate
+                fetchRequest.fetchLimit = batchSize
+                let objectIDs = try context.loggedFetch(fetchRequest)
+                guard !objectIDs.isEmpty else { break }
+
+                let request = NSBatchDeleteRequest(objectIDs: objectIDs)
+                request.resultType = .resultTypeObjectIDs
+                let result = try context.execute(request) as? NSBatchDeleteResult
+                deletedIDs += result?.result as? [NSManagedObjectID] ?? []
+                if objectIDs.count < batchSize {
+                    break
+                }
+            }
+        }
+        return deletedIDs
+    }
+
+    // MARK: Measuring
+    // The SQLite file with its -wal and -shm files, plus the photos Core Data stores beside it
+    static func storeSize(at storeURL: URL) -> Int64 {
+        let directory = storeURL.deletingLastPathComponent()
+        let name = storeURL.lastPathComponent
+        var size = [name, name + "-wal", name + "-shm"].reduce(Int64(0)) {
+            $0 + fileSize(at: directory.appendingPathComponent($1))
+        }
+        let externalData = directory.appendingPathComponent(".\(storeURL.deletingPathExtension().lastPathComponent)_SUPPORT/_EXTERNAL_DATA", isDirectory: true)
+        if let files = FileManager.default.enumerator(at: externalData, includingPropertiesForKeys: [.fileSizeKey]) {
+            for case let url as URL in files {
+                size += Int64((try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+            }
+        }
+        return size
+    }
+
+    private static func fileSize(at url: URL) -> Int64 {
+        Int64((try? url.resourceValues(forKeys: [.fileSizeKey]).fileSize) ?? 0)
+    }
+
+    // Page size and freelist count from the database header. With WAL the header can trail the last few
+    // commits until the next checkpoint, which is close enough for deciding whether to compact.
+    static func freeBytes(in storeURL: URL) -> Int64 {
+        guard let handle = try? FileHandle(forReadingFrom: storeURL) else { return 0 }
+        defer { try? handle.close() }
+        guard let header = try? handle.read(upToCount: 40), header.count == 40,
+              header.prefix(16) == Data("SQLite format 3\0".utf8) else {
+            return 0
+        }
+        let bytes = [UInt8](header)
+        let pageSize = Int64(bytes[16]) << 8 | Int64(bytes[17])
+        let freePages = bytes[36..<40].reduce(Int64(0)) { $0 << 8 | Int64($1) }
+        return (pageSize == 1 ? 65_536 : pageSize) * freePages
+    }
+}
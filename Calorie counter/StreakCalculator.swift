@@ -0,0 +1,54 @@
+//
+//  StreakCalculator.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Streak Calculator
+// Day-run arithmetic shared by the Today header and the workout overview.
+// Foundation only, so the benchmark package can run it headless.
+enum StreakCalculator {
+    // Consecutive passed days ending the day before `today`.
+    // `days` must be newest first; repeated days are skipped and the walk stops at the first gap or failed day.
+    static func passStreak<S: Sequence>(_ days: S, before today: Date, calendar: Calendar = .current) -> Int where S.Element == (day: Date, passed: Bool) {
+        var streak = 0
+        var expectedDay = calendar.date(byAdding: .day, value: -1, to: calendar.startOfDay(for: today))!
+        for (day, passed) in days {
+            let day = calendar.startOfDay(for: day)
+            if day > expectedDay { continue } // Duplicate of a day already counted, or today itself
+            guard day == expectedDay, passed else { break }
+            streak += 1
+            expectedDay = calendar.date(byAdding: .day, value: -1, to: expectedDay)!
+        }
+        return streak
+    }
+
+    // Consecutive days for which `contains` holds, ending the day before `date`
+    static func currentRun(before date: Date, calendar: Calendar = .current, contains: (Date) -> Bool) -> Int {
+        var run = 0
+        var day = calendar.date(byAdding: .day, value: -1, to: calendar.startOfDay(for: date))!
+        while contains(day) {
+            run += 1
+            day = calendar.date(byAdding: .day, value: -1, to: day)!
+        }
+        return run
+    }
+
+    // Longest run of consecutive days; `days` are start-of-day dates and `contains` answers membership in O(1)
+    static func longestRun<C: Collection>(_ days: C, calendar: Calendar = .current, contains: (Date) -> Bool) -> Int where C.Element == Date {
+        var longest = 0
+        for day in days {
+            // Only walk forward from the first day of each run
+            guard !contains(calendar.date(byAdding: .day, value: -1, to: day)!) else { continue }
+            var length = 1
+            var next = calendar.date(byAdding: .day, value: 1, to: day)!
+            while contains(next) {
+                length += 1
+                next = calendar.date(byAdding: .day, value: 1, to: next)!
+            }
+            longest = max(longest, length)
+        }
+        return longest
+    }
+}
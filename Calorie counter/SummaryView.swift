@@ -29,7 +29,7 @@
 //        NavigationStack {
 //            VStack(spacing: 20) {
 //                Spacer(minLength: 20)
-//                Image("stats")
+//                AppAsset.stats.image
 //                    .resizable()
 //                    .scaledToFit()
 //                    .frame(height: 150)
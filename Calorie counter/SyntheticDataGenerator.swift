@@ -0,0 +1,221 @@
+//
+//  SyntheticDataGenerator.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+import UIKit
+
+// MARK: - Synthetic Data Generator
+// Writes a SyntheticHistory into a store in bulk, for load testing from the debug menu and for seeding
+// benchmark and test stores. Rows go through a private-queue context in day chunks that are saved and
+// reset, so memory stays flat up to ten years / 100k entries; the view context picks the saves up
+// through automaticallyMergesChangesFromParent.
+final class SyntheticDataGenerator {
+    struct Summary {
+        let days: Int
+        let entries: Int
+        let seconds: Double
+    }
+
+    private let persistence: PersistenceController
+    private let chunkDays: Int
+
+    init(persistence: PersistenceController = .shared, chunkDays: Int = 90) {
+        self.persistence = persistence
+        self.chunkDays = max(1, chunkDays)
+    }
+
+    // Pictures and measurements hang off the user profile and are skipped when there is none.
+    // `progress` is called on the generator's queue with the fraction of days written.
+    @discardableResult
+    func generate(_ history: SyntheticHistory, progress: ((Double) -> Void)? = nil) async throws -> Summary {
+        try await persistence.waitForStores()
+        let start = DispatchTime.now().uptimeNanoseconds
+        let context = makeContext()
+        let chunkDays = self.chunkDays
+        let placeholders = Self.placeholderImages()
+
+        try await AppLog.interval("Generate history", category: .persistence, detail: "\(history.days.count) days") {
+            try await context.perform {
+                let profileID = try Self.profileID(in: context)
+                if profileID == nil {
+                    AppLog.warning("No user profile, skipping generated pictures and measurements", category: .persistence)
+                }
+
+                for (index, day) in history.days.enumerated() {
+                    let userProfile = profileID.flatMap { try? context.existingObject(with: $0) as? UserProfile }
+                    Self.insert(day, placeholder: placeholders[index % placeholders.count], userProfile: userProfile, into: context)
+
+                    if index % chunkDays == chunkDays - 1 || index == history.days.count - 1 {
+                        try context.save()
+                        context.reset()
+                        progress?(Double(index + 1) / Double(history.days.count))
+                    }
+                }
+            }
+        }
+
+        let summary = Summary(
+            days: history.days.count,
+            entries: history.entryCount,
+            seconds: Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        )
+        AppLog.info("Generated \(summary.entries) entries over \(summary.days) days in \(String(format: "%.1f", summary.seconds))s", category: .persistence)
+        return summary
+    }
+
+    // Batch-deletes days before `date` with their entries, pictures and measurements; the profile and activities stay
+    func removeDays(before date: Date) async throws {
+        try await persistence.waitForStores()
+        let context = makeContext()
+        let viewContext = persistence.container.viewContext
+        // Keyed by each entity's own date; workouts saved from the activity screens have no dailyRecord
+        let dateKeys = [
+            ("CoreDiaryEntry", "timestamp"), ("WorkoutEntry", "timestamp"), ("WeighInEntry", "timestamp"),
+            ("DailyRecord", "date"), ("ProgressPicture", "date"), ("BodyMeasurement", "date")
+        ]
+        let deletedIDs: [NSManagedObjectID] = try await context.perform {
+            try dateKeys.flatMap { entityName, key -> [NSManagedObjectID] in
+                let fetchRequest = NSFetchRequest<NSFetchRequestResult>(entityName: entityName)
+                fetchRequest.predicate = NSPredicate(format: "%K < %@", key, date as NSDate)
+                let request = NSBatchDeleteRequest(fetchRequest: fetchRequest)
+                request.resultType = .resultTypeObjectIDs
+                let result = try context.execute(request) as? NSBatchDeleteResult
+                return result?.result as? [NSManagedObjectID] ?? []
+            }
+        }
+        // Batch deletes bypass the contexts; tell the view context so the caches drop the rows
+        await MainActor.run {
+            NSManagedObjectContext.mergeChanges(fromRemoteContextSave: [NSDeletedObjectsKey: deletedIDs], into: [viewContext])
+        }
+        AppLog.info("Removed \(deletedIDs.count) generated rows", category: .persistence)
+    }
+
+    // MARK: Writing
+    private func makeContext() -> NSManagedObjectContext {
+        let context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+        return context
+    }
+
+    static func profileID(in context: NSManagedObjectContext) throws -> NSManagedObjectID? {
+        let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
+        fetchRequest.sortDescriptors = [NSSortDescriptor(key: "lastSavedDate", ascending: false)]
+        fetchRequest.fetchLimit = 1
+        return try context.fetch(fetchRequest).first?.objectID
+    }
+
+    private static func insert(_ day: SyntheticHistory.Day, placeholder: PhotoRenditions?, userProfile: UserProfile?, into context: NSManagedObjectContext) {
+        let record = DailyRecord(context: context)
+        record.date = day.date
+        record.calorieGoal = day.calorieGoal
+        record.passFail = day.passed
+        record.waterUnit = WaterUnit.flOz.rawValue
+        record.waterGoal = WaterUnit.flOz.fromMilliliters(day.waterGoalMilliliters)
+        fill(record, with: day, placeholder: placeholder, userProfile: userProfile, in: context)
+    }
+
+    // Logs a day's entries into an existing record and sets its intake totals; goals and pass/fail are left to the caller
+    static func fill(_ record: DailyRecord, with day: SyntheticHistory.Day, placeholder: PhotoRenditions?, userProfile: UserProfile?, in context: NSManagedObjectContext) {
+        let waterUnit = WaterUnit(label: record.waterUnit ?? "") ?? .flOz
+        record.calorieIntake = day.calorieIntake
+        record.waterIntake = waterUnit.fromMilliliters(day.waterMilliliters)
+        if let weight = day.weight {
+            record.weighIn = weight
+        }
+
+        for food in day.foods {
+            let entry = CoreDiaryEntry(context: context)
+            entry.timestamp = food.timestamp
+            entry.type = "Food"
+            entry.entryDescription = food.name
+            entry.detail = "\(food.calories) cal"
+            entry.iconName = "DefaultFood"
+            entry.imageName = AppAsset.defaultFood.name
+            entry.calories = Int32(food.calories)
+            entry.protein = food.protein
+            entry.carbs = food.carbs
+            entry.fats = food.fats
+            entry.dailyRecord = record
+        }
+
+        for workout in day.workouts {
+            let workoutEntry = WorkoutEntry(context: context)
+            workoutEntry.name = workout.activity.name
+            workoutEntry.imageName = workout.activity.imageName
+            workoutEntry.duration = workout.minutes
+            workoutEntry.caloriesBurned = workout.caloriesBurned.rounded()
+            workoutEntry.timestamp = workout.timestamp
+            workoutEntry.dailyRecord = record
+
+            let entry = CoreDiaryEntry(context: context)
+            entry.timestamp = workout.timestamp
+            entry.type = "Workout"
+            entry.entryDescription = workout.activity.name
+            entry.detail = "\(Int(workout.minutes)) min"
+            entry.iconName = workout.activity.imageName
+            entry.imageName = workout.activity.imageName
+            entry.calories = Int32(workout.caloriesBurned.rounded())
+            entry.dailyRecord = record
+        }
+
+        for water in day.water {
+            let entry = CoreDiaryEntry(context: context)
+            entry.timestamp = water.timestamp
+            entry.type = "Water"
+            entry.entryDescription = "Water"
+            entry.detail = "\(Int(WaterUnit.flOz.fromMilliliters(water.milliliters).rounded())) \(WaterUnit.flOz.rawValue)"
+            entry.iconName = "water"
+            entry.imageName = AppAsset.water.name
+            entry.waterAmountMl = water.milliliters
+            entry.dailyRecord = record
+        }
+
+        for weighIn in day.weighIns {
+            let entry = WeighInEntry(context: context)
+            entry.timestamp = weighIn.timestamp
+            entry.weight = weighIn.weight
+            entry.dailyRecord = record
+        }
+
+        guard let userProfile = userProfile else { return }
+        if day.hasPicture, let placeholder = placeholder {
+            let picture = ProgressPicture(context: context)
+            picture.date = day.date.addingTimeInterval(7 * 3600)
+            picture.weight = day.weight ?? 0
+            picture.store(placeholder)
+            picture.userProfile = userProfile
+        }
+        if let measurement = day.measurement {
+            let bodyMeasurement = BodyMeasurement(context: context)
+            bodyMeasurement.date = day.date.addingTimeInterval(7 * 3600)
+            let inches = LengthUnit.inches
+            bodyMeasurement.chest = inches.toCentimeters(measurement.chest)
+            bodyMeasurement.waist = inches.toCentimeters(measurement.waist)
+            bodyMeasurement.hips = inches.toCentimeters(measurement.hips)
+            bodyMeasurement.leftArm = inches.toCentimeters(measurement.arm)
+            bodyMeasurement.rightArm = inches.toCentimeters(measurement.arm)
+            bodyMeasurement.leftThigh = inches.toCentimeters(measurement.thigh)
+            bodyMeasurement.rightThigh = inches.toCentimeters(measurement.thigh)
+            bodyMeasurement.userProfile = userProfile
+        }
+    }
+
+    // A handful of tinted JPEGs at photo-like proportions, ingested once and reused across pictures
+    static func placeholderImages() -> [PhotoRenditions?] {
+        let size = CGSize(width: 600, height: 800)
+        let renderer = UIGraphicsImageRenderer(size: size)
+        return (0..<6).map { index in
+            renderer.image { context in
+                UIColor(hue: CGFloat(index) / 6, saturation: 0.35, brightness: 0.85, alpha: 1).setFill()
+                context.fill(CGRect(origin: .zero, size: size))
+                UIColor(white: 1, alpha: 0.6).setFill()
+                UIBezierPath(ovalIn: CGRect(x: 200, y: 120, width: 200, height: 240)).fill()
+                UIBezierPath(roundedRect: CGRect(x: 150, y: 380, width: 300, height: 420), cornerRadius: 80).fill()
+            }.jpegData(compressionQuality: 0.7).flatMap { try? PhotoIngest.makeRenditions(from: $0) }
+        }
+    }
+}
@@ -0,0 +1,233 @@
+//
+//  SyntheticHistory.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Seeded Generator
+// SplitMix64: tiny, fast and identical on every platform, so a seed always produces the same history
+struct SeededGenerator: RandomNumberGenerator {
+    private var state: UInt64
+
+    init(seed: UInt64) {
+        state = seed
+    }
+
+    mutating func next() -> UInt64 {
+        state &+= 0x9E3779B97F4A7C15
+        var z = state
+        z = (z ^ (z >> 30)) &* 0xBF58476D1CE4E5B9
+        z = (z ^ (z >> 27)) &* 0x94D049BB133111EB
+        return z ^ (z >> 31)
+    }
+}
+
+// MARK: - Synthetic History
+// A reproducible, value-level history shaped like real use: meals with macros, catalog workouts with
+// MET-consistent burns, a noisy weight trend, water, and periodic progress pictures and measurements.
+// Foundation only; SyntheticDataGenerator writes it into a store, the benchmarks also use it directly.
+struct SyntheticHistory {
+    struct Configuration {
+        static let maxDays = 3650 // Ten years
+
+        var days: Int
+        var foodsPerDay = 4
+        var workoutsPerDay = 1
+        var weighInsPerDay = 1
+        var waterPerDay = 3
+        var pictureEveryDays = 14 // 0 for none
+        var measurementEveryDays = 7 // 0 for none
+        var seed: UInt64 = 42
+        var skippedDayRate = 0.03
+        var failedDayRate = 0.2
+        var calorieGoal = 2200.0
+        var startWeight = 190.0 // Pounds, like UserProfile.currentWeight
+        var weeklyWeightTrend = -0.5
+
+        init(days: Int, seed: UInt64 = 42) {
+            self.days = min(max(days, 1), Self.maxDays)
+            self.seed = seed
+        }
+
+        init(years: Int, seed: UInt64 = 42) {
+            self.init(days: years * 365, seed: seed)
+        }
+
+        // Diary rows plus weigh-ins written per day
+        var entriesPerDay: Int {
+            foodsPerDay + workoutsPerDay + waterPerDay + weighInsPerDay
+        }
+
+        // Sized by total entries: fewer days at the default density, or a denser ten years past that
+        static func entries(_ total: Int, seed: UInt64 = 42) -> Configuration {
+            var configuration = Configuration(days: maxDays, seed: seed)
+            let perDay = configuration.entriesPerDay
+            if total <= maxDays * perDay {
+                configuration.days = max(1, (total + perDay - 1) / perDay)
+            } else {
+                configuration.foodsPerDay += (total + maxDays - 1) / maxDays - perDay
+            }
+            return configuration
+        }
+    }
+
+    struct Food {
+        let name: String
+        let timestamp: Date
+        let calories: Int
+        let protein: Double
+        let carbs: Double
+        let fats: Double
+    }
+
+    struct Workout {
+        let activity: BuiltInActivity
+        let timestamp: Date
+        let minutes: Double
+        let caloriesBurned: Double
+    }
+
+    struct Water {
+        let timestamp: Date
+        let milliliters: Double
+    }
+
+    struct WeighIn {
+        let timestamp: Date
+        let weight: Double
+    }
+
+    // Inches, the same fields as BodyMeasurement (which stores them as centimetres)
+    struct Measurement {
+        let chest: Double
+        let waist: Double
+        let hips: Double
+        let arm: Double
+        let thigh: Double
+    }
+
+    struct Day {
+        let date: Date // Start of day
+        let foods: [Food]
+        let workouts: [Workout]
+        let water: [Water]
+        let weighIns: [WeighIn]
+        let measurement: Measurement?
+        let hasPicture: Bool
+        let calorieGoal: Double
+        let waterGoalMilliliters: Double
+
+        // Net of workouts, like DailyRecord.calorieIntake
+        var calorieIntake: Double {
+            Double(foods.reduce(0) { $0 + $1.calories }) - workouts.reduce(0) { $0 + $1.caloriesBurned.rounded() }
+        }
+        var passed: Bool { calorieIntake <= calorieGoal }
+        var waterMilliliters: Double { water.reduce(0) { $0 + $1.milliliters } }
+        var weight: Double? { weighIns.isEmpty ? nil : weighIns.reduce(0) { $0 + $1.weight } / Double(weighIns.count) }
+        var entryCount: Int { foods.count + workouts.count + water.count + weighIns.count }
+    }
+
+    let configuration: Configuration
+    let days: [Day] // Oldest first, ending the day before `today`
+    let today: Date
+
+    var entryCount: Int { days.reduce(0) { $0 + $1.entryCount } }
+
+    private static let foods: [(name: String, calories: Int, protein: Double, carbs: Double, fats: Double)] = [
+        ("Oatmeal", 150, 5, 27, 3), ("Greek Yogurt", 100, 17, 6, 0.7), ("Banana", 105, 1.3, 27, 0.4),
+        ("Chicken Breast", 165, 31, 0, 3.6), ("Brown Rice", 216, 5, 45, 1.8), ("Salmon", 208, 20, 0, 13),
+        ("Avocado Toast", 290, 7, 30, 16), ("Protein Shake", 160, 30, 5, 2), ("Pasta", 380, 13, 75, 2),
+        ("Burrito", 620, 25, 80, 22), ("Apple", 95, 0.5, 25, 0.3), ("Pizza Slice", 285, 12, 36, 10)
+    ]
+
+    init(_ configuration: Configuration, today: Date = Date(), calendar: Calendar = .current) {
+        self.configuration = configuration
+        self.today = calendar.startOfDay(for: today)
+
+        var generator = SeededGenerator(seed: configuration.seed)
+        let catalog = BuiltInActivityCatalog.all
+        let dailyTrend = configuration.weeklyWeightTrend / 7
+        var trendWeight = configuration.startWeight
+        var days: [Day] = []
+        days.reserveCapacity(configuration.days)
+
+        for offset in stride(from: configuration.days, to: 0, by: -1) {
+            let date = calendar.date(byAdding: .day, value: -offset, to: self.today)!
+            let dayIndex = configuration.days - offset
+            // The trend moves on skipped days too, the user just didn't log them
+            trendWeight += dailyTrend + Double.random(in: -0.05...0.05, using: &generator)
+            if Double.random(in: 0..<1, using: &generator) < configuration.skippedDayRate { continue }
+
+            let weightKg = trendWeight / 2.20462
+            let workouts: [Workout] = (0..<configuration.workoutsPerDay).map { index in
+                let activity = catalog.randomElement(using: &generator)!
+                let minutes = Double(Int.random(in: 20...75, using: &generator))
+                return Workout(
+                    activity: activity,
+                    timestamp: date.addingTimeInterval(Double(17 + index) * 3600),
+                    minutes: minutes,
+                    caloriesBurned: activity.metValue * weightKg * minutes / 60
+                )
+            }
+            let burned = workouts.reduce(0) { $0 + $1.caloriesBurned.rounded() }
+
+            // Failed days eat well past the goal, passed days stay under it once workouts are netted out
+            let fails = Double.random(in: 0..<1, using: &generator) < configuration.failedDayRate
+            let budget = configuration.calorieGoal * (fails ? 1.3 : 0.9) + burned
+            let foodCount = max(1, configuration.foodsPerDay)
+            let foods: [Food] = (0..<configuration.foodsPerDay).map { index in
+                let template = Self.foods.randomElement(using: &generator)!
+                let calories = Int(budget) / foodCount
+                let scale = Double(calories) / Double(template.calories)
+                return Food(
+                    name: template.name,
+                    timestamp: date.addingTimeInterval(Double(7 * 60 + index * 14 * 60 / foodCount) * 60),
+                    calories: calories,
+                    protein: template.protein * scale,
+                    carbs: template.carbs * scale,
+                    fats: template.fats * scale
+                )
+            }
+
+            let water: [Water] = (0..<configuration.waterPerDay).map { index in
+                Water(
+                    timestamp: date.addingTimeInterval(Double(9 + index * 3) * 3600),
+                    milliliters: Double(Int.random(in: 8...16, using: &generator)) * WaterUnit.flOz.millilitersPerUnit
+                )
+            }
+
+            // Scale noise of a pound or so around the trend
+            let weighIns: [WeighIn] = (0..<configuration.weighInsPerDay).map { index in
+                let weight = trendWeight + Double.random(in: -1.2...1.2, using: &generator)
+                return WeighIn(timestamp: date.addingTimeInterval(Double(6 + index * 12) * 3600), weight: (weight * 10).rounded() / 10)
+            }
+
+            var dayMeasurement: Measurement?
+            if configuration.measurementEveryDays > 0, dayIndex % configuration.measurementEveryDays == 0 {
+                // Circumferences follow the weight trend at roughly a quarter inch per pound on the waist
+                let change = trendWeight - configuration.startWeight
+                dayMeasurement = Measurement(
+                    chest: 42 + change * 0.12,
+                    waist: 36 + change * 0.25,
+                    hips: 41 + change * 0.18,
+                    arm: 14 + change * 0.04,
+                    thigh: 24 + change * 0.08
+                )
+            }
+
+            days.append(Day(
+                date: date,
+                foods: foods,
+                workouts: workouts,
+                water: water,
+                weighIns: weighIns,
+                measurement: dayMeasurement,
+                hasPicture: configuration.pictureEveryDays > 0 && dayIndex % configuration.pictureEveryDays == 0,
+                calorieGoal: configuration.calorieGoal,
+                waterGoalMilliliters: 64 * WaterUnit.flOz.millilitersPerUnit
+            ))
+        }
+        self.days = days
+    }
+}
@@ -0,0 +1,117 @@
+//
+//  ThumbnailLoader.swift
+//  Calorie counter
+//
+
+import UIKit
+import CoreData
+
+// MARK: - Thumbnail Loader
+// Decoded grid thumbnails for progress pictures and start pictures, keyed by object id.
+// Loads read only the thumbnail column and decode off the main thread. Concurrent requests for one id
+// share a load, which is cancelled once every cell waiting on it has gone away. Prefetches run until
+// a newer prefetch window no longer includes them.
+final class ThumbnailLoader {
+    static let shared = ThumbnailLoader(repository: .shared)
+
+    private struct Load {
+        let task: Task<UIImage?, Never>
+        var waiters = 0
+        var isPrefetch: Bool
+    }
+
+    private let repository: DataRepository
+    private let cache = NSCache<NSManagedObjectID, UIImage>()
+    private let lock = NSLock()
+    private var loads: [NSManagedObjectID: Load] = [:]
+
+    init(repository: DataRepository) {
+        self.repository = repository
+        cache.countLimit = 300 // About 30 MB of 320 px thumbnails
+    }
+
+    func cachedImage(for objectID: NSManagedObjectID) -> UIImage? {
+        cache.object(forKey: objectID)
+    }
+
+    func image(for objectID: NSManagedObjectID) async -> UIImage? {
+        if let cached = cache.object(forKey: objectID) {
+            return cached
+        }
+        let task = join(objectID)
+        return await withTaskCancellationHandler {
+            let image = await task.value
+            if !Task.isCancelled { // onCancel already left
+                leave(objectID)
+            }
+            return image
+        } onCancel: {
+            leave(objectID)
+        }
+    }
+
+    // Starts loads for `objectIDs` and cancels earlier prefetches outside that window that no cell is waiting on
+    func prefetch(_ objectIDs: [NSManagedObjectID]) {
+        let window = Set(objectIDs)
+        lock.lock()
+        for (objectID, load) in loads where load.isPrefetch && load.waiters == 0 && !window.contains(objectID) {
+            load.task.cancel()
+            loads[objectID] = nil
+        }
+        for objectID in objectIDs where loads[objectID] == nil && cache.object(forKey: objectID) == nil {
+            loads[objectID] = Load(task: makeTask(objectID), isPrefetch: true)
+        }
+        lock.unlock()
+    }
+
+    // Call after a picture's image columns change or the row is deleted
+    func invalidate(_ objectID: NSManagedObjectID) {
+        lock.lock()
+        loads[objectID]?.task.cancel()
+        loads[objectID] = nil
+        lock.unlock()
+        cache.removeObject(forKey: objectID)
+    }
+
+    // MARK: Loads
+    private func join(_ objectID: NSManagedObjectID) -> Task<UIImage?, Never> {
+        lock.lock()
+        defer { lock.unlock() }
+        var load = loads[objectID] ?? Load(task: makeTask(objectID), isPrefetch: false)
+        load.waiters += 1
+        load.isPrefetch = false // A visible cell now owns it
+        loads[objectID] = load
+        return load.task
+    }
+
+    private func leave(_ objectID: NSManagedObjectID) {
+        lock.lock()
+        defer { lock.unlock() }
+        guard var load = loads[objectID] else { return }
+        load.waiters -= 1
+        if load.waiters <= 0 {
+            // Finished loads are already cached; unfinished ones are no longer wanted by anyone
+            load.task.cancel()
+            loads[objectID] = nil
+        } else {
+            loads[objectID] = load
+        }
+    }
+
+    private func makeTask(_ objectID: NSManagedObjectID) -> Task<UIImage?, Never> {
+        Task.detached(priority: .userInitiated) { [repository, cache] in
+            do {
+                guard let data = try await repository.photoData(objectID, size: .thumbnail) else { return nil }
+                try Task.checkCancellation()
+                guard let image = PhotoIngest.thumbnailImage(from: data) else { return nil }
+                cache.setObject(image, forKey: objectID)
+                return image
+            } catch is CancellationError {
+                return nil
+            } catch {
+                AppLog.error("Failed to load thumbnail: \(error.localizedDescription)", category: .images)
+                return nil
+            }
+        }
+    }
+}
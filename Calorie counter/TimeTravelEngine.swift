@@ -0,0 +1,227 @@
+//
+//  TimeTravelEngine.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+
+// MARK: - Time Travel Engine
+// Advances a clock over many days without the UI. Every day is closed and the next one opened with the
+// same rules the Today screen applies (DayRollover), in batches on a private-queue context, so
+// long-horizon behaviour such as birthdays, goal changes and streaks can be tested and timed in seconds.
+final class TimeTravelEngine {
+    struct Report: Equatable {
+        var days = 0
+        var passedDays = 0
+        var passStreak = 0
+        var activityStreak = 0
+        var highStreak: Int32 = 0
+        var highestActivityStreak: Int32 = 0
+        var age: Int32 = 0
+        var dailyCalorieGoal: Int32 = 0
+        var currentWeight = 0.0
+        var today = Date.distantPast
+        var seconds = 0.0
+    }
+
+    // Fills the day being closed, before pass/fail is decided; nil leaves the day empty
+    typealias DayLog = (_ day: Date, _ record: DailyRecord, _ userProfile: UserProfile, _ context: NSManagedObjectContext) -> Void
+
+    private let persistence: PersistenceController
+    private let clock: AppClock
+    private let chunkDays: Int
+
+    init(persistence: PersistenceController = .shared, clock: AppClock = .shared, chunkDays: Int = 90) {
+        self.persistence = persistence
+        self.clock = clock
+        self.chunkDays = max(1, chunkDays)
+    }
+
+    // Closes today and each following day, ending with the clock `days` ahead and that day opened.
+    // Needs a user profile; the clock moves once at the end, on the main thread.
+    @discardableResult
+    func advance(days: Int, log: DayLog? = nil) async throws -> Report {
+        try await persistence.waitForStores()
+        let start = DispatchTime.now().uptimeNanoseconds
+        let calendar = clock.calendar
+        let startDay = clock.today
+        let chunkDays = self.chunkDays
+        let context = persistence.container.newBackgroundContext()
+        context.mergePolicy = NSMergeByPropertyObjectTrumpMergePolicy
+        context.undoManager = nil
+
+        let endDay = calendar.date(byAdding: .day, value: max(days, 0), to: startDay)!
+        var report = try await AppLog.interval("Time travel", category: .persistence, detail: "\(days) days") {
+            try await context.perform {
+                guard let profileID = try SyntheticDataGenerator.profileID(in: context) else {
+                    throw TimeTravelError.noProfile
+                }
+                return try Self.roll(from: startDay, to: endDay, profileID: profileID, calendar: calendar, in: context, chunkDays: chunkDays, log: log)
+            }
+        }
+
+        let clock = self.clock
+        let arrival = report.today
+        await MainActor.run {
+            clock.travel(to: arrival)
+        }
+        report.seconds = Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000
+        AppLog.info("Travelled \(report.days) days in \(String(format: "%.2f", report.seconds))s, streak \(report.passStreak)", category: .persistence)
+        return report
+    }
+
+    // MARK: Rolling
+    // Closes `startDay` and every day up to `endDay`, then opens `endDay`. Missing records are created
+    // with the new-day rules; existing ones keep their goal. A created day still empty when it closes
+    // wasn't opened by anyone and fails, so gaps break the pass streak as they did before catch-up.
+    // Streak highs and lastSavedDate are written once at the end. Saves every `chunkDays`, or once
+    // when nil. Must run on the context's queue.
+    static func roll(from startDay: Date, to endDay: Date, profileID: NSManagedObjectID, calendar: Calendar, in context: NSManagedObjectContext, chunkDays: Int? = nil, log: DayLog? = nil) throws -> Report {
+        var result = Report()
+        var streaks = try currentStreaks(before: startDay, calendar: calendar, in: context)
+        var highStreak = 0
+        var highestActivityStreak = 0
+        var day = calendar.startOfDay(for: startDay)
+        let endDay = calendar.startOfDay(for: endDay)
+
+        let first = try record(for: day, calendar: calendar, in: context)
+        if first.isInserted, let userProfile = try context.existingObject(with: profileID) as? UserProfile {
+            let yesterday = calendar.date(byAdding: .day, value: -1, to: day)!
+            open(first, on: day, after: try existingRecord(for: yesterday, calendar: calendar, in: context), profile: userProfile, calendar: calendar)
+        }
+        var created = first.isInserted
+        try context.obtainPermanentIDs(for: [first])
+        var recordID = first.objectID
+
+        while day < endDay {
+            guard let userProfile = try context.existingObject(with: profileID) as? UserProfile,
+                  let record = try context.existingObject(with: recordID) as? DailyRecord else { break }
+
+            // Close the current day
+            log?(day, record, userProfile, context)
+            let passed = close(record, created: created, profile: userProfile, streaks: &streaks)
+            result.days += 1
+            result.passedDays += passed ? 1 : 0
+            highStreak = max(highStreak, streaks.pass)
+            highestActivityStreak = max(highestActivityStreak, streaks.activity)
+
+            // Open the next one
+            day = calendar.date(byAdding: .day, value: 1, to: day)!
+            let next = try self.record(for: day, calendar: calendar, in: context)
+            created = next.isInserted
+            if created {
+                open(next, on: day, after: record, profile: userProfile, calendar: calendar)
+            }
+
+            // Permanent IDs survive the reset below
+            try context.obtainPermanentIDs(for: [next])
+            recordID = next.objectID
+            if let chunkDays = chunkDays, result.days % chunkDays == 0 {
+                try context.save()
+                context.reset()
+            }
+        }
+
+        if let userProfile = try context.existingObject(with: profileID) as? UserProfile {
+            if highStreak > userProfile.highStreak {
+                userProfile.highStreak = Int32(highStreak)
+            }
+            if highestActivityStreak > userProfile.highestActivityStreak {
+                userProfile.highestActivityStreak = Int32(highestActivityStreak)
+            }
+            userProfile.lastSavedDate = day
+            result.age = userProfile.age
+            result.dailyCalorieGoal = userProfile.dailyCalorieGoal
+            result.currentWeight = userProfile.currentWeight
+            result.highStreak = userProfile.highStreak
+            result.highestActivityStreak = userProfile.highestActivityStreak
+        }
+        try context.save()
+        result.passStreak = streaks.pass
+        result.activityStreak = streaks.activity
+        result.today = day
+        context.reset()
+        return result
+    }
+
+    // MARK: Rollover Steps
+    // What the Today screen's save does for the current day: pass/fail against the locked goal,
+    // the average weigh-in becoming currentWeight, and the running streaks
+    private static func close(_ record: DailyRecord, created: Bool, profile userProfile: UserProfile, streaks: inout (pass: Int, activity: Int)) -> Bool {
+        let weighIns = (record.weighIns as? Set<WeighInEntry>) ?? []
+        if !weighIns.isEmpty {
+            let average = weighIns.reduce(0) { $0 + $1.weight } / Double(weighIns.count)
+            record.weighIn = average
+            userProfile.currentWeight = average
+        }
+        // An empty day would always be under its goal; one nobody opened doesn't count as kept
+        record.passFail = !(created && record.isEmptyDay) && record.calorieIntake <= record.calorieGoal
+        streaks.pass = record.passFail ? streaks.pass + 1 : 0
+
+        let worked = (record.workoutEntries?.count ?? 0) > 0
+        streaks.activity = worked ? streaks.activity + 1 : 0
+        return record.passFail
+    }
+
+    // A new day's record: the goal is set once and locked in, the water goal carries over
+    private static func open(_ record: DailyRecord, on day: Date, after previous: DailyRecord?, profile userProfile: UserProfile, calendar: Calendar) {
+        if let previous = previous {
+            record.waterGoal = previous.waterGoal
+            record.waterUnit = previous.waterUnit
+        }
+        let previousWeighIn = previous.flatMap { $0.weighIn > 0 ? $0.weighIn : nil }
+        DayRollover.beginDay(day, profile: userProfile, previousWeighIn: previousWeighIn, calendar: calendar)
+        record.calorieGoal = Double(userProfile.dailyCalorieGoal)
+    }
+
+    private static func existingRecord(for day: Date, calendar: Calendar, in context: NSManagedObjectContext) throws -> DailyRecord? {
+        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "date == %@", calendar.startOfDay(for: day) as NSDate)
+        fetchRequest.fetchLimit = 1
+        return try context.fetch(fetchRequest).first
+    }
+
+    // The day's record, created empty when missing; callers check isInserted to run the new-day rules
+    private static func record(for day: Date, calendar: Calendar, in context: NSManagedObjectContext) throws -> DailyRecord {
+        if let record = try existingRecord(for: day, calendar: calendar, in: context) {
+            return record
+        }
+        let record = DailyRecord(context: context)
+        record.date = calendar.startOfDay(for: day)
+        record.weighIn = 0
+        return record
+    }
+
+    // Pass and workout streaks ending the day before `day`, so the run continues from stored history
+    private static func currentStreaks(before day: Date, calendar: Calendar, in context: NSManagedObjectContext) throws -> (pass: Int, activity: Int) {
+        let recordFetch = NSFetchRequest<NSDictionary>(entityName: "DailyRecord")
+        recordFetch.resultType = .dictionaryResultType
+        recordFetch.propertiesToFetch = ["date", "passFail"]
+        recordFetch.predicate = NSPredicate(format: "date < %@", day as NSDate)
+        recordFetch.sortDescriptors = [NSSortDescriptor(key: "date", ascending: false)]
+        let days = try context.fetch(recordFetch).lazy.compactMap { row -> (day: Date, passed: Bool)? in
+            guard let date = row["date"] as? Date else { return nil }
+            return (day: date, passed: (row["passFail"] as? Bool) ?? false)
+        }
+        let pass = StreakCalculator.passStreak(days, before: day, calendar: calendar)
+
+        let workoutFetch = NSFetchRequest<NSDictionary>(entityName: "WorkoutEntry")
+        workoutFetch.resultType = .dictionaryResultType
+        workoutFetch.propertiesToFetch = ["timestamp"]
+        workoutFetch.predicate = NSPredicate(format: "timestamp < %@", day as NSDate)
+        let workoutDays = Set(try context.fetch(workoutFetch).compactMap { ($0["timestamp"] as? Date).map { calendar.startOfDay(for: $0) } })
+        let activity = StreakCalculator.currentRun(before: day, calendar: calendar) { workoutDays.contains($0) }
+        return (pass, activity)
+    }
+}
+
+enum TimeTravelError: LocalizedError {
+    case noProfile
+
+    var errorDescription: String? {
+        switch self {
+        case .noProfile: return "Time travel needs a user profile"
+        }
+    }
+}
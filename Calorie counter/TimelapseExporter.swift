@@ -0,0 +1,275 @@
+//
+//  TimelapseExporter.swift
+//  Calorie counter
+//
+
+import UIKit
+import CoreData
+import AVFoundation
+
+enum TimelapseFormat: String, CaseIterable, Identifiable {
+    case gif = "GIF"
+    case video = "Video"
+
+    var id: String { rawValue }
+    var fileExtension: String { self == .gif ? "gif" : "mp4" }
+}
+
+struct TimelapseRequest {
+    let profileID: NSManagedObjectID // The start picture comes first, then every progress picture by date
+    let startDate: Date?
+    let startWeight: Double
+    let useMetric: Bool
+    let format: TimelapseFormat
+}
+
+enum TimelapseExportError: LocalizedError {
+    case noPhotos
+    case writerFailed(String)
+
+    var errorDescription: String? {
+        switch self {
+        case .noPhotos: return "There are no progress pictures to export"
+        case .writerFailed(let reason): return "The timelapse could not be written: \(reason)"
+        }
+    }
+}
+
+// MARK: - Timelapse Exporter
+// Streams the progress pictures into a GIF or H.264 video one frame at a time: load the display
+// rendition, decode it at frame size, draw it with its caption into a reused canvas, encode, and only
+// then move on. Peak memory is one frame whatever the number of photos. Cancelling the calling task
+// stops between frames and removes the partial file.
+final class TimelapseExporter {
+    static let shared = TimelapseExporter(repository: .shared)
+
+    private static let frameSeconds = 0.5
+    private static let gifSide = 480
+    private static let videoSide = 720 // Divisible by 16 for the H.264 encoder
+
+    private struct Frame {
+        let photoID: NSManagedObjectID
+        let date: Date?
+        let weight: Double
+    }
+
+    private let repository: DataRepository
+
+    init(repository: DataRepository) {
+        self.repository = repository
+    }
+
+    // `progress` is called off the main thread with the fraction of photos processed
+    func export(_ request: TimelapseRequest, progress: @escaping (Double) -> Void) async throws -> URL {
+        let task = Task.detached(priority: .userInitiated) { [self] in
+            try await run(request, progress: progress)
+        }
+        return try await withTaskCancellationHandler {
+            try await task.value
+        } onCancel: {
+            task.cancel()
+        }
+    }
+
+    private func run(_ request: TimelapseRequest, progress: @escaping (Double) -> Void) async throws -> URL {
+        let photos = try await repository.progressPhotos(for: request.profileID)
+        let frames = [Frame(photoID: request.profileID, date: request.startDate, weight: request.startWeight)]
+            + photos.map { Frame(photoID: $0.id, date: $0.date, weight: $0.weight) }
+
+        let url = FileManager.default.temporaryDirectory.appendingPathComponent("Progress timelapse.\(request.format.fileExtension)")
+        try? FileManager.default.removeItem(at: url)
+        do {
+            let written = try await AppLog.interval("Timelapse export", category: .images, detail: "\(frames.count) frames") {
+                switch request.format {
+                case .gif: return try await writeGIF(frames, useMetric: request.useMetric, to: url, progress: progress)
+                case .video: return try await writeVideo(frames, useMetric: request.useMetric, to: url, progress: progress)
+                }
+            }
+            guard written > 0 else { throw TimelapseExportError.noPhotos }
+            AppLog.info("Exported \(written)-frame \(request.format.rawValue) timelapse", category: .images)
+            return url
+        } catch {
+            try? FileManager.default.removeItem(at: url)
+            if !(error is CancellationError) {
+                AppLog.error("Timelapse export failed: \(error.localizedDescription)", category: .images)
+            }
+            throw error
+        }
+    }
+
+    // MARK: GIF
+    private func writeGIF(_ frames: [Frame], useMetric: Bool, to url: URL, progress: @escaping (Double) -> Void) async throws -> Int {
+        guard FileManager.default.createFile(atPath: url.path, contents: nil) else {
+            throw TimelapseExportError.writerFailed("Couldn't create \(url.lastPathComponent)")
+        }
+        let handle = try FileHandle(forWritingTo: url)
+        defer { try? handle.close() }
+
+        var encoder = try GIFEncoder(width: Self.gifSide, height: Self.gifSide) { data in
+            try handle.write(contentsOf: data)
+        }
+        let delay = Int(Self.frameSeconds * 100)
+        let written = try await renderFrames(frames, side: Self.gifSide, useMetric: useMetric, progress: progress) { canvas, _ in
+            try encoder.addFrame(canvas.pixels, delay: delay)
+        }
+        try encoder.finish()
+        return written
+    }
+
+    // MARK: Video
+    private func writeVideo(_ frames: [Frame], useMetric: Bool, to url: URL, progress: @escaping (Double) -> Void) async throws -> Int {
+        let side = Self.videoSide
+        let writer = try AVAssetWriter(outputURL: url, fileType: .mp4)
+        let input = AVAssetWriterInput(mediaType: .video, outputSettings: [
+            AVVideoCodecKey: AVVideoCodecType.h264,
+            AVVideoWidthKey: side,
+            AVVideoHeightKey: side
+        ])
+        input.expectsMediaDataInRealTime = false
+        let adaptor = AVAssetWriterInputPixelBufferAdaptor(assetWriterInput: input, sourcePixelBufferAttributes: [
+            kCVPixelBufferPixelFormatTypeKey as String: kCVPixelFormatType_32BGRA,
+            kCVPixelBufferWidthKey as String: side,
+            kCVPixelBufferHeightKey as String: side
+        ])
+        writer.add(input)
+        guard writer.startWriting() else {
+            throw TimelapseExportError.writerFailed(writer.error?.localizedDescription ?? "Couldn't start writing")
+        }
+        writer.startSession(atSourceTime: .zero)
+
+        let frameTime = CMTime(seconds: Self.frameSeconds, preferredTimescale: 600)
+        do {
+            let written = try await renderFrames(frames, side: side, useMetric: useMetric, progress: progress) { canvas, index in
+                while !input.isReadyForMoreMediaData {
+                    try await Task.sleep(nanoseconds: 10_000_000)
+                }
+                guard let buffer = Self.pixelBuffer(from: canvas, pool: adaptor.pixelBufferPool),
+                      adaptor.append(buffer, withPresentationTime: CMTimeMultiply(frameTime, multiplier: Int32(index))) else {
+                    throw TimelapseExportError.writerFailed(writer.error?.localizedDescription ?? "Couldn't append frame \(index)")
+                }
+            }
+            input.markAsFinished()
+            writer.endSession(atSourceTime: CMTimeMultiply(frameTime, multiplier: Int32(written)))
+            await writer.finishWriting()
+            if writer.status != .completed {
+                throw TimelapseExportError.writerFailed(writer.error?.localizedDescription ?? "Finished with status \(writer.status.rawValue)")
+            }
+            return written
+        } catch {
+            writer.cancelWriting()
+            throw error
+        }
+    }
+
+    private static func pixelBuffer(from canvas: TimelapseCanvas, pool: CVPixelBufferPool?) -> CVPixelBuffer? {
+        guard let pool = pool, let image = canvas.makeImage() else { return nil }
+        var buffer: CVPixelBuffer?
+        guard CVPixelBufferPoolCreatePixelBuffer(nil, pool, &buffer) == kCVReturnSuccess, let buffer = buffer else { return nil }
+        CVPixelBufferLockBaseAddress(buffer, [])
+        defer { CVPixelBufferUnlockBaseAddress(buffer, []) }
+        guard let context = CGContext(
+            data: CVPixelBufferGetBaseAddress(buffer),
+            width: CVPixelBufferGetWidth(buffer),
+            height: CVPixelBufferGetHeight(buffer),
+            bitsPerComponent: 8,
+            bytesPerRow: CVPixelBufferGetBytesPerRow(buffer),
+            space: CGColorSpaceCreateDeviceRGB(),
+            bitmapInfo: CGImageAlphaInfo.premultipliedFirst.rawValue | CGBitmapInfo.byteOrder32Little.rawValue
+        ) else { return nil }
+        context.draw(image, in: CGRect(x: 0, y: 0, width: context.width, height: context.height))
+        return buffer
+    }
+
+    // MARK: Frames
+    // Calls `emit` with the canvas once per photo that could be loaded, in order; returns how many were emitted
+    private func renderFrames(_ frames: [Frame], side: Int, useMetric: Bool, progress: @escaping (Double) -> Void,
+                              emit: (TimelapseCanvas, Int) async throws -> Void) async throws -> Int {
+        let canvas = try TimelapseCanvas(side: side)
+        var written = 0
+        for (index, frame) in frames.enumerated() {
+            try Task.checkCancellation()
+            if let data = try await repository.photoData(frame.photoID, size: .display) {
+                let drawn = autoreleasepool { () -> Bool in
+                    guard let image = PhotoIngest.thumbnailImage(from: data, maxPixelSize: side * 4 / 3) else { return false }
+                    canvas.draw(image, date: frame.date, weight: frame.weight, useMetric: useMetric)
+                    return true
+                }
+                if drawn {
+                    try await emit(canvas, written)
+                    written += 1
+                } else {
+                    AppLog.warning("Skipped undecodable photo in timelapse", category: .images)
+                }
+            }
+            progress(Double(index + 1) / Double(frames.count))
+        }
+        return written
+    }
+}
+
+// MARK: - Timelapse Canvas
+// One square RGBA frame, allocated once per export and redrawn for every photo. The context is
+// flipped to UIKit coordinates so images and captions draw upright.
+final class TimelapseCanvas {
+    let side: Int
+    private let context: CGContext
+
+    private static let bitmapInfo = CGImageAlphaInfo.premultipliedLast.rawValue | CGBitmapInfo.byteOrder32Big.rawValue
+
+    init(side: Int) throws {
+        guard let context = CGContext(data: nil, width: side, height: side, bitsPerComponent: 8, bytesPerRow: side * 4,
+                                      space: CGColorSpaceCreateDeviceRGB(), bitmapInfo: Self.bitmapInfo) else {
+            throw TimelapseExportError.writerFailed("Couldn't allocate a \(side)x\(side) frame")
+        }
+        context.translateBy(x: 0, y: CGFloat(side))
+        context.scaleBy(x: 1, y: -1)
+        context.interpolationQuality = .high
+        self.side = side
+        self.context = context
+    }
+
+    // Aspect-filled photo with the date and weight in a translucent band along the bottom
+    func draw(_ image: UIImage, date: Date?, weight: Double, useMetric: Bool) {
+        let size = CGFloat(side)
+        UIGraphicsPushContext(context)
+        defer { UIGraphicsPopContext() }
+
+        UIColor.black.setFill()
+        UIRectFill(CGRect(x: 0, y: 0, width: size, height: size))
+        let scale = max(size / image.size.width, size / image.size.height)
+        let drawSize = CGSize(width: image.size.width * scale, height: image.size.height * scale)
+        image.draw(in: CGRect(x: (size - drawSize.width) / 2, y: (size - drawSize.height) / 2, width: drawSize.width, height: drawSize.height))
+
+        let bandHeight = (size * 0.12).rounded()
+        let band = CGRect(x: 0, y: size - bandHeight, width: size, height: bandHeight)
+        UIColor.black.withAlphaComponent(0.6).setFill()
+        UIRectFillUsingBlendMode(band, .normal)
+
+        let attributes: [NSAttributedString.Key: Any] = [
+            .font: UIFont.systemFont(ofSize: (size * 0.05).rounded(), weight: .semibold),
+            .foregroundColor: UIColor.white
+        ]
+        let inset = (size * 0.04).rounded()
+        if let date = date {
+            let dateText = DateFormatter.mediumDate.string(from: date) as NSString
+            let dateSize = dateText.size(withAttributes: attributes)
+            dateText.draw(at: CGPoint(x: inset, y: band.midY - dateSize.height / 2), withAttributes: attributes)
+        }
+        if weight > 0 {
+            let weightText = String(format: "%.1f %@", weight, useMetric ? "kg" : "lbs") as NSString
+            let weightSize = weightText.size(withAttributes: attributes)
+            weightText.draw(at: CGPoint(x: size - inset - weightSize.width, y: band.midY - weightSize.height / 2), withAttributes: attributes)
+        }
+    }
+
+    // A copy of the current frame for the GIF encoder
+    var pixels: PixelBuffer {
+        let count = side * side * 4
+        let bytes = context.data.map { Array(UnsafeBufferPointer(start: $0.assumingMemoryBound(to: UInt8.self), count: count)) } ?? []
+        return PixelBuffer(width: side, height: side, bytes: bytes) ?? PixelBuffer(width: side, height: side, fill: .black)
+    }
+
+    func makeImage() -> CGImage? {
+        context.makeImage()
+    }
+}
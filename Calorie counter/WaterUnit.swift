@@ -0,0 +1,79 @@
+//
+//  WaterUnit.swift
+//  Calorie counter
+//
+
+import Foundation
+
+// MARK: - Water Units
+// Water is stored in millilitres (CoreDiaryEntry.waterAmountMl); the unit is only used for display.
+enum WaterUnit: String, CaseIterable {
+    case gallons = "Gallons"
+    case liters = "Liters"
+    case milliliters = "Milliliters"
+    case flOz = "fl oz"
+
+    // Single conversion table for the whole app
+    var millilitersPerUnit: Double {
+        switch self {
+        case .gallons: return 3785.41
+        case .liters: return 1000
+        case .milliliters: return 1
+        case .flOz: return 29.5735
+        }
+    }
+
+    var shortLabel: String {
+        switch self {
+        case .gallons: return "gal"
+        case .liters: return "L"
+        case .milliliters: return "ml"
+        case .flOz: return "fl oz"
+        }
+    }
+
+    // Accepts picker labels as well as the short forms found in older entries ("ml", "gal", "fl")
+    init?(label: String) {
+        switch label.lowercased() {
+        case "gallons", "gal": self = .gallons
+        case "liters", "l": self = .liters
+        case "milliliters", "ml": self = .milliliters
+        case "fl oz", "fl", "oz": self = .flOz
+        default: return nil
+        }
+    }
+
+    func toMilliliters(_ amount: Double) -> Double {
+        amount * millilitersPerUnit
+    }
+
+    func fromMilliliters(_ milliliters: Double) -> Double {
+        milliliters / millilitersPerUnit
+    }
+
+    // Converts a stored amount into whatever unit label the day is displayed in (defaults to fl oz)
+    static func displayAmount(milliliters: Double, in unitLabel: String) -> Double {
+        (WaterUnit(label: unitLabel) ?? .flOz).fromMilliliters(milliliters)
+    }
+
+    // Parses picker amounts such as "8", "0.25" or "1/2"
+    static func parseAmount(_ amountString: String) -> Double? {
+        let fractionMap: [String: Double] = ["1/4": 0.25, "1/2": 0.5, "3/4": 0.75]
+        if let fractionValue = fractionMap[amountString] {
+            return fractionValue
+        }
+        return Double(amountString)
+    }
+
+    // Legacy "16 fl oz" / "1/2 Gallons" detail strings, only used by the one-time migration
+    static func millilitersFromLegacyDetail(_ detail: String) -> Double {
+        let trimmed = detail.trimmingCharacters(in: .whitespaces)
+        guard let splitIndex = trimmed.firstIndex(of: " ") else { return 0 }
+        let amountString = String(trimmed[..<splitIndex])
+        let unitString = trimmed[splitIndex...].trimmingCharacters(in: .whitespaces)
+        guard let amount = parseAmount(amountString), let unit = WaterUnit(label: unitString) else {
+            return 0
+        }
+        return unit.toMilliliters(amount)
+    }
+}
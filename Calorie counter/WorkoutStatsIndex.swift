@@ -0,0 +1,212 @@
+//
+//  WorkoutStatsIndex.swift
+//  Calorie counter
+//
+
+import Foundation
+import CoreData
+import Combine
+
+// MARK: - Workout Stats
+struct ActivityWorkoutStats: Equatable {
+    let name: String
+    var minutes: Double = 0
+    var calories: Double = 0
+    var sessions: Int = 0
+    var lastPerformed: Date? = nil
+}
+
+struct WorkoutSummary: Equatable {
+    var totalMinutes: Double = 0
+    var totalCalories: Double = 0
+    var sessionCount: Int = 0
+    var workoutDayCount: Int = 0
+    var favoriteActivity: ActivityWorkoutStats? = nil // Most minutes overall
+}
+
+// MARK: - Workout Stats Index
+// Per-activity totals and a global summary, maintained incrementally from WorkoutEntry changes
+// so overview screens never rescan every DailyRecord.
+final class WorkoutStatsIndex: ObservableObject {
+    static let shared = WorkoutStatsIndex(context: PersistenceController.shared.context)
+
+    @Published private(set) var statsByActivity: [String: ActivityWorkoutStats] = [:]
+    @Published private(set) var summary = WorkoutSummary()
+    private(set) var workoutDays: [Date: Int] = [:] // Start of day -> session count
+
+    // What each stored entry currently adds to the tables, so updates and deletes can be subtracted exactly
+    private struct Contribution {
+        let name: String
+        let minutes: Double
+        let calories: Double
+        let day: Date
+        let timestamp: Date?
+    }
+    private var contributions: [NSManagedObjectID: Contribution] = [:]
+
+    private let context: NSManagedObjectContext
+    private let clock: AppClock
+    private var changeObserver: AnyCancellable?
+
+    init(context: NSManagedObjectContext, clock: AppClock = .shared) {
+        self.context = context
+        self.clock = clock
+        reload()
+        changeObserver = NotificationCenter.default
+            .publisher(for: .NSManagedObjectContextObjectsDidChange, object: context)
+            .merge(with: NotificationCenter.default.publisher(for: .NSManagedObjectContextDidSave, object: context))
+            .sink { [weak self] notification in
+                self?.applyChanges(notification)
+            }
+    }
+
+    // MARK: Lookup
+    func stats(forActivityNamed name: String) -> ActivityWorkoutStats? {
+        statsByActivity[name]
+    }
+
+    func hasWorkout(on day: Date) -> Bool {
+        workoutDays[clock.startOfDay(for: day)] != nil
+    }
+
+    // Consecutive workout days ending the day before `date`
+    func currentStreak(before date: Date) -> Int {
+        StreakCalculator.currentRun(before: date, calendar: clock.calendar) { workoutDays[$0] != nil }
+    }
+
+    func longestStreak() -> Int {
+        StreakCalculator.longestRun(workoutDays.keys, calendar: clock.calendar) { workoutDays[$0] != nil }
+    }
+
+    // MARK: Sync
+    func reload() {
+        contributions = [:]
+        let fetchRequest: NSFetchRequest<WorkoutEntry> = WorkoutEntry.fetchRequest()
+        fetchRequest.relationshipKeyPathsForPrefetching = ["dailyRecord"]
+        do {
+            for entry in try context.loggedFetch(fetchRequest) {
+                if let contribution = contribution(for: entry) {
+                    contributions[entry.objectID] = contribution
+                }
+            }
+        } catch {
+            AppLog.error("Failed to load workout stats: \(error.localizedDescription)", category: .diary)
+        }
+        rebuildTables()
+    }
+
+    private func contribution(for entry: WorkoutEntry) -> Contribution? {
+        guard let name = entry.name, !name.isEmpty else { return nil }
+        let dayReference = entry.dailyRecord?.date ?? entry.timestamp ?? clock.now
+        return Contribution(
+            name: name,
+            minutes: entry.duration,
+            calories: entry.caloriesBurned,
+            day: clock.startOfDay(for: dayReference),
+            timestamp: entry.timestamp ?? entry.dailyRecord?.date
+        )
+    }
+
+    private func rebuildTables() {
+        var byActivity: [String: ActivityWorkoutStats] = [:]
+        var days: [Date: Int] = [:]
+        var newSummary = WorkoutSummary()
+        for contribution in contributions.values {
+            add(contribution, to: &byActivity, days: &days, summary: &newSummary)
+        }
+        publish(byActivity, days: days, summary: newSummary)
+    }
+
+    private func applyChanges(_ notification: Notification) {
+        guard let userInfo = notification.userInfo else { return }
+        if userInfo[NSInvalidatedAllObjectsKey] != nil {
+            reload()
+            return
+        }
+
+        var byActivity = statsByActivity
+        var days = workoutDays
+        var newSummary = summary
+        var changed = false
+
+        let removed = ((userInfo[NSDeletedObjectsKey] as? Set<NSManagedObject>) ?? [])
+            .union((userInfo[NSInvalidatedObjectsKey] as? Set<NSManagedObject>) ?? [])
+        for case let entry as WorkoutEntry in removed {
+            guard let old = contributions.removeValue(forKey: entry.objectID) else { continue }
+            remove(old, from: &byActivity, days: &days, summary: &newSummary)
+            changed = true
+        }
+
+        for key in [NSInsertedObjectsKey, NSUpdatedObjectsKey, NSRefreshedObjectsKey] {
+            for case let entry as WorkoutEntry in (userInfo[key] as? Set<NSManagedObject>) ?? [] where !entry.isDeleted {
+                // Unsaved inserts are picked up from DidSave once their IDs are permanent
+                guard !entry.objectID.isTemporaryID else { continue }
+                if let old = contributions.removeValue(forKey: entry.objectID) {
+                    remove(old, from: &byActivity, days: &days, summary: &newSummary)
+                }
+                if let new = contribution(for: entry) {
+                    contributions[entry.objectID] = new
+                    add(new, to: &byActivity, days: &days, summary: &newSummary)
+                }
+                changed = true
+            }
+        }
+
+        if changed {
+            publish(byActivity, days: days, summary: newSummary)
+        }
+    }
+
+    // MARK: Table Updates
+    private func add(_ contribution: Contribution, to byActivity: inout [String: ActivityWorkoutStats], days: inout [Date: Int], summary: inout WorkoutSummary) {
+        var stats = byActivity[contribution.name] ?? ActivityWorkoutStats(name: contribution.name)
+        stats.minutes += contribution.minutes
+        stats.calories += contribution.calories
+        stats.sessions += 1
+        if let timestamp = contribution.timestamp, timestamp > (stats.lastPerformed ?? .distantPast) {
+            stats.lastPerformed = timestamp
+        }
+        byActivity[contribution.name] = stats
+
+        days[contribution.day, default: 0] += 1
+        summary.totalMinutes += contribution.minutes
+        summary.totalCalories += contribution.calories
+        summary.sessionCount += 1
+    }
+
+    private func remove(_ contribution: Contribution, from byActivity: inout [String: ActivityWorkoutStats], days: inout [Date: Int], summary: inout WorkoutSummary) {
+        if var stats = byActivity[contribution.name] {
+            stats.sessions -= 1
+            if stats.sessions <= 0 {
+                byActivity[contribution.name] = nil
+            } else {
+                stats.minutes = max(0, stats.minutes - contribution.minutes)
+                stats.calories = max(0, stats.calories - contribution.calories)
+                if let timestamp = contribution.timestamp, timestamp == stats.lastPerformed {
+                    // Only the newest session needs a rescan, and only over this activity's entries
+                    stats.lastPerformed = contributions.values
+                        .filter { $0.name == contribution.name }
+                        .compactMap(\.timestamp)
+                        .max()
+                }
+                byActivity[contribution.name] = stats
+            }
+        }
+
+        if let count = days[contribution.day] {
+            days[contribution.day] = count > 1 ? count - 1 : nil
+        }
+        summary.totalMinutes = max(0, summary.totalMinutes - contribution.minutes)
+        summary.totalCalories = max(0, summary.totalCalories - contribution.calories)
+        summary.sessionCount = max(0, summary.sessionCount - 1)
+    }
+
+    private func publish(_ byActivity: [String: ActivityWorkoutStats], days: [Date: Int], summary newSummary: WorkoutSummary) {
+        var newSummary = newSummary
+        newSummary.workoutDayCount = days.count
+        newSummary.favoriteActivity = byActivity.values.max { $0.minutes < $1.minutes }
+        workoutDays = days
+        statsByActivity = byActivity
+        summary = newSummary
+    }
+}
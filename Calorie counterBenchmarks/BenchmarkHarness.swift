@@ -0,0 +1,172 @@
+//
+//  BenchmarkHarness.swift
+//  Calorie counterBenchmarks
+//
+
+import Foundation
+import XCTest
+
+// MARK: - Benchmark Configuration
+// History sizes come from the environment so CI can run a quick pass and a release machine the full sweep:
+//   BENCHMARK_YEARS=1,5,10  BENCHMARK_FOODS_PER_DAY=4  BENCHMARK_WORKOUTS_PER_DAY=1  BENCHMARK_WEIGH_INS_PER_DAY=1
+//   BENCHMARK_ITERATIONS=5  BENCHMARK_SEED=42  BENCHMARK_RECORD=1 (rewrite Baselines.json with this run's medians)
+//   BENCHMARK_REQUIRE_BASELINE=1 (fail results that have no baseline instead of warning about them)
+enum BenchmarkConfiguration {
+    private static let environment = ProcessInfo.processInfo.environment
+
+    static var years: [Int] {
+        let list = environment["BENCHMARK_YEARS"] ?? "1,5,10"
+        let years = list.split(separator: ",").compactMap { Int($0.trimmingCharacters(in: .whitespaces)) }.filter { $0 > 0 }
+        return years.isEmpty ? [1] : years
+    }
+
+    static var foodsPerDay: Int { integer("BENCHMARK_FOODS_PER_DAY", default: 4) }
+    static var workoutsPerDay: Int { integer("BENCHMARK_WORKOUTS_PER_DAY", default: 1) }
+    static var weighInsPerDay: Int { integer("BENCHMARK_WEIGH_INS_PER_DAY", default: 1) }
+    static var iterations: Int { max(1, integer("BENCHMARK_ITERATIONS", default: 5)) }
+    static var seed: UInt64 { UInt64(environment["BENCHMARK_SEED"] ?? "") ?? 42 }
+    static var isRecording: Bool { environment["BENCHMARK_RECORD"] == "1" }
+    static var requiresBaseline: Bool { environment["BENCHMARK_REQUIRE_BASELINE"] == "1" }
+
+    static func history(years: Int) -> SyntheticHistory.Configuration {
+        var configuration = SyntheticHistory.Configuration(years: years, seed: seed)
+        configuration.foodsPerDay = foodsPerDay
+        configuration.workoutsPerDay = workoutsPerDay
+        configuration.weighInsPerDay = weighInsPerDay
+        return configuration
+    }
+
+    private static func integer(_ key: String, default value: Int) -> Int {
+        environment[key].flatMap { Int($0) } ?? value
+    }
+}
+
+// MARK: - Baselines
+// Baselines.json sits next to this file. Medians are stored in seconds per platform, since a simulator
+// and a Linux runner are not comparable; a result fails when it exceeds baseline * (1 + tolerance).
+// A result with no baseline on this platform is only a warning until one is recorded, or a failure
+// with BENCHMARK_REQUIRE_BASELINE=1 once CI has medians checked in.
+final class BenchmarkBaselines {
+    static let shared = BenchmarkBaselines()
+
+    static var platform: String {
+        #if os(Linux)
+        return "linux"
+        #elseif targetEnvironment(simulator)
+        return "ios-simulator"
+        #elseif os(iOS)
+        return "ios-device"
+        #else
+        return "macos"
+        #endif
+    }
+
+    private struct File: Codable {
+        var tolerance: Double
+        var platforms: [String: [String: Double]]
+    }
+
+    private let url = URL(fileURLWithPath: #filePath).deletingLastPathComponent().appendingPathComponent("Baselines.json")
+    private let lock = NSLock()
+    private var file: File
+    private var recorded: [String: Double] = [:]
+
+    private init() {
+        do {
+            let data = try Data(contentsOf: url)
+            file = try JSONDecoder().decode(File.self, from: data)
+        } catch {
+            print("⚠️ No readable baselines at \(url.path), results are reported only: \(error.localizedDescription)")
+            file = File(tolerance: 0.25, platforms: [:])
+        }
+    }
+
+    var tolerance: Double { file.tolerance }
+
+    func baseline(for name: String) -> Double? {
+        lock.lock()
+        defer { lock.unlock() }
+        return file.platforms[Self.platform]?[name]
+    }
+
+    // Record mode rewrites the file after every result, so a partial run still keeps what it measured
+    func record(_ seconds: Double, for name: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        recorded[name] = seconds
+        file.platforms[Self.platform, default: [:]][name] = seconds
+        do {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+            try encoder.encode(file).write(to: url, options: .atomic)
+        } catch {
+            print("❌ Failed to write baselines: \(error.localizedDescription)")
+        }
+    }
+}
+
+// MARK: - Measuring
+extension XCTestCase {
+    // Median wall time of `iterations` runs after one warm-up; `setUp` runs before each timed run and is not timed
+    func benchmark(_ name: String,
+                   iterations: Int = BenchmarkConfiguration.iterations,
+                   file: StaticString = #filePath,
+                   line: UInt = #line,
+                   setUp: () throws -> Void = {},
+                   _ body: () throws -> Void) rethrows {
+        try setUp()
+        try body()
+        var samples: [Double] = []
+        for _ in 0..<iterations {
+            try setUp()
+            let start = DispatchTime.now().uptimeNanoseconds
+            try body()
+            samples.append(Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000)
+        }
+        report(name, samples: samples, file: file, line: line)
+    }
+
+    func benchmark(_ name: String,
+                   iterations: Int = BenchmarkConfiguration.iterations,
+                   file: StaticString = #filePath,
+                   line: UInt = #line,
+                   _ body: () async throws -> Void) async rethrows {
+        try await body()
+        var samples: [Double] = []
+        for _ in 0..<iterations {
+            let start = DispatchTime.now().uptimeNanoseconds
+            try await body()
+            samples.append(Double(DispatchTime.now().uptimeNanoseconds - start) / 1_000_000_000)
+        }
+        report(name, samples: samples, file: file, line: line)
+    }
+
+    private func report(_ name: String, samples: [Double], file: StaticString, line: UInt) {
+        let sorted = samples.sorted()
+        let median = sorted[sorted.count / 2]
+        let baselines = BenchmarkBaselines.shared
+        let milliseconds = String(format: "%.3f", median * 1000)
+
+        if BenchmarkConfiguration.isRecording {
+            baselines.record(median, for: name)
+            print("✅ [benchmark] \(name): \(milliseconds) ms (recorded)")
+            return
+        }
+        guard let baseline = baselines.baseline(for: name) else {
+            let message = "\(name): \(milliseconds) ms has no \(BenchmarkBaselines.platform) baseline; record one with BENCHMARK_RECORD=1"
+            if BenchmarkConfiguration.requiresBaseline {
+                XCTFail(message, file: file, line: line)
+            } else {
+                print("⚠️ [benchmark] \(message)")
+            }
+            return
+        }
+        let limit = baseline * (1 + baselines.tolerance)
+        let change = String(format: "%+.1f%%", (median / baseline - 1) * 100)
+        if median > limit {
+            XCTFail("\(name) regressed: \(milliseconds) ms vs baseline \(String(format: "%.3f", baseline * 1000)) ms (\(change))", file: file, line: line)
+        } else {
+            print("✅ [benchmark] \(name): \(milliseconds) ms (\(change) vs baseline)")
+        }
+    }
+}
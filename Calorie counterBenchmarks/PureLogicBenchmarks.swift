@@ -0,0 +1,230 @@
+//
+//  PureLogicBenchmarks.swift
+//  Calorie counterBenchmarks
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+@testable import CalorieCoreTestSupport
+#else
+@testable import Calorie_counter
+#endif
+
+// MARK: - Pure Logic Benchmarks
+// Foundation-only hot paths; these also run headless on Linux through Package.swift
+final class PureLogicBenchmarks: XCTestCase {
+
+    // MARK: Streaks
+    // Worst case for the Today header: every day passed, so the walk covers the whole history
+    func testPassStreak() {
+        for years in BenchmarkConfiguration.years {
+            let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+            let newestFirst = history.days.reversed().map { (day: $0.date, passed: true) }
+            var streak = 0
+            benchmark("streak.pass.\(years)y") {
+                streak = StreakCalculator.passStreak(newestFirst, before: history.today)
+            }
+            XCTAssertGreaterThan(streak, 0)
+        }
+    }
+
+    // Progress overview: longest run over the workout-day table
+    func testLongestWorkoutRun() {
+        for years in BenchmarkConfiguration.years {
+            let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+            var workoutDays: [Date: Int] = [:]
+            for day in history.days where !day.workouts.isEmpty {
+                workoutDays[day.date] = day.workouts.count
+            }
+            var longest = 0
+            benchmark("streak.longestWorkoutRun.\(years)y") {
+                longest = StreakCalculator.longestRun(workoutDays.keys) { workoutDays[$0] != nil }
+            }
+            XCTAssertEqual(longest == 0, workoutDays.isEmpty)
+        }
+    }
+
+    // MARK: Past Summaries
+    // The per-day arithmetic behind the Past tab, without the fetch
+    func testDaySummaryTotals() {
+        for years in BenchmarkConfiguration.years {
+            let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+            var passedDays = 0
+            benchmark("summaries.totals.\(years)y") {
+                passedDays = history.days.reduce(0) { $0 + ($1.passed ? 1 : 0) }
+            }
+            XCTAssertLessThanOrEqual(passedDays, history.days.count)
+        }
+    }
+
+    // MARK: Body Measurements
+    // Building the measurement series with its stats, as the Progress tab does after the fetch
+    func testMeasurementSeries() {
+        for years in BenchmarkConfiguration.years {
+            var configuration = BenchmarkConfiguration.history(years: years)
+            configuration.measurementEveryDays = 1
+            let history = SyntheticHistory(configuration)
+            let samples: [(date: Date, centimeters: [Double])] = history.days.compactMap { day in
+                day.measurement.map { measurement in
+                    (date: day.date, centimeters: [measurement.chest, measurement.waist, measurement.hips, measurement.arm,
+                                                   measurement.arm, measurement.thigh, measurement.thigh].map(LengthUnit.inches.toCentimeters))
+                }
+            }
+            benchmark("measurements.series.\(years)y") {
+                var series = MeasurementSeries()
+                for sample in samples {
+                    series.append(date: sample.date, centimeters: sample.centimeters)
+                }
+                _ = series.stats(.waist).ratePerWeek
+            }
+        }
+    }
+
+    // MARK: History Archive
+    // Appending a whole history in rollover-sized batches, then whole-history scans over the mapped columns
+    func testHistoryArchive() throws {
+        for years in BenchmarkConfiguration.years {
+            let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+            let days = history.days.map(\.archived)
+            let directory = FileManager.default.temporaryDirectory.appendingPathComponent("HistoryArchive-\(UUID().uuidString)")
+            defer { try? FileManager.default.removeItem(at: directory) }
+
+            var archive = try HistoryArchive.open(at: directory)
+            try benchmark("archive.append.\(years)y") {
+                try? FileManager.default.removeItem(at: directory)
+                archive = try HistoryArchive.open(at: directory)
+                for start in stride(from: 0, to: days.count, by: 180) {
+                    archive = try archive.appending(Array(days[start..<min(start + 180, days.count)]))
+                }
+            }
+
+            try benchmark("archive.scan.\(years)y") {
+                let opened = try HistoryArchive.open(at: directory)
+                _ = opened.withValues(.calorieIntake) { $0.reduce(0, +) / Double(max($0.count, 1)) }
+                _ = opened.withFlags(.passed) { $0.reduce(0) { $0 + Int($1) } }
+            }
+        }
+    }
+
+    // MARK: Backup
+    // A full backup of a synthetic store, a daily backup after one page changed and a photo was added,
+    // and restoring that daily snapshot. A local directory stands in for remote storage.
+    func testIncrementalBackup() throws {
+        for years in BenchmarkConfiguration.years {
+            let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+            let root = FileManager.default.temporaryDirectory.appendingPathComponent("Backup-\(UUID().uuidString)")
+            defer { try? FileManager.default.removeItem(at: root) }
+            let store = root.appendingPathComponent("store")
+            let remote = root.appendingPathComponent("remote")
+            try history.writeStoreStandIn(to: store)
+            let storeURL = store.appendingPathComponent("Store.sqlite")
+            let original = try Data(contentsOf: storeURL)
+
+            var repository = try BackupRepository(directory: remote)
+            try benchmark("backup.full.\(years)y") {
+                try? FileManager.default.removeItem(at: remote)
+                repository = try BackupRepository(directory: remote)
+                _ = try repository.backUp(store)
+            }
+
+            var changed = original
+            changed[changed.count - 4096 + 100] ^= 0xFF
+            try changed.write(to: storeURL)
+            try SyntheticHistory.photoBytes(count: 48 * 1024, seed: 7).write(to: store.appendingPathComponent(".Store_SUPPORT/_EXTERNAL_DATA/new-photo"))
+            let latest = try repository.backUp(store).snapshot
+            let restored = root.appendingPathComponent("restored")
+            try benchmark("backup.restore.\(years)y") {
+                try? FileManager.default.removeItem(at: restored)
+                try repository.restore(latest, to: restored)
+            }
+        }
+    }
+
+    // MARK: Search Pipeline
+    // Request building plus parsing a full page of Open Food Facts results
+    func testFoodSearchPipeline() throws {
+        let payload = try Self.searchPayload(productCount: 100)
+        var results: [FoodSearchResult] = []
+        try benchmark("search.pipeline.100") {
+            _ = FoodSearch.url(for: "greek yogurt with honey & granola", pageSize: 100)
+            results = try FoodSearch.results(from: payload) ?? []
+        }
+        XCTAssertEqual(results.count, 90) // Every tenth product has no name and is dropped
+    }
+
+    // MARK: Diary Import
+    // Parsing and mapping a MyFitnessPal-style export of the whole history, fed in 64 KB chunks as the importer reads it
+    func testDiaryCSVImport() {
+        for years in BenchmarkConfiguration.years {
+            let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+            let csv = history.myFitnessPalCSV()
+            var foods: [ImportedFood] = []
+            benchmark("import.csv.\(years)y") {
+                foods = []
+                var mapping: DiaryCSVMapping?
+                func handle(_ row: [String]) {
+                    if let mapping = mapping {
+                        if let food = mapping.food(from: row) {
+                            foods.append(food)
+                        }
+                    } else {
+                        mapping = DiaryCSVMapping(header: row)
+                    }
+                }
+                var parser = CSVParser()
+                var offset = 0
+                while offset < csv.count {
+                    let end = min(offset + 65_536, csv.count)
+                    parser.feed(csv[offset..<end], row: handle)
+                    offset = end
+                }
+                parser.finish(row: handle)
+            }
+        }
+    }
+
+    // MARK: Share Card
+    // The pixel layer of a 2x share card from two display-sized photos
+    func testShareCardComposite() {
+        let start = PixelBuffer.gradient(width: 960, height: 1280, tint: 0)
+        let latest = PixelBuffer.gradient(width: 1280, height: 960, tint: 255)
+        let background = PixelColor(red: 240, green: 240, blue: 240, alpha: 255)
+        let layout = ShareCard.Layout(scale: 2, titleOverlayWidth: 250)
+        benchmark("share.composite.2x") {
+            _ = ShareCard.composite(start: start, latest: latest, background: background, layout: layout)
+        }
+    }
+
+    // MARK: Timelapse
+    // Quantizing and compressing GIF frames at export size; the sink only ever sees one frame at a time
+    func testGIFEncoding() throws {
+        let frames = (0..<4).map { PixelBuffer.gradient(width: 480, height: 480, tint: UInt8($0 * 80)) }
+        var byteCount = 0
+        try benchmark("timelapse.gif.4frames") {
+            byteCount = 0
+            var encoder = try GIFEncoder(width: 480, height: 480) { byteCount += $0.count }
+            for frame in frames {
+                try encoder.addFrame(frame, delay: 50)
+            }
+            try encoder.finish()
+        }
+    }
+
+    private static func searchPayload(productCount: Int) throws -> Data {
+        var generator = SeededGenerator(seed: BenchmarkConfiguration.seed)
+        let products: [[String: Any]] = (0..<productCount).map { index in
+            var product: [String: Any] = [
+                "code": String(format: "%013d", Int.random(in: 0..<1_000_000_000, using: &generator)),
+                "brands": "Brand \(index % 7)",
+                "nutriments": ["energy-kcal_100g": Int.random(in: 40...600, using: &generator)]
+            ]
+            if index % 10 != 0 {
+                product["product_name"] = "Synthetic Food \(index)"
+            }
+            return product
+        }
+        return try JSONSerialization.data(withJSONObject: ["count": productCount, "page": 1, "products": products])
+    }
+}
@@ -0,0 +1,154 @@
+//
+//  StoreBenchmarks.swift
+//  Calorie counterBenchmarks
+//
+
+import Foundation
+import CoreData
+import XCTest
+@testable import Calorie_counter
+
+// MARK: - Store Benchmarks
+// Core Data hot paths against an in-memory store seeded with a synthetic history.
+// Apple platforms only; run from the "Calorie counterBenchmarks" scheme, ideally in Release.
+@MainActor
+final class StoreBenchmarks: XCTestCase {
+    // Seeding ten years takes longer than the benchmarks themselves, so each size is built once per run
+    private static var stores: [Int: (persistence: PersistenceController, history: SyntheticHistory)] = [:]
+
+    private func store(years: Int) async throws -> (persistence: PersistenceController, history: SyntheticHistory) {
+        if let store = Self.stores[years] {
+            return store
+        }
+        let history = SyntheticHistory(BenchmarkConfiguration.history(years: years))
+        let persistence = PersistenceController(inMemory: true)
+        try await SyntheticDataGenerator(persistence: persistence).generate(history)
+        Self.stores[years] = (persistence, history)
+        return (persistence, history)
+    }
+
+    // MARK: Today
+    func testOpenDay() async throws {
+        for years in BenchmarkConfiguration.years {
+            let (persistence, history) = try await store(years: years)
+            let repository = DataRepository(persistence: persistence)
+            let day = history.days[history.days.count / 2]
+            var snapshot: DayRecordSnapshot?
+            try await benchmark("today.openDay.\(years)y") {
+                snapshot = try await repository.dayRecord(for: day.date)
+            }
+            XCTAssertEqual(snapshot?.entries.count, day.foods.count + day.workouts.count + day.water.count)
+        }
+    }
+
+    func testDayHeaderStreak() async throws {
+        for years in BenchmarkConfiguration.years {
+            let (persistence, history) = try await store(years: years)
+            let repository = DataRepository(persistence: persistence)
+            let yesterday = history.days.last!.date
+            try await benchmark("today.header.\(years)y") {
+                _ = try await repository.dayHeader(for: yesterday, today: history.today)
+            }
+        }
+    }
+
+    // MARK: Past
+    func testPastSummaries() async throws {
+        for years in BenchmarkConfiguration.years {
+            let (persistence, history) = try await store(years: years)
+            let repository = DataRepository(persistence: persistence)
+            var summaries: [DaySummary] = []
+            try await benchmark("past.summaries.\(years)y") {
+                summaries = try await repository.daySummaries()
+            }
+            XCTAssertEqual(summaries.count, history.days.count)
+        }
+    }
+
+    // MARK: Progress
+    // Building the workout index from scratch is what the Progress overview pays on a cold launch
+    func testProgressOverview() async throws {
+        for years in BenchmarkConfiguration.years {
+            let (persistence, _) = try await store(years: years)
+            let context = persistence.container.viewContext
+            var longest = 0
+            benchmark("progress.overview.\(years)y", setUp: { context.reset() }) {
+                let index = WorkoutStatsIndex(context: context)
+                longest = index.longestStreak()
+                _ = index.summary
+            }
+            XCTAssertEqual(longest == 0, BenchmarkConfiguration.workoutsPerDay == 0)
+        }
+    }
+
+    // MARK: Time Travel
+    // A year of headless day rollovers per iteration, on a fresh profile with its own clock
+    func testTimeTravelYear() async throws {
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(identifier: "America/New_York")!
+        let startDay = calendar.date(from: DateComponents(year: 2024, month: 1, day: 1))!
+        let clock = AppClock(calendar: calendar, simulatedDay: startDay)
+        let persistence = PersistenceController(inMemory: true)
+        try await persistence.waitForStores()
+
+        let context = persistence.container.viewContext
+        let userProfile = UserProfile(context: context)
+        userProfile.name = "Benchmark"
+        userProfile.gender = "Woman"
+        userProfile.birthdate = calendar.date(from: DateComponents(year: 1990, month: 6, day: 15))
+        userProfile.age = 33
+        userProfile.heightFt = 5
+        userProfile.heightIn = 6
+        userProfile.currentWeight = 170
+        userProfile.startWeight = 170
+        userProfile.goalWeight = 150
+        userProfile.weekGoal = -1
+        userProfile.goalId = 1
+        userProfile.activityInt = 1
+        userProfile.startDate = startDay
+        try context.save()
+
+        let engine = TimeTravelEngine(persistence: persistence, clock: clock)
+        var report = TimeTravelEngine.Report()
+        try await benchmark("timeTravel.year") {
+            report = try await engine.advance(days: 365)
+        }
+        XCTAssertEqual(report.days, 365)
+        XCTAssertGreaterThan(report.age, 33) // Every iteration crosses a birthday
+        XCTAssertEqual(report.passedDays, 0) // Days nobody opened don't pass
+        XCTAssertEqual(report.passStreak, 0)
+        XCTAssertEqual(report.highStreak, 0)
+    }
+
+    // MARK: Saving
+    // Adding one food to today's record and saving, with the full history behind it
+    func testSaveAfterAddingEntry() async throws {
+        for years in BenchmarkConfiguration.years {
+            let (persistence, history) = try await store(years: years)
+            let context = persistence.container.viewContext
+            let today = history.today
+            let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+            fetchRequest.predicate = NSPredicate(format: "date == %@", today as NSDate)
+            let record = try context.fetch(fetchRequest).first ?? {
+                let record = DailyRecord(context: context)
+                record.date = today
+                record.calorieGoal = history.configuration.calorieGoal
+                return record
+            }()
+
+            try benchmark("today.saveEntry.\(years)y") {
+                let entry = CoreDiaryEntry(context: context)
+                entry.timestamp = Date()
+                entry.type = "Food"
+                entry.entryDescription = "Benchmark Snack"
+                entry.calories = 200
+                entry.protein = 10
+                entry.carbs = 20
+                entry.fats = 8
+                entry.dailyRecord = record
+                record.calorieIntake += 200
+                try context.save()
+            }
+        }
+    }
+}
@@ -0,0 +1,109 @@
+//
+//  SyntheticHistoryFixtures.swift
+//  Calorie counterTestSupport
+//
+
+import Foundation
+#if canImport(CalorieCore)
+@testable import CalorieCore
+#else
+@testable import Calorie_counter
+#endif
+
+// MARK: - Fixtures
+// Shapes the unit tests and benchmarks share, built straight from a SyntheticHistory's values.
+// Compiled into both test bundles only; the app never ships them.
+extension SyntheticHistory.Day {
+    // What HistoryArchiver would write for this day once it is closed
+    var archived: ArchivedDay {
+        var archived = ArchivedDay(date: date, calorieIntake: calorieIntake, calorieGoal: calorieGoal, passed: passed,
+                                   weighIn: weight ?? 0, waterIntake: waterMilliliters, waterGoal: waterGoalMilliliters, waterUnit: "Milliliters")
+        for food in foods {
+            archived.protein += food.protein
+            archived.carbs += food.carbs
+            archived.fats += food.fats
+            archived.entries.append(ArchivedEntry(kind: .food, timestamp: food.timestamp, name: food.name, calories: Double(food.calories),
+                                                  protein: food.protein, carbs: food.carbs, fats: food.fats))
+        }
+        for workout in workouts {
+            archived.workoutMinutes += workout.minutes
+            archived.entries.append(ArchivedEntry(kind: .workout, timestamp: workout.timestamp, name: workout.activity.name,
+                                                  calories: workout.caloriesBurned, amount: workout.minutes))
+        }
+        archived.entries += water.map { ArchivedEntry(kind: .water, timestamp: $0.timestamp, amount: $0.milliliters) }
+        archived.entries += weighIns.map { ArchivedEntry(kind: .weighIn, timestamp: $0.timestamp, amount: $0.weight) }
+        return archived
+    }
+}
+
+extension SyntheticHistory {
+    // Stand-in for a Core Data store: the rows packed into partly filled 4 KB pages, and a photo
+    // in the external-storage folder for each picture day
+    func writeStoreStandIn(to directory: URL) throws {
+        let photos = directory.appendingPathComponent(".Store_SUPPORT/_EXTERNAL_DATA", isDirectory: true)
+        try FileManager.default.createDirectory(at: photos, withIntermediateDirectories: true)
+        var pages = Data()
+        var page = Data()
+        for (index, day) in days.enumerated() {
+            var row = "\(day.date.timeIntervalSinceReferenceDate)|\(day.calorieIntake)|\(day.calorieGoal)|\(day.passed)"
+            for food in day.foods {
+                row += "|\(food.name),\(food.calories),\(food.protein),\(food.carbs),\(food.fats)"
+            }
+            let bytes = Data(row.utf8)
+            if page.count + bytes.count > 4096 {
+                pages.append(page + Data(count: 4096 - page.count))
+                page = Data()
+            }
+            page.append(bytes.prefix(4096))
+            if day.hasPicture {
+                try Self.photoBytes(count: 48 * 1024, seed: UInt64(index)).write(to: photos.appendingPathComponent("photo-\(index)"))
+            }
+        }
+        pages.append(page + Data(count: 4096 - page.count))
+        try pages.write(to: directory.appendingPathComponent("Store.sqlite"))
+    }
+
+    // One row per food, laid out like MyFitnessPal's nutrition export
+    func myFitnessPalCSV() -> Data {
+        let dayFormatter = DateFormatter()
+        dayFormatter.locale = Locale(identifier: "en_US_POSIX")
+        dayFormatter.dateFormat = "yyyy-MM-dd"
+        let timeFormatter = DateFormatter()
+        timeFormatter.locale = Locale(identifier: "en_US_POSIX")
+        timeFormatter.dateFormat = "h:mm a"
+        var csv = CSV.line(["Date", "Meal", "Time", "Calories", "Fat (g)", "Carbohydrates (g)", "Protein (g)", "Note"])
+        for day in days {
+            for food in day.foods {
+                csv += CSV.line([dayFormatter.string(from: day.date), food.name, timeFormatter.string(from: food.timestamp),
+                                 String(food.calories), String(food.fats), String(food.carbs), String(food.protein), ""])
+            }
+        }
+        return Data(csv.utf8)
+    }
+
+    // Incompressible, like JPEG data
+    static func photoBytes(count: Int, seed: UInt64) -> Data {
+        var generator = SeededGenerator(seed: seed)
+        var data = Data(capacity: count)
+        while data.count < count {
+            data.appendLittleEndian(generator.next())
+        }
+        return data.prefix(count)
+    }
+}
+
+extension PixelBuffer {
+    // Red across, green down, a fixed blue; every pixel differs from its neighbours
+    static func gradient(width: Int, height: Int, tint: UInt8) -> PixelBuffer {
+        var bytes = [UInt8](repeating: 255, count: width * height * 4)
+        for y in 0..<height {
+            for x in 0..<width {
+                let offset = (y * width + x) * 4
+                bytes[offset] = UInt8(x * 255 / width)
+                bytes[offset + 1] = UInt8(y * 255 / height)
+                bytes[offset + 2] = tint
+            }
+        }
+        return PixelBuffer(width: width, height: height, bytes: bytes)!
+    }
+}
@@ -0,0 +1,107 @@
+//
+//  BackupRepositoryTests.swift
+//  Calorie counterTests
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+@testable import CalorieCoreTestSupport
+#else
+@testable import Calorie_counter
+#endif
+
+final class BackupRepositoryTests: XCTestCase {
+    private var root: URL!
+    private var store: URL { root.appendingPathComponent("store") }
+
+    override func setUpWithError() throws {
+        root = FileManager.default.temporaryDirectory.appendingPathComponent("Backup-\(UUID().uuidString)")
+        try SyntheticHistory(SyntheticHistory.Configuration(days: 365)).writeStoreStandIn(to: store)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: root)
+    }
+
+    // MARK: Primitives
+    func testSHA256KnownDigests() {
+        XCTAssertEqual(SHA256.hex(SHA256.digest(Data("abc".utf8))), "ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad")
+        XCTAssertEqual(SHA256.hex(SHA256.digest(Data())), "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855")
+        var hasher = SHA256()
+        let long = Data((0..<1000).map { UInt8(truncatingIfNeeded: $0) })
+        hasher.update(long.prefix(37))
+        hasher.update(long.dropFirst(37))
+        XCTAssertEqual(hasher.finalize(), SHA256.digest(long))
+    }
+
+    func testLZCodecRoundTrips() {
+        let samples: [[UInt8]] = [
+            [], [1, 2, 3], [UInt8](repeating: 0, count: 70_000),
+            [UInt8](SyntheticHistory.photoBytes(count: 5000, seed: 3)),
+            Array(repeating: Array("calories,protein,".utf8), count: 300).flatMap { $0 }
+        ]
+        for sample in samples {
+            let compressed = LZCodec.compress(sample)
+            XCTAssertEqual(LZCodec.decompress(compressed[...], count: sample.count), sample)
+        }
+        XCTAssertNil(LZCodec.decompress([0x10, 0x41, 0x05, 0x00][...], count: 10)) // Offset past the output
+    }
+
+    // MARK: Snapshots
+    // A daily backup after one page changed and a photo was added only writes the delta,
+    // and both snapshots restore byte for byte
+    func testIncrementalBackupWritesOnlyTheDelta() throws {
+        let storeURL = store.appendingPathComponent("Store.sqlite")
+        let original = try Data(contentsOf: storeURL)
+        let repository = try BackupRepository(directory: root.appendingPathComponent("remote"))
+        let full = try repository.backUp(store).stats
+        XCTAssertLessThan(full.bytesWritten, full.bytesRead) // Pages compress; photos are stored as-is
+        let first = try XCTUnwrap(repository.snapshots().first)
+
+        var changed = original
+        changed[changed.count - 4096 + 100] ^= 0xFF
+        try changed.write(to: storeURL)
+        let photo = SyntheticHistory.photoBytes(count: 48 * 1024, seed: 7)
+        try photo.write(to: store.appendingPathComponent(".Store_SUPPORT/_EXTERNAL_DATA/new-photo"))
+        let daily = try repository.backUp(store).stats
+        XCTAssertEqual(daily.newChunks, 2) // The changed page's chunk and the new photo
+        XCTAssertLessThan(daily.bytesWritten, full.bytesWritten / 4)
+
+        let latest = try XCTUnwrap(repository.snapshots().last)
+        XCTAssertEqual(latest.files.count, first.files.count + 1)
+        let restored = root.appendingPathComponent("restored")
+        try repository.restore(latest, to: restored)
+        XCTAssertEqual(try Data(contentsOf: restored.appendingPathComponent("Store.sqlite")), changed)
+        XCTAssertEqual(try Data(contentsOf: restored.appendingPathComponent(".Store_SUPPORT/_EXTERNAL_DATA/new-photo")), photo)
+
+        let older = root.appendingPathComponent("older")
+        try repository.restore(first, to: older)
+        XCTAssertEqual(try Data(contentsOf: older.appendingPathComponent("Store.sqlite")), original)
+
+        XCTAssertEqual(try repository.prune(keeping: 1), 1) // Only the page chunk that changed
+        XCTAssertEqual(try repository.snapshots(), [latest])
+        XCTAssertNoThrow(try repository.verify(latest))
+    }
+
+    // Damaged or missing chunks are caught before a restore writes anything
+    func testCorruptAndMissingChunks() throws {
+        let repository = try BackupRepository(directory: root.appendingPathComponent("remote"))
+        let snapshot = try repository.backUp(store).snapshot
+        XCTAssertNoThrow(try repository.verify(snapshot))
+
+        let digest = snapshot.files[0].chunks[0]
+        let objectURL = root.appendingPathComponent("remote/objects/\(digest.prefix(2))/\(digest)")
+        var object = try Data(contentsOf: objectURL)
+        object[object.count - 1] ^= 0xFF
+        try object.write(to: objectURL)
+        XCTAssertThrowsError(try repository.verify(snapshot)) { error in
+            XCTAssertEqual(error as? BackupError, .corruptObject(digest))
+        }
+        try FileManager.default.removeItem(at: objectURL)
+        XCTAssertThrowsError(try repository.restore(snapshot, to: root.appendingPathComponent("restored"))) { error in
+            XCTAssertEqual(error as? BackupError, .missingObject(digest))
+        }
+    }
+}
@@ -0,0 +1,185 @@
+//
+//  DataRepositoryTests.swift
+//  Calorie counterTests
+//
+
+import XCTest
+import CoreData
+@testable import Calorie_counter
+
+// DataRepository queries against an isolated in-memory store, seeded on the view context
+@MainActor
+final class DataRepositoryTests: XCTestCase {
+    private var persistence: PersistenceController!
+    private var repository: DataRepository!
+    private var calendar: Calendar!
+    private var today: Date!
+
+    override func setUp() async throws {
+        calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(identifier: "America/New_York")!
+        today = calendar.date(from: DateComponents(year: 2024, month: 3, day: 10))!
+        persistence = PersistenceController(inMemory: true)
+        try await persistence.waitForStores()
+        repository = DataRepository(persistence: persistence, clock: AppClock(calendar: calendar, simulatedDay: today))
+    }
+
+    override func tearDown() {
+        repository = nil
+        persistence = nil
+    }
+
+    // MARK: Seeding
+    private var context: NSManagedObjectContext { persistence.container.viewContext }
+
+    private func day(_ offset: Int) -> Date {
+        calendar.date(byAdding: .day, value: offset, to: today)!
+    }
+
+    @discardableResult
+    private func record(_ offset: Int, intake: Double = 1500, goal: Double = 2000, passed: Bool = true, waterGoal: Double = 0, weighIn: Double = 0) -> DailyRecord {
+        let record = DailyRecord(context: context)
+        record.date = day(offset)
+        record.calorieIntake = intake
+        record.calorieGoal = goal
+        record.passFail = passed
+        record.waterGoal = waterGoal
+        record.waterUnit = "fl oz"
+        record.weighIn = weighIn
+        return record
+    }
+
+    @discardableResult
+    private func food(_ name: String, calories: Int32, minutes: Int, on record: DailyRecord) -> CoreDiaryEntry {
+        let entry = CoreDiaryEntry(context: context)
+        entry.id = UUID()
+        entry.type = "Food"
+        entry.entryDescription = name
+        entry.calories = calories
+        entry.timestamp = calendar.date(byAdding: .minute, value: minutes, to: record.date!)
+        entry.dailyRecord = record
+        return entry
+    }
+
+    // MARK: dayRecord
+    func testDayRecordReturnsEntriesAndWeighInsInTimeOrder() async throws {
+        let record = record(0, intake: 650)
+        food("Dinner", calories: 450, minutes: 19 * 60, on: record)
+        food("Breakfast", calories: 200, minutes: 8 * 60, on: record)
+        let weighIn = WeighInEntry(context: context)
+        weighIn.timestamp = calendar.date(byAdding: .hour, value: 7, to: day(0))
+        weighIn.weight = 172.4
+        weighIn.dailyRecord = record
+        try context.save()
+
+        let snapshot = try await repository.dayRecord(for: day(0))
+        XCTAssertEqual(snapshot?.recordID, record.objectID)
+        XCTAssertEqual(snapshot?.summary.calorieIntake, 650)
+        XCTAssertEqual(snapshot?.entries.map(\.description), ["Breakfast", "Dinner"])
+        XCTAssertEqual(snapshot?.weighIns.map(\.weight), [172.4])
+    }
+
+    func testDayRecordPrefersTheDuplicateWithEntries() async throws {
+        record(0, intake: 0)
+        let filled = record(0, intake: 300)
+        food("Lunch", calories: 300, minutes: 12 * 60, on: filled)
+        record(0, intake: 0)
+        try context.save()
+
+        let snapshot = try await repository.dayRecord(for: day(0))
+        XCTAssertEqual(snapshot?.recordID, filled.objectID)
+        XCTAssertEqual(snapshot?.entries.count, 1)
+    }
+
+    func testDayRecordIsNilForADayWithoutARecord() async throws {
+        record(-1)
+        try context.save()
+
+        let snapshot = try await repository.dayRecord(for: day(0))
+        XCTAssertNil(snapshot)
+    }
+
+    func testPreviousDayCarriesTheWaterGoalAndWeighIn() async throws {
+        record(-1, waterGoal: 64, weighIn: 171)
+        try context.save()
+
+        let previous = try await repository.previousDay(before: day(0))
+        XCTAssertEqual(previous?.date, day(-1))
+        XCTAssertEqual(previous?.waterGoal, 64)
+        XCTAssertEqual(previous?.weighIn, 171)
+        let none = try await repository.previousDay(before: day(-1))
+        XCTAssertNil(none)
+    }
+
+    // MARK: daySummaries
+    func testDaySummariesAreOldestFirstWithinTheRange() async throws {
+        for offset in [-1, -5, -3, -4, -2] {
+            record(offset, intake: Double(1000 - offset))
+        }
+        try context.save()
+
+        let all = try await repository.daySummaries()
+        XCTAssertEqual(all.map(\.date), (-5 ... -1).map(day))
+        XCTAssertEqual(all.first?.calorieIntake, 1005)
+
+        let middle = try await repository.daySummaries(from: day(-4), to: day(-2))
+        XCTAssertEqual(middle.map(\.date), [day(-4), day(-3)])
+    }
+
+    // MARK: dayHeader
+    func testDayHeaderCountsThePassStreakBackFromYesterday() async throws {
+        record(-5, passed: true)
+        record(-4, passed: false)
+        record(-3, passed: true)
+        record(-2, passed: true)
+        record(-1, passed: true)
+        record(0, intake: 2200, goal: 1800, passed: false, weighIn: 170)
+        try context.save()
+
+        let header = try await repository.dayHeader(for: day(0), today: day(0))
+        XCTAssertEqual(header.dayNumber, 6)
+        XCTAssertEqual(header.passFail, false)
+        XCTAssertEqual(header.calorieGoal, 1800)
+        XCTAssertEqual(header.weighIn, 170)
+        XCTAssertEqual(header.passStreak, 3) // Today doesn't count, the failed day ends the run
+    }
+
+    func testDayHeaderStreakStopsAtAMissingDay() async throws {
+        record(-4, passed: true)
+        record(-3, passed: true)
+        record(-1, passed: true)
+        try context.save()
+
+        let header = try await repository.dayHeader(for: day(0), today: day(0))
+        XCTAssertNil(header.dayNumber)
+        XCTAssertEqual(header.passStreak, 1)
+    }
+
+    // MARK: profile
+    private func savedProfile(_ name: String, savedOn offset: Int) -> UserProfile {
+        let profile = UserProfile(context: context)
+        profile.name = name
+        profile.gender = "Female"
+        profile.useMetric = false
+        profile.lastSavedDate = day(offset)
+        return profile
+    }
+
+    func testProfileIsTheMostRecentlySavedOne() async throws {
+        _ = savedProfile("Old", savedOn: -30)
+        let newer = savedProfile("Current", savedOn: -1)
+        newer.dailyCalorieGoal = 1850
+        newer.useMetric = true
+        try context.save()
+
+        let profile = try await repository.profile()
+        XCTAssertEqual(profile?.name, "Current")
+        XCTAssertEqual(profile?.dailyCalorieGoal, 1850)
+        XCTAssertEqual(profile?.weightUnit, "kg")
+    }
+
+    func testProfileIsNilWithoutOne() async throws {
+        let profile = try await repository.profile()
+        XCTAssertNil(profile)
+    }
+}
@@ -0,0 +1,92 @@
+//
+//  DiaryCSVTests.swift
+//  Calorie counterTests
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+@testable import CalorieCoreTestSupport
+#else
+@testable import Calorie_counter
+#endif
+
+final class DiaryCSVTests: XCTestCase {
+    private var calendar: Calendar {
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(identifier: "UTC")!
+        return calendar
+    }
+
+    // Quoting, line endings and the header synonyms of the other exporters, fed one byte at a time
+    func testParsing() {
+        let csv = "\u{FEFF}Date,Food Name,\"Energy (kcal)\",Protein (g)\r\n"
+            + "2024-03-01,\"Toast, buttered\",\"1,250\",4.5\r\n"
+            + "\r\n"
+            + "2024-03-02,\"Say \"\"cheese\"\"\",90,\n"
+            + "03/03/2024,\"Two\nlines\",abc,1\n"
+            + "2024-03-04,Apple,52"
+        var rows: [[String]] = []
+        var parser = CSVParser()
+        for byte in Data(csv.utf8) {
+            parser.feed(Data([byte])) { rows.append($0) }
+        }
+        parser.finish { rows.append($0) }
+        XCTAssertEqual(rows.count, 5)
+        XCTAssertEqual(rows[0], ["Date", "Food Name", "Energy (kcal)", "Protein (g)"])
+        XCTAssertEqual(rows[1], ["2024-03-01", "Toast, buttered", "1,250", "4.5"])
+        XCTAssertEqual(rows[2], ["2024-03-02", "Say \"cheese\"", "90", ""])
+        XCTAssertEqual(rows[3][1], "Two\nlines")
+        XCTAssertEqual(CSV.escape("Say \"cheese\""), "\"Say \"\"cheese\"\"\"")
+
+        guard let mapping = DiaryCSVMapping(header: rows[0], calendar: calendar) else {
+            return XCTFail("Cronometer header not recognised")
+        }
+        XCTAssertEqual(mapping.source, .cronometer)
+        XCTAssertEqual(mapping.food(from: rows[1])?.calories, 1250)
+        XCTAssertEqual(mapping.food(from: rows[1])?.protein, 4.5)
+        XCTAssertNil(mapping.food(from: rows[3])) // Calories aren't a number
+        XCTAssertEqual(mapping.food(from: rows[4])?.day, calendar.date(from: DateComponents(year: 2024, month: 3, day: 4)))
+    }
+
+    func testHeaderSynonyms() {
+        let loseIt = DiaryCSVMapping(header: ["Date", "Name", "Type", "Quantity", "Units", "Calories"], calendar: calendar)
+        XCTAssertEqual(loseIt?.source, .loseIt)
+        XCTAssertNil(loseIt?.food(from: ["03/04/2024", "Running", "Exercise", "30", "Minutes", "300"]))
+        XCTAssertEqual(loseIt?.food(from: ["03/04/2024", "Oatmeal", "Breakfast", "1", "Cup", "150"])?.name, "Oatmeal")
+        XCTAssertNil(DiaryCSVMapping(header: ["Date", "Weight"]))
+    }
+
+    // A MyFitnessPal export of a synthetic history maps back to every food, in 64 KB chunks as the importer reads it
+    func testMyFitnessPalExportMapsEveryFood() {
+        let history = SyntheticHistory(SyntheticHistory.Configuration(days: 120))
+        let csv = history.myFitnessPalCSV()
+        var foods: [ImportedFood] = []
+        var mapping: DiaryCSVMapping?
+        func handle(_ row: [String]) {
+            if let mapping = mapping {
+                if let food = mapping.food(from: row) {
+                    foods.append(food)
+                }
+            } else {
+                mapping = DiaryCSVMapping(header: row)
+            }
+        }
+        var parser = CSVParser()
+        var offset = 0
+        while offset < csv.count {
+            let end = min(offset + 65_536, csv.count)
+            parser.feed(csv[offset..<end], row: handle)
+            offset = end
+        }
+        parser.finish(row: handle)
+
+        let expected = history.days.flatMap(\.foods)
+        XCTAssertEqual(mapping?.source, .myFitnessPal)
+        XCTAssertEqual(foods.count, expected.count)
+        XCTAssertEqual(foods.first?.name, expected.first?.name)
+        XCTAssertEqual(foods.last?.calories, expected.last.map { Double($0.calories) })
+        XCTAssertEqual(foods.last?.day, expected.last.map { Calendar.current.startOfDay(for: $0.timestamp) })
+    }
+}
@@ -0,0 +1,99 @@
+//
+//  GIFEncoderTests.swift
+//  Calorie counterTests
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+@testable import CalorieCoreTestSupport
+#else
+@testable import Calorie_counter
+#endif
+
+final class GIFEncoderTests: XCTestCase {
+    private let frames = (0..<4).map { PixelBuffer.gradient(width: 96, height: 64, tint: UInt8($0 * 80)) }
+
+    private func encode(_ frames: [PixelBuffer]) throws -> [Data] {
+        var chunks: [Data] = []
+        var encoder = try GIFEncoder(width: 96, height: 64) { chunks.append($0) }
+        for frame in frames {
+            try encoder.addFrame(frame, delay: 50)
+        }
+        try encoder.finish()
+        return chunks
+    }
+
+    // Header, one chunk per frame, trailer; no frame is held back
+    func testStreamLayout() throws {
+        let chunks = try encode(frames)
+        XCTAssertEqual(chunks.count, frames.count + 2)
+        XCTAssertEqual(chunks.first?.prefix(6), Data("GIF89a".utf8))
+        XCTAssertEqual(chunks.last, Data([0x3B]))
+        XCTAssertLessThan(chunks.dropFirst().map(\.count).max() ?? 0, 96 * 64 * 2)
+    }
+
+    // Every frame's LZW stream decodes back to its palette indices
+    func testFramesRoundTripThroughAReferenceDecoder() throws {
+        let chunks = try encode(frames)
+        for (frame, chunk) in zip(frames, chunks.dropFirst()) {
+            // Graphic control extension and image descriptor are 18 bytes; the LZW stream follows
+            XCTAssertEqual(Self.decodeLZW(chunk.dropFirst(18)), GIFPalette.indices(for: frame))
+        }
+    }
+
+    // Reference decoder, written from the GIF89a spec rather than the encoder
+    private static func decodeLZW(_ data: Data) -> [UInt8] {
+        let bytes = [UInt8](data)
+        let minimumCodeSize = Int(bytes[0])
+        var stream: [UInt8] = []
+        var offset = 1
+        while bytes[offset] != 0 {
+            let length = Int(bytes[offset])
+            stream += bytes[(offset + 1)...(offset + length)]
+            offset += length + 1
+        }
+
+        let clearCode = 1 << minimumCodeSize
+        let endCode = clearCode + 1
+        var bitPosition = 0
+        func read(_ width: Int) -> Int {
+            var value = 0
+            for bit in 0..<width {
+                let position = bitPosition + bit
+                value |= Int((stream[position >> 3] >> (position & 7)) & 1) << bit
+            }
+            bitPosition += width
+            return value
+        }
+
+        var table: [[UInt8]] = []
+        var codeSize = minimumCodeSize + 1
+        var previous: [UInt8]?
+        var output: [UInt8] = []
+        while true {
+            let code = read(codeSize)
+            if code == clearCode {
+                table = (0..<clearCode).map { [UInt8($0)] } + [[], []]
+                codeSize = minimumCodeSize + 1
+                previous = nil
+                continue
+            }
+            if code == endCode { break }
+            guard let last = previous else {
+                output += table[code]
+                previous = table[code]
+                continue
+            }
+            let entry = code < table.count ? table[code] : last + [last[0]]
+            table.append(last + [entry[0]])
+            output += entry
+            previous = entry
+            if table.count == 1 << codeSize && codeSize < 12 {
+                codeSize += 1
+            }
+        }
+        return output
+    }
+}
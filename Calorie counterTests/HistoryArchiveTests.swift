@@ -0,0 +1,75 @@
+//
+//  HistoryArchiveTests.swift
+//  Calorie counterTests
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+@testable import CalorieCoreTestSupport
+#else
+@testable import Calorie_counter
+#endif
+
+final class HistoryArchiveTests: XCTestCase {
+    private var directory: URL!
+    private var days: [ArchivedDay]!
+
+    override func setUpWithError() throws {
+        directory = FileManager.default.temporaryDirectory.appendingPathComponent("HistoryArchive-\(UUID().uuidString)")
+        days = SyntheticHistory(SyntheticHistory.Configuration(days: 365)).days.map(\.archived)
+    }
+
+    override func tearDownWithError() throws {
+        try? FileManager.default.removeItem(at: directory)
+    }
+
+    // Rollover-sized appends read back through the columns, a single day and a date range
+    func testAppendedDaysReadBack() throws {
+        var archive = try HistoryArchive.open(at: directory)
+        for start in stride(from: 0, to: days.count, by: 180) {
+            archive = try archive.appending(Array(days[start..<min(start + 180, days.count)]))
+        }
+        XCTAssertEqual(archive.dayCount, days.count)
+
+        let reopened = try HistoryArchive.open(at: directory)
+        let averageIntake = reopened.withValues(.calorieIntake) { $0.reduce(0, +) / Double(max($0.count, 1)) }
+        let passedDays = reopened.withFlags(.passed) { $0.reduce(0) { $0 + Int($1) } }
+        XCTAssertEqual(averageIntake, days.reduce(0) { $0 + $1.calorieIntake } / Double(days.count), accuracy: 1e-6)
+        XCTAssertEqual(passedDays, days.filter(\.passed).count)
+        XCTAssertEqual(try reopened.day(at: days.count / 2), days[days.count / 2])
+        XCTAssertEqual(reopened.indices(from: days[10].date, to: days[20].date), 10..<20)
+    }
+
+    func testAppendRejectsDaysNotNewerThanTheLast() throws {
+        let archive = try HistoryArchive.open(at: directory).appending(Array(days.prefix(10)))
+        XCTAssertThrowsError(try archive.appending([days[0]]))
+        XCTAssertThrowsError(try archive.appending([days[9]]))
+        XCTAssertEqual(try HistoryArchive.open(at: directory).dayCount, 10)
+    }
+
+    // A flipped byte in a column, or days written past the manifest, are caught on open
+    func testIntegrity() throws {
+        let archive = try HistoryArchive.open(at: directory).appending(Array(days.prefix(100)))
+        let intakeURL = directory.appendingPathComponent(HistoryColumn.calorieIntake.fileName)
+
+        // An interrupted append: bytes past the committed length are ignored, then overwritten
+        let handle = try FileHandle(forWritingTo: intakeURL)
+        try handle.seekToEnd()
+        try handle.write(contentsOf: Data(repeating: 0xAB, count: 64))
+        try handle.close()
+        XCTAssertEqual(try HistoryArchive.open(at: directory).dayCount, 100)
+        let extended = try archive.appending(Array(days[100..<120]))
+        XCTAssertEqual(try HistoryArchive.open(at: directory).value(.calorieIntake, at: 110), days[110].calorieIntake)
+        XCTAssertEqual(extended.dayCount, 120)
+
+        var corrupted = try Data(contentsOf: intakeURL)
+        corrupted[8] ^= 0xFF
+        try corrupted.write(to: intakeURL)
+        XCTAssertThrowsError(try HistoryArchive.open(at: directory)) { error in
+            XCTAssertEqual(error as? HistoryArchiveError, .checksumMismatch(HistoryColumn.calorieIntake.rawValue))
+        }
+        XCTAssertNoThrow(try HistoryArchive.open(at: directory, verify: false))
+    }
+}
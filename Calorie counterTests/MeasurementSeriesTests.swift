@@ -0,0 +1,82 @@
+//
+//  MeasurementSeriesTests.swift
+//  Calorie counterTests
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+#else
+@testable import Calorie_counter
+#endif
+
+final class MeasurementSeriesTests: XCTestCase {
+    private let start = Date(timeIntervalSinceReferenceDate: 700_000_000)
+
+    private func day(_ offset: Int) -> Date {
+        start.addingTimeInterval(Double(offset) * 86_400)
+    }
+
+    // Chest, waist, hips, then four limbs at a fixed 30 cm
+    private func sample(_ offset: Int, waist: Double, hips: Double, chest: Double = 100) -> (date: Date, centimeters: [Double]) {
+        (date: day(offset), centimeters: [chest, waist, hips, 30, 30, 30, 30])
+    }
+
+    // Waist loses exactly 0.1 cm a day, so the least-squares line is exact
+    func testSlopeAndWeeklyRate() {
+        let series = MeasurementSeries((0..<10).map { sample($0 * 7, waist: 90 - Double($0 * 7) * 0.1, hips: 100) })
+        let waist = series.stats(.waist)
+        XCTAssertEqual(waist.count, 10)
+        XCTAssertEqual(try XCTUnwrap(waist.slopePerDay), -0.1, accuracy: 1e-9)
+        XCTAssertEqual(try XCTUnwrap(waist.ratePerWeek), -0.7, accuracy: 1e-9)
+        XCTAssertEqual(try XCTUnwrap(waist.change), -6.3, accuracy: 1e-9)
+        XCTAssertEqual(waist.minimum, 83.7, accuracy: 1e-9)
+        XCTAssertEqual(waist.maximum, 90)
+        XCTAssertEqual(try XCTUnwrap(series.stats(.chest).slopePerDay), 0, accuracy: 1e-12)
+    }
+
+    // A scattered series gets the textbook least-squares fit, not the first-to-latest change
+    func testSlopeFitsEverySample() {
+        let series = MeasurementSeries([sample(0, waist: 90, hips: 100), sample(1, waist: 88, hips: 100),
+                                        sample(2, waist: 89, hips: 100), sample(3, waist: 87, hips: 100)])
+        // x̄ = 1.5, ȳ = 88.5, Σ(x-x̄)(y-ȳ) = -4.0, Σ(x-x̄)² = 5
+        XCTAssertEqual(try XCTUnwrap(series.stats(.waist).slopePerDay), -0.8, accuracy: 1e-9)
+        XCTAssertEqual(try XCTUnwrap(series.stats(.waist).change), -3, accuracy: 1e-9)
+    }
+
+    func testRateNeedsTwoDistinctDays() {
+        var series = MeasurementSeries()
+        series.append(date: day(0), centimeters: sample(0, waist: 90, hips: 100).centimeters)
+        XCTAssertNil(series.stats(.waist).ratePerWeek)
+        XCTAssertNil(series.stats(.waist).change)
+        series.append(date: day(0), centimeters: sample(0, waist: 89, hips: 100).centimeters)
+        XCTAssertNil(series.stats(.waist).ratePerWeek) // Both samples at the same instant
+        series.append(date: day(7), centimeters: sample(7, waist: 88, hips: 100).centimeters)
+        XCTAssertNotNil(series.stats(.waist).ratePerWeek)
+    }
+
+    // Ratios only for samples with both metrics; 0 means not measured and is skipped by the stats
+    func testWaistToHip() {
+        let series = MeasurementSeries([sample(0, waist: 90, hips: 100), sample(7, waist: 0, hips: 100),
+                                        sample(14, waist: 85, hips: 100)])
+        XCTAssertEqual(series.waistToHip.count, 3)
+        XCTAssertEqual(series.waistToHip[0], 0.9, accuracy: 1e-12)
+        XCTAssertTrue(series.waistToHip[1].isNaN)
+        XCTAssertEqual(series.waistToHip[2], 0.85, accuracy: 1e-12)
+        XCTAssertEqual(series.waistToHipStats.count, 2)
+        XCTAssertEqual(try XCTUnwrap(series.waistToHipStats.ratePerWeek), -0.05 / 2, accuracy: 1e-12)
+        XCTAssertEqual(series.stats(.waist).count, 2)
+        XCTAssertTrue(series.values(.waist)[1].isNaN)
+    }
+
+    // An older sample appended late lands in date order with the stats rebuilt
+    func testOutOfOrderAppendRebuilds() {
+        var series = MeasurementSeries([sample(0, waist: 90, hips: 100), sample(14, waist: 86, hips: 100)])
+        series.append(date: day(7), centimeters: sample(7, waist: 88, hips: 100).centimeters)
+        XCTAssertEqual(series.dates, [day(0), day(7), day(14)])
+        XCTAssertEqual(series.values(.waist), [90, 88, 86])
+        XCTAssertEqual(try XCTUnwrap(series.stats(.waist).ratePerWeek), -2, accuracy: 1e-9)
+        XCTAssertFalse(series.latestIsBlank)
+    }
+}
@@ -0,0 +1,49 @@
+//
+//  ShareCardTests.swift
+//  Calorie counterTests
+//
+
+import Foundation
+import XCTest
+#if canImport(CalorieCore)
+@testable import CalorieCore
+@testable import CalorieCoreTestSupport
+#else
+@testable import Calorie_counter
+#endif
+
+// The pixel layer of a 2x share card from two display-sized photos
+final class ShareCardTests: XCTestCase {
+    private let background = PixelColor(red: 240, green: 240, blue: 240, alpha: 255)
+    private let layout = ShareCard.Layout(scale: 2, titleOverlayWidth: 250)
+
+    private func compositeCard() -> PixelBuffer {
+        let start = PixelBuffer.gradient(width: 960, height: 1280, tint: 0)
+        let latest = PixelBuffer.gradient(width: 1280, height: 960, tint: 255)
+        return ShareCard.composite(start: start, latest: latest, background: background, layout: layout)
+    }
+
+    func testLayersLandInTheirRects() {
+        let card = compositeCard()
+        XCTAssertEqual(card.width, 1200)
+        XCTAssertEqual(card.height, 1200)
+        XCTAssertEqual(card[0, 0], background)
+        XCTAssertEqual(card[0, card.height - 1], background) // Caption area is left to the text layer
+        let overlay = layout.titleOverlay
+        XCTAssertLessThan(card[overlay.x + 1, overlay.y + 1].red, background.red)
+        XCTAssertEqual(card[overlay.x - 1, overlay.y + 1], background)
+        XCTAssertEqual(card[layout.startImage.x + 10, layout.startImage.y + 10].blue, 0)
+        XCTAssertEqual(card[layout.latestImage.x + 10, layout.latestImage.y + 10].blue, 255)
+    }
+
+    // Both photos are centre-cropped to squares: the portrait one loses rows, the landscape one columns
+    func testPhotosAreCentreCropped() {
+        let card = compositeCard()
+        let start = layout.startImage
+        let latest = layout.latestImage
+        XCTAssertLessThan(card[start.x, start.y + start.height / 2].red, 5)
+        XCTAssertGreaterThan(card[start.x + start.width / 2, start.y].green, 20)
+        XCTAssertGreaterThan(card[latest.x, latest.y + latest.height / 2].red, 20)
+        XCTAssertLessThan(card[latest.x + latest.width / 2, latest.y].green, 5)
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  TimeTravelEngineTests.swift
+//  Calorie counterTests
+//
+
+import XCTest
+import CoreData
+@testable import Calorie_counter
+
+// Day rollovers over a known profile: 5'6" woman, 170 lbs, born 1990-06-15, losing 1 lb a week at
+// lightly active. Her BMR is 2114 at 33 and 2108 at 34, so the goal is BMR - 500 per pound a week.
+@MainActor
+final class TimeTravelEngineTests: XCTestCase {
+    private var persistence: PersistenceController!
+    private var calendar: Calendar!
+
+    override func setUp() async throws {
+        calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(identifier: "America/New_York")!
+        persistence = PersistenceController(inMemory: true)
+        try await persistence.waitForStores()
+
+        let userProfile = UserProfile(context: persistence.container.viewContext)
+        userProfile.name = "Test"
+        userProfile.gender = "Woman"
+        userProfile.birthdate = date(1990, 6, 15)
+        userProfile.age = 33
+        userProfile.heightFt = 5
+        userProfile.heightIn = 6
+        userProfile.currentWeight = 170
+        userProfile.startWeight = 170
+        userProfile.goalWeight = 150
+        userProfile.weekGoal = -1
+        userProfile.goalId = 1
+        userProfile.activityInt = 1
+        userProfile.useMetric = false
+        try persistence.container.viewContext.save()
+    }
+
+    override func tearDown() {
+        persistence = nil
+    }
+
+    private func date(_ year: Int, _ month: Int, _ day: Int) -> Date {
+        calendar.date(from: DateComponents(year: year, month: month, day: day))!
+    }
+
+    private func engine(startingOn day: Date) -> (TimeTravelEngine, AppClock) {
+        let clock = AppClock(calendar: calendar, simulatedDay: day)
+        return (TimeTravelEngine(persistence: persistence, clock: clock), clock)
+    }
+
+    // Logs one food per day: 1200 kcal, or 5000 on the `failing` days so they go over any goal
+    private func diary(from start: Date, failing: Set<Int> = []) -> TimeTravelEngine.DayLog {
+        let calendar = self.calendar!
+        return { day, record, _, context in
+            let offset = calendar.dateComponents([.day], from: start, to: day).day ?? 0
+            let entry = CoreDiaryEntry(context: context)
+            entry.id = UUID()
+            entry.type = "Food"
+            entry.entryDescription = "Dinner"
+            entry.calories = failing.contains(offset) ? 5000 : 1200
+            entry.timestamp = calendar.date(byAdding: .hour, value: 18, to: day)
+            entry.dailyRecord = record
+            record.calorieIntake = Double(entry.calories)
+        }
+    }
+
+    private func calorieGoal(on day: Date) throws -> Double? {
+        let fetchRequest: NSFetchRequest<DailyRecord> = DailyRecord.fetchRequest()
+        fetchRequest.predicate = NSPredicate(format: "date == %@", day as NSDate)
+        return try persistence.container.viewContext.fetch(fetchRequest).first?.calorieGoal
+    }
+
+    // MARK: Birthday
+    func testBirthdayBumpsAgeAndLowersTheGoal() async throws {
+        let start = date(2024, 6, 10)
+        let (engine, clock) = engine(startingOn: start)
+
+        let before = try await engine.advance(days: 4, log: diary(from: start))
+        XCTAssertEqual(before.today, date(2024, 6, 14))
+        XCTAssertEqual(before.age, 33)
+        XCTAssertEqual(before.dailyCalorieGoal, 1614)
+
+        let after = try await engine.advance(days: 2, log: diary(from: start))
+        XCTAssertEqual(after.today, date(2024, 6, 16))
+        XCTAssertEqual(clock.today, date(2024, 6, 16))
+        XCTAssertEqual(after.age, 34)
+        XCTAssertEqual(after.dailyCalorieGoal, 1608)
+        XCTAssertEqual(try calorieGoal(on: date(2024, 6, 14)), 1614)
+        XCTAssertEqual(try calorieGoal(on: date(2024, 6, 15)), 1608) // Opened on the birthday
+        XCTAssertEqual(after.passStreak, 6) // Continues across both runs
+        XCTAssertEqual(after.highStreak, 6)
+    }
+
+    // MARK: Goal Change
+    // A new weekly goal reaches the profile's goal when the next day opens; the day already open keeps its locked goal
+    func testGoalChangeAppliesFromTheNextOpenedDay() async throws {
+        let start = date(2024, 3, 1)
+        let (engine, _) = engine(startingOn: start)
+        let first = try await engine.advance(days: 3, log: diary(from: start))
+        XCTAssertEqual(first.dailyCalorieGoal, 1614)
+
+        let context = persistence.container.newBackgroundContext()
+        try await context.perform {
+            let fetchRequest: NSFetchRequest<UserProfile> = UserProfile.fetchRequest()
+            let userProfile = try XCTUnwrap(context.fetch(fetchRequest).first)
+            userProfile.weekGoal = -2
+            try context.save()
+        }
+
+        let second = try await engine.advance(days: 2, log: diary(from: start))
+        XCTAssertEqual(second.dailyCalorieGoal, 1114)
+        XCTAssertEqual(second.age, 33)
+        XCTAssertEqual(try calorieGoal(on: date(2024, 3, 4)), 1614)
+        XCTAssertEqual(try calorieGoal(on: date(2024, 3, 5)), 1114)
+        XCTAssertEqual(try calorieGoal(on: date(2024, 3, 6)), 1114)
+        XCTAssertEqual(second.passStreak, 5)
+    }
+
+    // MARK: Failed Day
+    func testFailedDayResetsTheStreakAndKeepsTheHigh() async throws {
+        let start = date(2024, 3, 1)
+        let (engine, _) = engine(startingOn: start)
+        let report = try await engine.advance(days: 8, log: diary(from: start, failing: [5]))
+        XCTAssertEqual(report.days, 8)
+        XCTAssertEqual(report.passedDays, 7)
+        XCTAssertEqual(report.passStreak, 2) // Days 6 and 7
+        XCTAssertEqual(report.highStreak, 5) // Days 0 to 4
+        XCTAssertEqual(report.dailyCalorieGoal, 1614)
+    }
+
+    // An empty day nobody opened fails even though it is under its goal. The day the first run arrived on
+    // was opened then, so it still passes empty.
+    func testUnopenedEmptyDayFails() async throws {
+        let start = date(2024, 3, 1)
+        let (engine, _) = engine(startingOn: start)
+        _ = try await engine.advance(days: 3, log: diary(from: start))
+        let report = try await engine.advance(days: 2)
+        XCTAssertEqual(report.passedDays, 1)
+        XCTAssertEqual(report.passStreak, 0)
+        XCTAssertEqual(report.highStreak, 4)
+    }
+}
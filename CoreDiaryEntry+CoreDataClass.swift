@@ -12,4 +12,11 @@ import CoreData
 @objc(CoreDiaryEntry)
 public class CoreDiaryEntry: NSManagedObject {
 
+    // Every row gets an identity up front; callers mirroring a DiaryEntry overwrite it with that entry's id
+    public override func awakeFromInsert() {
+        super.awakeFromInsert()
+        if id == nil {
+            id = UUID()
+        }
+    }
 }
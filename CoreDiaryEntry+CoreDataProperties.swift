@@ -16,7 +16,9 @@ extension CoreDiaryEntry {
         return NSFetchRequest<CoreDiaryEntry>(entityName: "CoreDiaryEntry")
     }
 
-    @NSManaged public var time: String?
+    @NSManaged public var id: UUID? // Stable identity shared with DiaryEntry.id
+    @NSManaged public var time: String? // Legacy display string, superseded by timestamp
+    @NSManaged public var timestamp: Date?
     @NSManaged public var iconName: String?
     @NSManaged public var entryDescription: String?
     @NSManaged public var detail: String?
@@ -27,6 +29,7 @@ extension CoreDiaryEntry {
     @NSManaged public var fats: Double
     @NSManaged public var carbs: Double
     @NSManaged public var protein: Double
+    @NSManaged public var waterAmountMl: Double
     @NSManaged public var dailyRecord: DailyRecord?
 
 }
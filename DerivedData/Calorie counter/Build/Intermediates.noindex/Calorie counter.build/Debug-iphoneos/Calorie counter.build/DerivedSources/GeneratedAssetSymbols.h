@@ -78,8 +78,8 @@ static NSString * const ACImageNameBaseball AC_SWIFT_PRIVATE = @"Baseball";
 /// The "Basketball" asset catalog image resource.
 static NSString * const ACImageNameBasketball AC_SWIFT_PRIVATE = @"Basketball";
 
-/// The "Bikeing" asset catalog image resource.
-static NSString * const ACImageNameBikeing AC_SWIFT_PRIVATE = @"Bikeing";
+/// The "Biking" asset catalog image resource.
+static NSString * const ACImageNameBiking AC_SWIFT_PRIVATE = @"Biking";
 
 /// The "Boxing" asset catalog image resource.
 static NSString * const ACImageNameBoxing AC_SWIFT_PRIVATE = @"Boxing";
@@ -207,8 +207,8 @@ static NSString * const ACImageNameSnowboarding AC_SWIFT_PRIVATE = @"Snowboardin
 /// The "Soccer" asset catalog image resource.
 static NSString * const ACImageNameSoccer AC_SWIFT_PRIVATE = @"Soccer";
 
-/// The "Spining" asset catalog image resource.
-static NSString * const ACImageNameSpining AC_SWIFT_PRIVATE = @"Spining";
+/// The "Spinning" asset catalog image resource.
+static NSString * const ACImageNameSpinning AC_SWIFT_PRIVATE = @"Spinning";
 
 /// The "Sprinting" asset catalog image resource.
 static NSString * const ACImageNameSprinting AC_SWIFT_PRIVATE = @"Sprinting";
@@ -216,8 +216,8 @@ static NSString * const ACImageNameSprinting AC_SWIFT_PRIVATE = @"Sprinting";
 /// The "Stretch" asset catalog image resource.
 static NSString * const ACImageNameStretch AC_SWIFT_PRIVATE = @"Stretch";
 
-/// The "Swiming" asset catalog image resource.
-static NSString * const ACImageNameSwiming AC_SWIFT_PRIVATE = @"Swiming";
+/// The "Swimming" asset catalog image resource.
+static NSString * const ACImageNameSwimming AC_SWIFT_PRIVATE = @"Swimming";
 
 /// The "Teach" asset catalog image resource.
 static NSString * const ACImageNameTeach AC_SWIFT_PRIVATE = @"Teach";
@@ -0,0 +1,54 @@
+// swift-tools-version:5.7
+//
+// Headless build of the Foundation-only pieces of the app, so their unit tests and the pure-logic
+// benchmarks run on Linux CI. The iOS app and its Core Data tests and benchmarks build from
+// "Calorie counter.xcodeproj".
+//
+//   swift test --filter CalorieCoreTests
+//   swift test -c release -Xswiftc -enable-testing --filter PureLogicBenchmarks
+//
+
+import PackageDescription
+
+let package = Package(
+    name: "CalorieCounter",
+    targets: [
+        .target(
+            name: "CalorieCore",
+            path: "Calorie counter",
+            sources: [
+                "BuiltInActivityCatalog.swift",
+                "AssetRegistry.swift",
+                "WaterUnit.swift",
+                "StreakCalculator.swift",
+                "FoodSearch.swift",
+                "SyntheticHistory.swift",
+                "ShareCardCompositor.swift",
+                "GIFEncoder.swift",
+                "MeasurementSeries.swift",
+                "HistoryArchive.swift",
+                "DiaryCSV.swift",
+                "BackupRepository.swift"
+            ]
+        ),
+        // Fixtures shared by both test targets. It @testable imports CalorieCore, which debug builds and
+        // the -enable-testing release run above both allow
+        .target(
+            name: "CalorieCoreTestSupport",
+            dependencies: ["CalorieCore"],
+            path: "Calorie counterTestSupport"
+        ),
+        .testTarget(
+            name: "CalorieCoreTests",
+            dependencies: ["CalorieCore", "CalorieCoreTestSupport"],
+            path: "Calorie counterTests",
+            exclude: ["Calorie_counterTests.swift", "DataRepositoryTests.swift", "TimeTravelEngineTests.swift"]
+        ),
+        .testTarget(
+            name: "CalorieCoreBenchmarks",
+            dependencies: ["CalorieCore", "CalorieCoreTestSupport"],
+            path: "Calorie counterBenchmarks",
+            exclude: ["StoreBenchmarks.swift", "Baselines.json"]
+        )
+    ]
+)
@@ -17,6 +17,11 @@ extension ProgressPicture {
     }
 
     @NSManaged public var imageData: Data?
+    @NSManaged public var displayData: Data?
+    @NSManaged public var thumbnailData: Data?
+    @NSManaged public var pixelWidth: Int32
+    @NSManaged public var pixelHeight: Int32
+    @NSManaged public var byteCount: Int64
     @NSManaged public var date: Date?
     @NSManaged public var weight: Double
     @NSManaged public var userProfile: UserProfile?
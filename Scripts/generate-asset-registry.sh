@@ -0,0 +1,84 @@
+#!/bin/sh
+#
+# Generates "Calorie counter/AssetRegistry.swift" from the GeneratedAssetSymbols.h that Xcode emits
+# for Assets.xcassets. Rerun after adding, removing or renaming an image set:
+#
+#   Scripts/generate-asset-registry.sh [GeneratedAssetSymbols.h] [AssetRegistry.swift]
+#
+# Without arguments it reads the header from the Debug build in DerivedData and rewrites the
+# checked-in registry. The "Check Asset Registry" build phase generates into DERIVED_FILE_DIR and
+# fails the build when the checked-in copy is out of date.
+#
+
+set -e
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+SYMBOLS=${1:-"$ROOT/DerivedData/Calorie counter/Build/Intermediates.noindex/Calorie counter.build/Debug-iphoneos/Calorie counter.build/DerivedSources/GeneratedAssetSymbols.h"}
+OUTPUT=${2:-"$ROOT/Calorie counter/AssetRegistry.swift"}
+
+if [ ! -f "$SYMBOLS" ]; then
+    echo "error: $SYMBOLS not found; build the app once so Xcode generates it" >&2
+    exit 1
+fi
+
+# "static NSString * const ACImageNameEmptyManPP AC_SWIFT_PRIVATE = @"Empty man PP";" -> "EmptyManPP Empty man PP"
+LC_ALL=C sed -n 's/^static NSString \* const ACImageName_*\([A-Za-z0-9_]*\) AC_SWIFT_PRIVATE = @"\(.*\)";$/\1 \2/p' "$SYMBOLS" |
+LC_ALL=C awk '
+    # Xcode symbol to a Swift case: drop underscores, lowercase the leading capitals but keep the
+    # one that starts the next word (ABS -> abs, AL_0 -> al0, BMChest -> bmChest, CalW -> calW)
+    function caseName(symbol,    count, length_) {
+        gsub(/_/, "", symbol)
+        length_ = length(symbol)
+        count = 0
+        while (count < length_ && substr(symbol, count + 1, 1) ~ /[A-Z]/) count++
+        if (count > 1 && count < length_ && substr(symbol, count + 1, 1) ~ /[a-z]/) count--
+        return tolower(substr(symbol, 1, count)) substr(symbol, count + 1)
+    }
+    BEGIN { count = 0 }
+    {
+        symbol = $1
+        name = substr($0, length($1) + 2)
+        gsub(/\\/, "\\\\", name)
+        gsub(/"/, "\\\"", name)
+        identifier = caseName(symbol)
+        if (identifier in seen) {
+            printf "error: image sets \"%s\" and \"%s\" both map to case %s\n", seen[identifier], name, identifier > "/dev/stderr"
+            failed = 1
+        }
+        seen[identifier] = name
+        cases[count] = identifier
+        names[count] = name
+        count++
+    }
+    END {
+        if (failed) exit 1
+        if (count == 0) {
+            print "error: no image symbols found" > "/dev/stderr"
+            exit 1
+        }
+        print "//"
+        print "//  AssetRegistry.swift"
+        print "//  Calorie counter"
+        print "//"
+        print "//  Generated by Scripts/generate-asset-registry.sh from GeneratedAssetSymbols.h. Do not edit;"
+        print "//  change the image sets in Assets.xcassets and rerun the script."
+        print "//"
+        print ""
+        print "import Foundation"
+        print ""
+        print "// MARK: - App Asset"
+        print "// One case per image set in Assets.xcassets. The raw value indexes `names`, so resolving a case"
+        print "// is an array read, and a misspelled case is a compile error instead of a missing image."
+        print "enum AppAsset: Int, CaseIterable {"
+        for (i = 0; i < count; i++) printf "    case %s\n", cases[i]
+        print "}"
+        print ""
+        print "extension AppAsset {"
+        print "    static let names: [String] = ["
+        for (i = 0; i < count; i++) printf "        \"%s\"%s\n", names[i], (i < count - 1 ? "," : "")
+        print "    ]"
+        print ""
+        print "    var name: String { Self.names[rawValue] }"
+        print "}"
+    }
+' > "$OUTPUT.tmp"
+mv "$OUTPUT.tmp" "$OUTPUT"
@@ -40,6 +40,8 @@ extension UserProfile {
     @NSManaged public var profilePicture: Data?
     @NSManaged public var startDate: Date?
     @NSManaged public var startPicture: Data?
+    @NSManaged public var startPictureDisplay: Data?
+    @NSManaged public var startPictureThumbnail: Data?
     @NSManaged public var startWeight: Double
     @NSManaged public var targetDate: Date?
     @NSManaged public var tempDayNumber: Int32
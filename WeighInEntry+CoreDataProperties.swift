@@ -16,7 +16,8 @@ extension WeighInEntry {
         return NSFetchRequest<WeighInEntry>(entityName: "WeighInEntry")
     }
 
-    @NSManaged public var time: String?
+    @NSManaged public var time: String? // Legacy display string, superseded by timestamp
+    @NSManaged public var timestamp: Date?
     @NSManaged public var weight: Double
     @NSManaged public var dailyRecord: DailyRecord?
 
@@ -19,7 +19,8 @@ extension WorkoutEntry {
     @NSManaged public var name: String?
     @NSManaged public var duration: Double
     @NSManaged public var caloriesBurned: Double
-    @NSManaged public var time: String?
+    @NSManaged public var time: String? // Legacy display string, superseded by timestamp
+    @NSManaged public var timestamp: Date?
     @NSManaged public var imageName: String?
     @NSManaged public var imageData: Data?
     @NSManaged public var dailyRecord: DailyRecord?